@@ -26,6 +26,7 @@
 #include "SpatialGDKSettings.h"
 #include "Utils/RepLayoutUtils.h"
 #include "Utils/SpatialActorUtils.h"
+#include "Utils/SpatialTraceRecorder.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialActorChannel);
 
@@ -77,6 +78,7 @@ USpatialActorChannel::USpatialActorChannel(const FObjectInitializer& ObjectIniti
 	: Super(ObjectInitializer)
 	, bCreatedEntity(false)
 	, bCreatingNewEntity(false)
+	, bKeepActorOnCleanUp(false)
 	, EntityId(SpatialConstants::INVALID_ENTITY_ID)
 	, bInterestDirty(false)
 	, bNetOwned(false)
@@ -169,6 +171,12 @@ bool USpatialActorChannel::CleanUp(const bool bForDestroy, EChannelCloseReason C
 	// Must cleanup actor and subobjects before UActorChannel::Cleanup as it will clear CreateSubObjects
 	Receiver->CleanupDeletedEntity(EntityId);
 
+	if (bKeepActorOnCleanUp && Actor != nullptr)
+	{
+		Connection->ActorChannelMap().Remove(Actor);
+		Actor = nullptr;
+	}
+
 #if ENGINE_MINOR_VERSION <= 20
 	return UActorChannel::CleanUp(bForDestroy);
 #else
@@ -290,6 +298,7 @@ FHandoverChangeState USpatialActorChannel::CreateInitialHandoverChangeState(cons
 int64 USpatialActorChannel::ReplicateActor()
 {
 	SCOPE_CYCLE_COUNTER(STAT_SpatialActorChannelReplicateActor);
+	SPATIAL_TRACE_SCOPE_DETAIL(TEXT("ReplicateActor"), TEXT("Replication"), GetNameSafe(Actor));
 
 	if (!IsReadyForReplication())
 	{
@@ -20,23 +20,25 @@ void FSpatialNetBitReader::DeserializeObjectRef(FUnrealObjectRef& ObjectRef)
 	ObjectRef.Entity = EntityId;
 	*this << ObjectRef.Offset;
 
+	TOptional<FString> Path;
 	uint8 HasPath;
 	SerializeBits(&HasPath, 1);
 	if (HasPath)
 	{
-		FString Path;
-		*this << Path;
-
-		ObjectRef.Path = Path;
+		Path.Emplace();
+		*this << Path.GetValue();
 	}
 
+	TOptional<FUnrealObjectRef> Outer;
 	uint8 HasOuter;
 	SerializeBits(&HasOuter, 1);
 	if (HasOuter)
 	{
-		ObjectRef.Outer = FUnrealObjectRef();
-		DeserializeObjectRef(*ObjectRef.Outer);
+		Outer.Emplace();
+		DeserializeObjectRef(Outer.GetValue());
 	}
+
+	ObjectRef.SetPathAndOuter(Path.GetPtrOrNull(), Outer.GetPtrOrNull());
 }
 
 FArchive& FSpatialNetBitReader::operator<<(UObject*& Value)
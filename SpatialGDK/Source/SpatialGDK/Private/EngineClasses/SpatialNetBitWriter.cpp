@@ -23,18 +23,20 @@ void FSpatialNetBitWriter::SerializeObjectRef(FUnrealObjectRef& ObjectRef)
 	*this << EntityId;
 	*this << ObjectRef.Offset;
 
-	uint8 HasPath = ObjectRef.Path.IsSet();
+	uint8 HasPath = ObjectRef.HasPath();
 	SerializeBits(&HasPath, 1);
 	if (HasPath)
 	{
-		*this << ObjectRef.Path.GetValue();
+		FString Path = ObjectRef.GetPath();
+		*this << Path;
 	}
 
-	uint8 HasOuter = ObjectRef.Outer.IsSet();
+	uint8 HasOuter = ObjectRef.HasOuter();
 	SerializeBits(&HasOuter, 1);
 	if (HasOuter)
 	{
-		SerializeObjectRef(*ObjectRef.Outer);
+		FUnrealObjectRef Outer = ObjectRef.GetOuter();
+		SerializeObjectRef(Outer);
 	}
 }
 
@@ -34,8 +34,11 @@
 #include "Utils/EntityPool.h"
 #include "Utils/InterestFactory.h"
 #include "Utils/OpUtils.h"
+#include "Utils/SpatialActorPool.h"
+#include "Utils/SpatialBenchmarks.h"
 #include "Utils/SpatialMetrics.h"
 #include "Utils/SpatialMetricsDisplay.h"
+#include "Utils/SpatialTraceRecorder.h"
 
 #if WITH_EDITOR
 #include "SpatialGDKServicesModule.h"
@@ -48,6 +51,8 @@ DEFINE_STAT(STAT_SpatialConsiderList);
 
 USpatialNetDriver::USpatialNetDriver(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, NextPendingOpIndex(0)
+	, NumOpBacklogFrames(0)
 	, bAuthoritativeDestruction(true)
 	, bConnectAsClient(false)
 	, bPersistSpatialConnection(true)
@@ -315,6 +320,12 @@ void USpatialNetDriver::CreateAndInitializeCoreClasses()
 	{
 		EntityPool->Init(this, &TimerManager);
 	}
+	// Actors are only pooled on clients, where they are never authoritative.
+	else if (GetDefault<USpatialGDKSettings>()->ClientActorPoolSizes.Num() > 0)
+	{
+		ActorPool = NewObject<USpatialActorPool>();
+		ActorPool->Init(this);
+	}
 }
 
 void USpatialNetDriver::CreateServerSpatialOSNetConnection()
@@ -562,6 +573,9 @@ void USpatialNetDriver::BeginDestroy()
 {
 	Super::BeginDestroy();
 
+	// Normally already done in Shutdown.
+	DestroyPendingOpLists();
+
 	// If we are still connected, cleanup our corresponding worker entity if it exists.
 	if (Connection != nullptr && WorkerEntityId != SpatialConstants::INVALID_ENTITY_ID)
 	{
@@ -650,6 +664,10 @@ void USpatialNetDriver::Shutdown()
 		}
 	}
 
+	// The connection can outlive the net driver, for example across server travel, so the op lists it handed out
+	// have to be returned to it.
+	DestroyPendingOpLists();
+
 	Super::Shutdown();
 }
 
@@ -1078,8 +1096,7 @@ void USpatialNetDriver::ProcessRPC(AActor* Actor, UObject* SubObject, UFunction*
 	if (UnresolvedObjects.Num() == 0)
 	{
 		FUnrealObjectRef ObjectRef = PackageMap->GetUnrealObjectRefFromObject(CallingObject);
-		FPendingRPCParamsPtr RPCParams = MakeUnique<FPendingRPCParams>(ObjectRef, MoveTemp(Payload), ReliableRPCIndex);
-		Sender->ProcessRPC(MoveTemp(RPCParams));
+		Sender->ProcessRPC(FPendingRPCParams(ObjectRef, MoveTemp(Payload), ReliableRPCIndex));
 	}
 	else
 	{
@@ -1214,8 +1231,12 @@ void USpatialNetDriver::TickDispatch(float DeltaTime)
 	// Not calling Super:: on purpose.
 	UNetDriver::TickDispatch(DeltaTime);
 
+	SpatialGDK::FSpatialTraceRecorder::Get().Tick();
+
 	if (Connection != nullptr)
 	{
+		SPATIAL_TRACE_SCOPE(TEXT("TickDispatch"), TEXT("Tick"));
+
 		TArray<Worker_OpList*> OpLists = Connection->GetOpList();
 
 		// Servers will queue ops at startup until we've extracted necessary information from the op stream
@@ -1225,11 +1246,26 @@ void USpatialNetDriver::TickDispatch(float DeltaTime)
 			return;
 		}
 
-		for (Worker_OpList* OpList : OpLists)
+		if (SpatialMetrics != nullptr)
+		{
+			for (Worker_OpList* OpList : OpLists)
+			{
+				SpatialMetrics->OpListSizeHistogram.Record(OpList->op_count);
+			}
+		}
+
+		PendingOpLists.Append(OpLists);
+
 		{
-			Dispatcher->ProcessOps(OpList);
+			SpatialGDK::FScopedLatencyRecorder TickDispatchTimer(SpatialMetrics != nullptr ? &SpatialMetrics->TickDispatchTimeHistogram : nullptr);
+			ProcessPendingOpLists();
+		}
 
-			Worker_OpList_Destroy(OpList);
+		// The core classes are only created once the connection to SpatialOS has been established.
+		if (Receiver != nullptr)
+		{
+			Receiver->ProcessTimedOutIncomingRPCs();
+			Receiver->ProcessPendingBeginPlayActors();
 		}
 
 		if (SpatialMetrics != nullptr && GetDefault<USpatialGDKSettings>()->bEnableMetrics)
@@ -1337,7 +1373,12 @@ void USpatialNetDriver::TickFlush(float DeltaTime)
 		double ServerReplicateActorsTimeStart = FPlatformTime::Seconds();
 #endif // USE_SERVER_PERF_COUNTERS
 
-		int32 Updated = ServerReplicateActors(DeltaTime);
+		int32 Updated = 0;
+		{
+			SpatialGDK::FScopedLatencyRecorder ServerReplicateActorsTimer(SpatialMetrics != nullptr ? &SpatialMetrics->ServerReplicateActorsTimeHistogram : nullptr);
+			SPATIAL_TRACE_SCOPE(TEXT("ServerReplicateActors"), TEXT("Tick"));
+			Updated = ServerReplicateActors(DeltaTime);
+		}
 
 #if USE_SERVER_PERF_COUNTERS
 		ServerReplicateActorsTimeMs = (FPlatformTime::Seconds() - ServerReplicateActorsTimeStart) * 1000.0;
@@ -1359,6 +1400,8 @@ void USpatialNetDriver::TickFlush(float DeltaTime)
 			{
 				TimeWhenPositionLastUpdated = Time;
 
+				SpatialGDK::FScopedLatencyRecorder ProcessPositionUpdatesTimer(SpatialMetrics != nullptr ? &SpatialMetrics->ProcessPositionUpdatesTimeHistogram : nullptr);
+				SPATIAL_TRACE_SCOPE(TEXT("ProcessPositionUpdates"), TEXT("Tick"));
 				Sender->ProcessPositionUpdates();
 			}
 		}
@@ -1368,6 +1411,8 @@ void USpatialNetDriver::TickFlush(float DeltaTime)
 
 	if (GetDefault<USpatialGDKSettings>()->bPackRPCs && Sender != nullptr)
 	{
+		SpatialGDK::FScopedLatencyRecorder FlushPackedRPCsTimer(SpatialMetrics != nullptr ? &SpatialMetrics->FlushPackedRPCsTimeHistogram : nullptr);
+		SPATIAL_TRACE_SCOPE(TEXT("FlushPackedRPCs"), TEXT("Tick"));
 		Sender->FlushPackedRPCs();
 	}
 
@@ -1376,6 +1421,16 @@ void USpatialNetDriver::TickFlush(float DeltaTime)
 		TimerManager.Tick(DeltaTime);
 	}
 
+	if (SpatialOutputDevice.IsValid())
+	{
+		SpatialOutputDevice->Flush();
+	}
+
+	if (Connection != nullptr)
+	{
+		Connection->WakeOpsProcessingThread();
+	}
+
 	Super::TickFlush(DeltaTime);
 }
 
@@ -1508,10 +1563,59 @@ bool USpatialNetDriver::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& A
 	{
 		return HandleNetDumpCrossServerRPCCommand(Cmd, Ar);
 	}
+	if (FParse::Command(&Cmd, TEXT("SPATIALTRACE")))
+	{
+		return HandleSpatialTraceCommand(Cmd, Ar);
+	}
+	if (FParse::Command(&Cmd, TEXT("SPATIALBENCHMARK")))
+	{
+		SpatialGDK::SpatialBenchmarks::Run(Cmd, Ar);
+		return true;
+	}
 #endif // !UE_BUILD_SHIPPING
 	return UNetDriver::Exec(InWorld, Cmd, Ar);
 }
 
+#if !UE_BUILD_SHIPPING
+// Usage: SpatialTrace <Seconds> [FileName], or SpatialTrace Stop to stop recording early.
+// Traces are always written to the profiling directory.
+bool USpatialNetDriver::HandleSpatialTraceCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	SpatialGDK::FSpatialTraceRecorder& TraceRecorder = SpatialGDK::FSpatialTraceRecorder::Get();
+
+	if (FParse::Command(&Cmd, TEXT("STOP")))
+	{
+		if (!TraceRecorder.Stop())
+		{
+			Ar.Logf(TEXT("No SpatialOS trace is being recorded."));
+		}
+		return true;
+	}
+
+	const FString SecondsString = FParse::Token(Cmd, false);
+	const double Seconds = FCString::Atod(*SecondsString);
+	if (Seconds <= 0.0)
+	{
+		Ar.Logf(TEXT("Usage: SpatialTrace <Seconds> [FileName], or SpatialTrace Stop"));
+		return true;
+	}
+
+	// Any directories in the name are dropped, so the command can't be used to write files elsewhere.
+	FString FileName = FPaths::GetCleanFilename(FParse::Token(Cmd, false));
+	if (FileName.IsEmpty())
+	{
+		const FString WorkerId = Connection != nullptr ? Connection->GetWorkerId() : FString(TEXT("Unconnected"));
+		FileName = FString::Printf(TEXT("SpatialTrace-%s-%s.json"), *WorkerId, *FDateTime::Now().ToString());
+	}
+
+	if (!TraceRecorder.Start(Seconds, FPaths::Combine(FPaths::ProfilingDir(), FileName)))
+	{
+		Ar.Logf(TEXT("Couldn't start recording a SpatialOS trace, see the log for details."));
+	}
+	return true;
+}
+#endif // !UE_BUILD_SHIPPING
+
 // This function is literally a copy paste of UNetDriver::HandleNetDumpServerRPCCommand. Didn't want to refactor to avoid divergence from engine.
 #if !UE_BUILD_SHIPPING
 bool USpatialNetDriver::HandleNetDumpCrossServerRPCCommand(const TCHAR* Cmd, FOutputDevice& Ar)
@@ -1832,6 +1936,64 @@ void USpatialNetDriver::DelayedSendDeleteEntityRequest(Worker_EntityId EntityId,
 	}, Delay, false);
 }
 
+void USpatialNetDriver::ProcessPendingOpLists()
+{
+	const float BudgetMs = GetDefault<USpatialGDKSettings>()->OpsProcessingBudgetMs;
+	const uint64 DeadlineCycles = BudgetMs > 0.0f ? FPlatformTime::Cycles64() + static_cast<uint64>(BudgetMs / 1000.0 / FPlatformTime::GetSecondsPerCycle64()) : MAX_uint64;
+
+	int32 NumProcessedOpLists = 0;
+	for (; NumProcessedOpLists < PendingOpLists.Num(); NumProcessedOpLists++)
+	{
+		Worker_OpList* OpList = PendingOpLists[NumProcessedOpLists];
+
+		NextPendingOpIndex = Dispatcher->ProcessOps(OpList, NextPendingOpIndex, DeadlineCycles);
+		if (NextPendingOpIndex < OpList->op_count)
+		{
+			break;
+		}
+
+		Connection->DestroyOpList(OpList);
+		NextPendingOpIndex = 0;
+	}
+
+	PendingOpLists.RemoveAt(0, NumProcessedOpLists, false);
+
+	if (PendingOpLists.Num() > 0)
+	{
+		if (NumOpBacklogFrames == 0)
+		{
+			UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Op processing went over the budget of %.2f ms, carrying %d op lists over to the next frame."), BudgetMs, PendingOpLists.Num());
+		}
+		NumOpBacklogFrames++;
+	}
+	else if (NumOpBacklogFrames > 0)
+	{
+		// Count the frame that finished the backlog as well.
+		NumOpBacklogFrames++;
+		UE_LOG(LogSpatialOSNetDriver, Log, TEXT("Processed an op backlog over %d frames."), NumOpBacklogFrames);
+		if (SpatialMetrics != nullptr)
+		{
+			SpatialMetrics->OpBacklogDrainFramesHistogram.Record(NumOpBacklogFrames);
+		}
+		NumOpBacklogFrames = 0;
+	}
+}
+
+void USpatialNetDriver::DestroyPendingOpLists()
+{
+	if (Connection != nullptr)
+	{
+		for (Worker_OpList* OpList : PendingOpLists)
+		{
+			Connection->DestroyOpList(OpList);
+		}
+	}
+
+	PendingOpLists.Reset();
+	NextPendingOpIndex = 0;
+	NumOpBacklogFrames = 0;
+}
+
 void USpatialNetDriver::HandleStartupOpQueueing(const TArray<Worker_OpList*>& InOpLists)
 {
 	if (InOpLists.Num() == 0)
@@ -1856,7 +2018,7 @@ void USpatialNetDriver::HandleStartupOpQueueing(const TArray<Worker_OpList*>& In
 	for (Worker_OpList* OpList : QueuedStartupOpLists)
 	{
 		Dispatcher->ProcessOps(OpList);
-		Worker_OpList_Destroy(OpList);
+		Connection->DestroyOpList(OpList);
 	}
 
 	// Sanity check that the dispatcher encountered, skipped, and removed
@@ -534,18 +534,18 @@ FNetworkGUID FSpatialNetGUIDCache::GetNetGUIDFromUnrealObjectRefInternal(const F
 {
 	FNetworkGUID* CachedGUID = UnrealObjectRefToNetGUID.Find(ObjectRef);
 	FNetworkGUID NetGUID = CachedGUID ? *CachedGUID : FNetworkGUID{};
-	if (!NetGUID.IsValid() && ObjectRef.Path.IsSet())
+	if (!NetGUID.IsValid() && ObjectRef.HasPath())
 	{
 		FNetworkGUID OuterGUID;
 
 		// Recursively resolve the outers for this object in order to ensure that the package can be loaded
-		if (ObjectRef.Outer.IsSet())
+		if (ObjectRef.HasOuter())
 		{
-			OuterGUID = GetNetGUIDFromUnrealObjectRef(ObjectRef.Outer.GetValue());
+			OuterGUID = GetNetGUIDFromUnrealObjectRef(ObjectRef.GetOuter());
 		}
 
 		// Once all outer packages have been resolved, assign a new NetGUID for this object
-		NetGUID = RegisterNetGUIDFromPathForStaticObject(ObjectRef.Path.GetValue(), OuterGUID, ObjectRef.bNoLoadOnClient);
+		NetGUID = RegisterNetGUIDFromPathForStaticObject(ObjectRef.GetPath(), OuterGUID, ObjectRef.bNoLoadOnClient);
 		RegisterObjectRef(NetGUID, ObjectRef);
 	}
 	return NetGUID;
@@ -554,25 +554,38 @@ FNetworkGUID FSpatialNetGUIDCache::GetNetGUIDFromUnrealObjectRefInternal(const F
 void FSpatialNetGUIDCache::NetworkRemapObjectRefPaths(FUnrealObjectRef& ObjectRef, bool bReading) const
 {
 	// If we have paths, network-sanitize all of them (e.g. removing PIE prefix).
-	if (!ObjectRef.Path.IsSet())
+	if (!ObjectRef.HasPath())
 	{
 		return;
 	}
 
-	FUnrealObjectRef* Iterator = &ObjectRef;
-	while (true)
+	NetworkRemapObjectRefPathChain(ObjectRef, bReading);
+}
+
+void FSpatialNetGUIDCache::NetworkRemapObjectRefPathChain(FUnrealObjectRef& ObjectRef, bool bReading) const
+{
+	TOptional<FString> Path;
+	bool bChanged = false;
+	if (ObjectRef.HasPath())
 	{
-		if (Iterator->Path.IsSet())
-		{
-			FString TempPath(*Iterator->Path);
-			GEngine->NetworkRemapPath(Driver, TempPath, bReading);
-			Iterator->Path = TempPath;
-		}
-		if (!Iterator->Outer.IsSet())
-		{
-			break;
-		}
-		Iterator = &Iterator->Outer.GetValue();
+		Path = ObjectRef.GetPath();
+		GEngine->NetworkRemapPath(Driver, Path.GetValue(), bReading);
+		bChanged |= !Path->Equals(ObjectRef.GetPath());
+	}
+
+	TOptional<FUnrealObjectRef> Outer;
+	if (ObjectRef.HasOuter())
+	{
+		Outer = ObjectRef.GetOuter();
+		const FUnrealObjectRef OriginalOuter = Outer.GetValue();
+		NetworkRemapObjectRefPathChain(Outer.GetValue(), bReading);
+		bChanged |= Outer.GetValue() != OriginalOuter;
+	}
+
+	// Paths are interned, so only intern a new one if remapping changed anything.
+	if (bChanged)
+	{
+		ObjectRef.SetPathAndOuter(Path.GetPtrOrNull(), Outer.GetPtrOrNull());
 	}
 }
 
@@ -0,0 +1,196 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/ComponentUpdatePredecoder.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+	uint32 GetValueCount(const Schema_Object* Object, Schema_FieldId FieldId, SpatialGDK::EPredecodedFieldType Type)
+	{
+		using SpatialGDK::EPredecodedFieldType;
+
+		switch (Type)
+		{
+		case EPredecodedFieldType::Bool:
+			return Schema_GetBoolCount(Object, FieldId);
+		case EPredecodedFieldType::Float:
+			return Schema_GetFloatCount(Object, FieldId);
+		case EPredecodedFieldType::Double:
+			return Schema_GetDoubleCount(Object, FieldId);
+		case EPredecodedFieldType::Int32:
+			return Schema_GetInt32Count(Object, FieldId);
+		case EPredecodedFieldType::Int64:
+			return Schema_GetInt64Count(Object, FieldId);
+		case EPredecodedFieldType::Uint32:
+			return Schema_GetUint32Count(Object, FieldId);
+		case EPredecodedFieldType::Uint64:
+			return Schema_GetUint64Count(Object, FieldId);
+		default:
+			return 0;
+		}
+	}
+
+	SpatialGDK::FPredecodedValue IndexValue(const Schema_Object* Object, Schema_FieldId FieldId, uint32 Index, SpatialGDK::EPredecodedFieldType Type)
+	{
+		using SpatialGDK::EPredecodedFieldType;
+
+		SpatialGDK::FPredecodedValue Value;
+		switch (Type)
+		{
+		case EPredecodedFieldType::Bool:
+			Value.UInt = Schema_IndexBool(Object, FieldId, Index);
+			break;
+		case EPredecodedFieldType::Float:
+			Value.Double = Schema_IndexFloat(Object, FieldId, Index);
+			break;
+		case EPredecodedFieldType::Double:
+			Value.Double = Schema_IndexDouble(Object, FieldId, Index);
+			break;
+		case EPredecodedFieldType::Int32:
+			Value.Int = Schema_IndexInt32(Object, FieldId, Index);
+			break;
+		case EPredecodedFieldType::Int64:
+			Value.Int = Schema_IndexInt64(Object, FieldId, Index);
+			break;
+		case EPredecodedFieldType::Uint32:
+			Value.UInt = Schema_IndexUint32(Object, FieldId, Index);
+			break;
+		case EPredecodedFieldType::Uint64:
+			Value.UInt = Schema_IndexUint64(Object, FieldId, Index);
+			break;
+		default:
+			Value.UInt = 0;
+			break;
+		}
+		return Value;
+	}
+}
+
+namespace SpatialGDK
+{
+
+const FPredecodedField* FPredecodedComponentUpdate::FindField(Schema_FieldId FieldId) const
+{
+	const int32 Index = Algo::BinarySearchBy(Fields, FieldId, &FPredecodedField::FieldId);
+	return Index != INDEX_NONE ? &Fields[Index] : nullptr;
+}
+
+void FComponentUpdatePredecoder::SetDecodePlan(Worker_ComponentId ComponentId, FComponentDecodePlan&& Plan)
+{
+	check(IsInGameThread());
+
+	ComponentsWithDecodePlans.Add(ComponentId);
+
+	FRWScopeLock Lock(DecodePlansLock, SLT_Write);
+	DecodePlans.Add(ComponentId, MoveTemp(Plan));
+}
+
+void FComponentUpdatePredecoder::PredecodeOpList(const Worker_OpList& OpList)
+{
+	TUniquePtr<FPredecodedOpList> Predecoded;
+
+	{
+		FRWScopeLock Lock(DecodePlansLock, SLT_ReadOnly);
+
+		if (DecodePlans.Num() == 0)
+		{
+			return;
+		}
+
+		for (uint32 i = 0; i < OpList.op_count; i++)
+		{
+			const Worker_Op& Op = OpList.ops[i];
+			if (Op.op_type != WORKER_OP_TYPE_COMPONENT_UPDATE)
+			{
+				continue;
+			}
+
+			const FComponentDecodePlan* Plan = DecodePlans.Find(Op.component_update.update.component_id);
+			if (Plan == nullptr)
+			{
+				continue;
+			}
+
+			if (!Predecoded.IsValid())
+			{
+				Predecoded = MakeUnique<FPredecodedOpList>();
+				Predecoded->UpdateIndices.Init(INDEX_NONE, OpList.op_count);
+			}
+
+			Predecoded->UpdateIndices[i] = Predecoded->Updates.Num();
+			PredecodeUpdate(Op.component_update.update, *Plan, Predecoded->Updates.AddDefaulted_GetRef());
+		}
+	}
+
+	if (Predecoded.IsValid())
+	{
+		FScopeLock Lock(&OpListsLock);
+		OpLists.Add(&OpList, MoveTemp(Predecoded));
+	}
+}
+
+void FComponentUpdatePredecoder::PredecodeUpdate(const Worker_ComponentUpdate& Update, const FComponentDecodePlan& Plan, FPredecodedComponentUpdate& OutPredecoded)
+{
+	Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(Update.schema_type);
+
+	const uint32 NumUpdatedIds = Schema_GetUniqueFieldIdCount(ComponentObject);
+	const uint32 NumClearedIds = Schema_GetComponentUpdateClearedFieldCount(Update.schema_type);
+
+	OutPredecoded.FieldIds.SetNumUninitialized(NumUpdatedIds + NumClearedIds);
+	Schema_GetUniqueFieldIds(ComponentObject, OutPredecoded.FieldIds.GetData());
+	Schema_GetComponentUpdateClearedFieldList(Update.schema_type, OutPredecoded.FieldIds.GetData() + NumUpdatedIds);
+
+	for (uint32 i = 0; i < NumUpdatedIds + NumClearedIds; i++)
+	{
+		const Schema_FieldId FieldId = OutPredecoded.FieldIds[i];
+		if (!Plan.IsValidIndex(FieldId) || Plan[FieldId].Type == EPredecodedFieldType::None)
+		{
+			continue;
+		}
+
+		const FFieldDecodeInfo& Info = Plan[FieldId];
+		const uint32 Count = GetValueCount(ComponentObject, FieldId, Info.Type);
+
+		// Single values are always read from index 0, so leave missing ones to the game thread to keep its behaviour.
+		if (!Info.bIsList && Count == 0)
+		{
+			continue;
+		}
+
+		const uint32 NumValues = Info.bIsList ? Count : 1;
+
+		OutPredecoded.Fields.Add(FPredecodedField{ FieldId, Info.Type, static_cast<uint32>(OutPredecoded.Values.Num()), NumValues });
+		for (uint32 Index = 0; Index < NumValues; Index++)
+		{
+			OutPredecoded.Values.Add(IndexValue(ComponentObject, FieldId, Index, Info.Type));
+		}
+	}
+
+	Algo::SortBy(OutPredecoded.Fields, &FPredecodedField::FieldId);
+}
+
+FPredecodedOpList* FComponentUpdatePredecoder::FindOpList(const Worker_OpList* OpList) const
+{
+	FScopeLock Lock(&OpListsLock);
+
+	const TUniquePtr<FPredecodedOpList>* Predecoded = OpLists.Find(OpList);
+	return Predecoded != nullptr ? Predecoded->Get() : nullptr;
+}
+
+void FComponentUpdatePredecoder::Invalidate(const Worker_OpList* OpList, uint32 OpIndex)
+{
+	if (FPredecodedOpList* Predecoded = FindOpList(OpList))
+	{
+		Predecoded->UpdateIndices[OpIndex] = INDEX_NONE;
+	}
+}
+
+void FComponentUpdatePredecoder::ReleaseOpList(const Worker_OpList* OpList)
+{
+	FScopeLock Lock(&OpListsLock);
+	OpLists.Remove(OpList);
+}
+
+} // namespace SpatialGDK
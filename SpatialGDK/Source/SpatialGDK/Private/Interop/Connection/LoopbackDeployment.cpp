@@ -0,0 +1,960 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/LoopbackDeployment.h"
+
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+
+#include "Schema/StandardLibrary.h"
+#include "SpatialCommonTypes.h"
+#include "SpatialConstants.h"
+#include "Utils/SchemaUtils.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialLoopback);
+
+namespace
+{
+	using namespace SpatialGDK;
+
+	// Matches the default command timeout of the Worker SDK.
+	const uint32 CommandTimeoutMillis = 5000;
+
+	Worker_ComponentData CopyComponentData(const Worker_ComponentData& Source)
+	{
+		Worker_ComponentData Copy{};
+		Copy.component_id = Source.component_id;
+		Copy.schema_type = DeepCopyComponentData(Source.schema_type);
+		return Copy;
+	}
+
+	Worker_ComponentUpdate CopyComponentUpdate(const Worker_ComponentUpdate& Source)
+	{
+		Worker_ComponentUpdate Copy{};
+		Copy.component_id = Source.component_id;
+		Copy.schema_type = Schema_CreateComponentUpdate(Source.component_id);
+		DeepCopySchemaObject(Schema_GetComponentUpdateFields(Source.schema_type), Schema_GetComponentUpdateFields(Copy.schema_type));
+		DeepCopySchemaObject(Schema_GetComponentUpdateEvents(Source.schema_type), Schema_GetComponentUpdateEvents(Copy.schema_type));
+
+		const uint32 ClearedFieldCount = Schema_GetComponentUpdateClearedFieldCount(Source.schema_type);
+		if (ClearedFieldCount > 0)
+		{
+			TArray<Schema_FieldId> ClearedFields;
+			ClearedFields.SetNumUninitialized(ClearedFieldCount);
+			Schema_GetComponentUpdateClearedFieldList(Source.schema_type, ClearedFields.GetData());
+			for (Schema_FieldId FieldId : ClearedFields)
+			{
+				Schema_AddComponentUpdateClearedField(Copy.schema_type, FieldId);
+			}
+		}
+
+		return Copy;
+	}
+
+	void ApplyComponentUpdateToData(const Worker_ComponentUpdate& Update, const Worker_ComponentData& Data)
+	{
+		Schema_Object* UpdateFields = Schema_GetComponentUpdateFields(Update.schema_type);
+		Schema_Object* DataFields = Schema_GetComponentDataFields(Data.schema_type);
+
+		// A field in an update replaces the whole field, including every element of a list or map,
+		// so existing values are cleared before merging rather than appended to.
+		TArray<Schema_FieldId> FieldIds;
+		FieldIds.SetNumUninitialized(Schema_GetUniqueFieldIdCount(UpdateFields));
+		Schema_GetUniqueFieldIds(UpdateFields, FieldIds.GetData());
+
+		const uint32 ClearedFieldCount = Schema_GetComponentUpdateClearedFieldCount(Update.schema_type);
+		if (ClearedFieldCount > 0)
+		{
+			const int32 Offset = FieldIds.AddUninitialized(ClearedFieldCount);
+			Schema_GetComponentUpdateClearedFieldList(Update.schema_type, FieldIds.GetData() + Offset);
+		}
+
+		for (Schema_FieldId FieldId : FieldIds)
+		{
+			Schema_ClearField(DataFields, FieldId);
+		}
+
+		const uint32 Length = Schema_GetWriteBufferLength(UpdateFields);
+		if (Length > 0)
+		{
+			uint8_t* Buffer = Schema_AllocateBuffer(DataFields, Length);
+			Schema_WriteToBuffer(UpdateFields, Buffer);
+			Schema_MergeFromBuffer(DataFields, Buffer, Length);
+		}
+	}
+
+	bool SatisfiesRequirementSet(const TArray<FString>& WorkerAttributes, const WorkerRequirementSet& RequirementSet)
+	{
+		for (const WorkerAttributeSet& AttributeSet : RequirementSet)
+		{
+			bool bSatisfied = true;
+			for (const FString& Attribute : AttributeSet)
+			{
+				if (!WorkerAttributes.Contains(Attribute))
+				{
+					bSatisfied = false;
+					break;
+				}
+			}
+
+			if (bSatisfied)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+} // anonymous namespace
+
+namespace SpatialGDK
+{
+
+class FLoopbackDeployment
+{
+public:
+	~FLoopbackDeployment();
+
+	void LoadSnapshot(const FString& SnapshotPath);
+
+	uint32 AddWorker(const FString& WorkerType, FString& InOutWorkerId, TArray<FString>& OutWorkerAttributes);
+	void RemoveWorker(uint32 WorkerHandle);
+
+	void HandleMessage(uint32 WorkerHandle, FOutgoingMessage& Message);
+	void HandleComponentUpdate(uint32 WorkerHandle, Worker_EntityId EntityId, const Worker_ComponentUpdate& Update);
+
+	TUniquePtr<FOwnedOpList> TakeOpList(uint32 WorkerHandle);
+
+private:
+	struct FEntity
+	{
+		TMap<Worker_ComponentId, Worker_ComponentData> Components;
+
+		// Parsed from the EntityAcl component whenever it changes.
+		WorkerRequirementSet ReadAcl;
+		WriteAclMap ComponentWriteAcl;
+
+		// Handle of the worker authoritative over each component, if any.
+		TMap<Worker_ComponentId, uint32> Authority;
+	};
+
+	struct FWorker
+	{
+		FString WorkerId;
+		TArray<FString> Attributes;
+		TUniquePtr<FOwnedOpList> PendingOps;
+		TSet<Worker_EntityId_Key> VisibleEntities;
+	};
+
+	struct FPendingCommand
+	{
+		uint32 CallerHandle;
+		uint32 TargetHandle;
+		Worker_RequestId CallerRequestId;
+		Worker_EntityId EntityId;
+		Worker_ComponentId ComponentId;
+		uint32 CommandId;
+	};
+
+	void HandleReserveEntityIdsRequest(FWorker& Worker, FReserveEntityIdsRequest& Message);
+	void HandleCreateEntityRequest(FWorker& Worker, FCreateEntityRequest& Message);
+	void HandleDeleteEntityRequest(FWorker& Worker, FDeleteEntityRequest& Message);
+	void HandleAddComponent(FAddComponent& Message);
+	void HandleRemoveComponent(FRemoveComponent& Message);
+	void HandleCommandRequest(uint32 WorkerHandle, FWorker& Worker, FCommandRequest& Message);
+	void HandleCommandResponse(Worker_RequestId RequestId, const Worker_CommandResponse* Response, const FString* FailureMessage);
+	void HandleEntityQueryRequest(FWorker& Worker, FEntityQueryRequest& Message);
+
+	// Brings each worker's view of the entity, and the authority over its components, in line with its EntityAcl.
+	void RefreshEntity(Worker_EntityId EntityId, FEntity& Entity);
+	void RefreshAllEntities();
+	void RemoveEntityFromView(FWorker& Worker, uint32 WorkerHandle, Worker_EntityId EntityId, const FEntity& Entity);
+	static void UpdateAcl(FEntity& Entity);
+	static bool MatchesConstraint(const Worker_Constraint& Constraint, Worker_EntityId EntityId, const FEntity& Entity);
+
+	static Worker_Op& AddOp(FWorker& Worker, uint8 OpType);
+	static const char* AddString(FWorker& Worker, const FString& String);
+	void SendCommandResponseOp(const FPendingCommand& Command, uint8 StatusCode, const FString& Message, Schema_CommandResponse* Response);
+
+	FCriticalSection Mutex;
+
+	TMap<Worker_EntityId_Key, FEntity> Entities;
+	Worker_EntityId NextEntityId = 1;
+
+	// Workers that connected earlier are preferred for authority.
+	TMap<uint32, FWorker> Workers;
+	uint32 NextWorkerHandle = 1;
+
+	TMap<Worker_RequestId, FPendingCommand> PendingCommands;
+	Worker_RequestId NextCommandRequestId = 0;
+};
+
+namespace
+{
+	FCriticalSection ActiveDeploymentMutex;
+	TWeakPtr<FLoopbackDeployment, ESPMode::ThreadSafe> ActiveDeployment;
+}
+
+FLoopbackDeployment::~FLoopbackDeployment()
+{
+	for (const TPair<Worker_EntityId_Key, FEntity>& Entity : Entities)
+	{
+		for (const TPair<Worker_ComponentId, Worker_ComponentData>& Component : Entity.Value.Components)
+		{
+			Schema_DestroyComponentData(Component.Value.schema_type);
+		}
+	}
+}
+
+void FLoopbackDeployment::LoadSnapshot(const FString& SnapshotPath)
+{
+	Worker_ComponentVtable DefaultVtable{};
+	Worker_SnapshotParameters Parameters{};
+	Parameters.default_component_vtable = &DefaultVtable;
+
+	Worker_SnapshotInputStream* Snapshot = Worker_SnapshotInputStream_Create(TCHAR_TO_UTF8(*SnapshotPath), &Parameters);
+
+	FString Error = Worker_SnapshotInputStream_GetError(Snapshot);
+	while (Error.IsEmpty() && Worker_SnapshotInputStream_HasNext(Snapshot) > 0)
+	{
+		const Worker_Entity* SnapshotEntity = Worker_SnapshotInputStream_ReadEntity(Snapshot);
+
+		Error = Worker_SnapshotInputStream_GetError(Snapshot);
+		if (!Error.IsEmpty())
+		{
+			break;
+		}
+
+		FEntity& Entity = Entities.Add(SnapshotEntity->entity_id);
+		for (uint32 i = 0; i < SnapshotEntity->component_count; i++)
+		{
+			const Worker_ComponentData& Component = SnapshotEntity->components[i];
+			Entity.Components.Add(Component.component_id, CopyComponentData(Component));
+		}
+		UpdateAcl(Entity);
+
+		NextEntityId = FMath::Max(NextEntityId, SnapshotEntity->entity_id + 1);
+	}
+
+	Worker_SnapshotInputStream_Destroy(Snapshot);
+
+	if (!Error.IsEmpty())
+	{
+		UE_LOG(LogSpatialLoopback, Error, TEXT("Error when reading snapshot '%s', loaded %d entities: %s"), *SnapshotPath, Entities.Num(), *Error);
+		return;
+	}
+
+	UE_LOG(LogSpatialLoopback, Log, TEXT("Loaded %d entities from snapshot '%s'."), Entities.Num(), *SnapshotPath);
+}
+
+uint32 FLoopbackDeployment::AddWorker(const FString& WorkerType, FString& InOutWorkerId, TArray<FString>& OutWorkerAttributes)
+{
+	FScopeLock Lock(&Mutex);
+
+	const uint32 WorkerHandle = NextWorkerHandle++;
+
+	bool bWorkerIdInUse = InOutWorkerId.IsEmpty();
+	for (const TPair<uint32, FWorker>& Worker : Workers)
+	{
+		bWorkerIdInUse |= Worker.Value.WorkerId == InOutWorkerId;
+	}
+
+	if (bWorkerIdInUse)
+	{
+		InOutWorkerId = FString::Printf(TEXT("%s%u"), InOutWorkerId.IsEmpty() ? *WorkerType : *InOutWorkerId, WorkerHandle);
+	}
+
+	OutWorkerAttributes = { WorkerType, FString::Printf(TEXT("workerId:%s"), *InOutWorkerId) };
+
+	FWorker& Worker = Workers.Add(WorkerHandle);
+	Worker.WorkerId = InOutWorkerId;
+	Worker.Attributes = OutWorkerAttributes;
+	Worker.PendingOps = MakeUnique<FOwnedOpList>();
+
+	UE_LOG(LogSpatialLoopback, Log, TEXT("Worker %s connected to the loopback deployment."), *InOutWorkerId);
+
+	RefreshAllEntities();
+
+	return WorkerHandle;
+}
+
+void FLoopbackDeployment::RemoveWorker(uint32 WorkerHandle)
+{
+	FScopeLock Lock(&Mutex);
+
+	UE_LOG(LogSpatialLoopback, Log, TEXT("Worker %s disconnected from the loopback deployment."), *Workers[WorkerHandle].WorkerId);
+
+	Workers.Remove(WorkerHandle);
+
+	// Commands sent to the worker will never be answered.
+	for (auto It = PendingCommands.CreateIterator(); It; ++It)
+	{
+		if (It.Value().TargetHandle == WorkerHandle)
+		{
+			SendCommandResponseOp(It.Value(), WORKER_STATUS_CODE_TIMEOUT, TEXT("The worker handling the command disconnected."), nullptr);
+			It.RemoveCurrent();
+		}
+	}
+
+	RefreshAllEntities();
+}
+
+TUniquePtr<FOwnedOpList> FLoopbackDeployment::TakeOpList(uint32 WorkerHandle)
+{
+	FScopeLock Lock(&Mutex);
+
+	FWorker& Worker = Workers[WorkerHandle];
+	if (Worker.PendingOps->Ops.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FOwnedOpList> OpList = MoveTemp(Worker.PendingOps);
+	Worker.PendingOps = MakeUnique<FOwnedOpList>();
+
+	OpList->ops = OpList->Ops.GetData();
+	OpList->op_count = OpList->Ops.Num();
+	return OpList;
+}
+
+void FLoopbackDeployment::HandleMessage(uint32 WorkerHandle, FOutgoingMessage& Message)
+{
+	FScopeLock Lock(&Mutex);
+
+	FWorker& Worker = Workers[WorkerHandle];
+
+	switch (Message.Type)
+	{
+	case EOutgoingMessageType::ReserveEntityIdsRequest:
+		HandleReserveEntityIdsRequest(Worker, static_cast<FReserveEntityIdsRequest&>(Message));
+		break;
+	case EOutgoingMessageType::CreateEntityRequest:
+		HandleCreateEntityRequest(Worker, static_cast<FCreateEntityRequest&>(Message));
+		break;
+	case EOutgoingMessageType::DeleteEntityRequest:
+		HandleDeleteEntityRequest(Worker, static_cast<FDeleteEntityRequest&>(Message));
+		break;
+	case EOutgoingMessageType::AddComponent:
+		HandleAddComponent(static_cast<FAddComponent&>(Message));
+		break;
+	case EOutgoingMessageType::RemoveComponent:
+		HandleRemoveComponent(static_cast<FRemoveComponent&>(Message));
+		break;
+	case EOutgoingMessageType::ComponentUpdate:
+	{
+		FComponentUpdate& Update = static_cast<FComponentUpdate&>(Message);
+		HandleComponentUpdate(WorkerHandle, Update.EntityId, Update.Update);
+		Schema_DestroyComponentUpdate(Update.Update.schema_type);
+		break;
+	}
+	case EOutgoingMessageType::CommandRequest:
+		HandleCommandRequest(WorkerHandle, Worker, static_cast<FCommandRequest&>(Message));
+		break;
+	case EOutgoingMessageType::CommandResponse:
+	{
+		FCommandResponse& Response = static_cast<FCommandResponse&>(Message);
+		HandleCommandResponse(Response.RequestId, &Response.Response, nullptr);
+		break;
+	}
+	case EOutgoingMessageType::CommandFailure:
+	{
+		FCommandFailure& Failure = static_cast<FCommandFailure&>(Message);
+		HandleCommandResponse(Failure.RequestId, nullptr, &Failure.Message);
+		break;
+	}
+	case EOutgoingMessageType::EntityQueryRequest:
+		HandleEntityQueryRequest(Worker, static_cast<FEntityQueryRequest&>(Message));
+		break;
+	default:
+		// Log messages, metrics and component interest have no effect on the loopback deployment.
+		break;
+	}
+}
+
+void FLoopbackDeployment::HandleReserveEntityIdsRequest(FWorker& Worker, FReserveEntityIdsRequest& Message)
+{
+	Worker_ReserveEntityIdsResponseOp& Response = AddOp(Worker, WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE).reserve_entity_ids_response;
+	Response.request_id = Message.RequestId;
+	Response.status_code = WORKER_STATUS_CODE_SUCCESS;
+	Response.message = AddString(Worker, FString());
+	Response.first_entity_id = NextEntityId;
+	Response.number_of_entity_ids = Message.NumOfEntities;
+
+	NextEntityId += Message.NumOfEntities;
+}
+
+void FLoopbackDeployment::HandleCreateEntityRequest(FWorker& Worker, FCreateEntityRequest& Message)
+{
+	const Worker_EntityId EntityId = Message.EntityId.IsSet() ? Message.EntityId.GetValue() : NextEntityId++;
+	NextEntityId = FMath::Max(NextEntityId, EntityId + 1);
+
+	const bool bAlreadyExists = Entities.Contains(EntityId);
+
+	Worker_CreateEntityResponseOp& Response = AddOp(Worker, WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE).create_entity_response;
+	Response.request_id = Message.RequestId;
+	Response.status_code = bAlreadyExists ? WORKER_STATUS_CODE_APPLICATION_ERROR : WORKER_STATUS_CODE_SUCCESS;
+	Response.message = AddString(Worker, bAlreadyExists ? FString::Printf(TEXT("Entity %lld already exists."), EntityId) : FString());
+	Response.entity_id = EntityId;
+
+	if (bAlreadyExists)
+	{
+		for (const Worker_ComponentData& Component : Message.Components)
+		{
+			Schema_DestroyComponentData(Component.schema_type);
+		}
+		return;
+	}
+
+	FEntity& Entity = Entities.Add(EntityId);
+	for (const Worker_ComponentData& Component : Message.Components)
+	{
+		if (Entity.Components.Contains(Component.component_id))
+		{
+			Schema_DestroyComponentData(Component.schema_type);
+			continue;
+		}
+		Entity.Components.Add(Component.component_id, Component);
+	}
+
+	UpdateAcl(Entity);
+	RefreshEntity(EntityId, Entity);
+}
+
+void FLoopbackDeployment::HandleDeleteEntityRequest(FWorker& Worker, FDeleteEntityRequest& Message)
+{
+	FEntity* Entity = Entities.Find(Message.EntityId);
+
+	Worker_DeleteEntityResponseOp& Response = AddOp(Worker, WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE).delete_entity_response;
+	Response.request_id = Message.RequestId;
+	Response.entity_id = Message.EntityId;
+	Response.status_code = Entity != nullptr ? WORKER_STATUS_CODE_SUCCESS : WORKER_STATUS_CODE_NOT_FOUND;
+	Response.message = AddString(Worker, Entity != nullptr ? FString() : FString::Printf(TEXT("Entity %lld does not exist."), Message.EntityId));
+
+	if (Entity == nullptr)
+	{
+		return;
+	}
+
+	for (TPair<uint32, FWorker>& Viewer : Workers)
+	{
+		if (Viewer.Value.VisibleEntities.Contains(Message.EntityId))
+		{
+			RemoveEntityFromView(Viewer.Value, Viewer.Key, Message.EntityId, *Entity);
+		}
+	}
+
+	for (const TPair<Worker_ComponentId, Worker_ComponentData>& Component : Entity->Components)
+	{
+		Schema_DestroyComponentData(Component.Value.schema_type);
+	}
+	Entities.Remove(Message.EntityId);
+}
+
+void FLoopbackDeployment::HandleAddComponent(FAddComponent& Message)
+{
+	FEntity* Entity = Entities.Find(Message.EntityId);
+	if (Entity == nullptr || Entity->Components.Contains(Message.Data.component_id))
+	{
+		UE_LOG(LogSpatialLoopback, Verbose, TEXT("Ignoring add of component %u to entity %lld, the entity doesn't exist or already has it."), Message.Data.component_id, Message.EntityId);
+		Schema_DestroyComponentData(Message.Data.schema_type);
+		return;
+	}
+
+	Entity->Components.Add(Message.Data.component_id, Message.Data);
+
+	for (TPair<uint32, FWorker>& Viewer : Workers)
+	{
+		if (Viewer.Value.VisibleEntities.Contains(Message.EntityId))
+		{
+			Worker_AddComponentOp& Op = AddOp(Viewer.Value, WORKER_OP_TYPE_ADD_COMPONENT).add_component;
+			Op.entity_id = Message.EntityId;
+			Op.data = CopyComponentData(Message.Data);
+		}
+	}
+
+	if (Message.Data.component_id == SpatialConstants::ENTITY_ACL_COMPONENT_ID)
+	{
+		UpdateAcl(*Entity);
+	}
+	RefreshEntity(Message.EntityId, *Entity);
+}
+
+void FLoopbackDeployment::HandleRemoveComponent(FRemoveComponent& Message)
+{
+	FEntity* Entity = Entities.Find(Message.EntityId);
+	Worker_ComponentData* Data = Entity != nullptr ? Entity->Components.Find(Message.ComponentId) : nullptr;
+	if (Data == nullptr)
+	{
+		return;
+	}
+
+	const uint32* AuthoritativeWorker = Entity->Authority.Find(Message.ComponentId);
+
+	for (TPair<uint32, FWorker>& Viewer : Workers)
+	{
+		if (!Viewer.Value.VisibleEntities.Contains(Message.EntityId))
+		{
+			continue;
+		}
+
+		if (AuthoritativeWorker != nullptr && *AuthoritativeWorker == Viewer.Key)
+		{
+			Worker_AuthorityChangeOp& Op = AddOp(Viewer.Value, WORKER_OP_TYPE_AUTHORITY_CHANGE).authority_change;
+			Op.entity_id = Message.EntityId;
+			Op.component_id = Message.ComponentId;
+			Op.authority = WORKER_AUTHORITY_NOT_AUTHORITATIVE;
+		}
+
+		Worker_RemoveComponentOp& Op = AddOp(Viewer.Value, WORKER_OP_TYPE_REMOVE_COMPONENT).remove_component;
+		Op.entity_id = Message.EntityId;
+		Op.component_id = Message.ComponentId;
+	}
+
+	Schema_DestroyComponentData(Data->schema_type);
+	Entity->Components.Remove(Message.ComponentId);
+	Entity->Authority.Remove(Message.ComponentId);
+
+	if (Message.ComponentId == SpatialConstants::ENTITY_ACL_COMPONENT_ID)
+	{
+		UpdateAcl(*Entity);
+	}
+	RefreshEntity(Message.EntityId, *Entity);
+}
+
+void FLoopbackDeployment::HandleComponentUpdate(uint32 WorkerHandle, Worker_EntityId EntityId, const Worker_ComponentUpdate& Update)
+{
+	FScopeLock Lock(&Mutex);
+
+	FEntity* Entity = Entities.Find(EntityId);
+	Worker_ComponentData* Data = Entity != nullptr ? Entity->Components.Find(Update.component_id) : nullptr;
+	const uint32* AuthoritativeWorker = Entity != nullptr ? Entity->Authority.Find(Update.component_id) : nullptr;
+
+	// As in SpatialOS, updates from workers without authority are dropped.
+	if (Data == nullptr || AuthoritativeWorker == nullptr || *AuthoritativeWorker != WorkerHandle)
+	{
+		UE_LOG(LogSpatialLoopback, Verbose, TEXT("Dropping update to component %u on entity %lld from worker %s without authority."), Update.component_id, EntityId, *Workers[WorkerHandle].WorkerId);
+		return;
+	}
+
+	ApplyComponentUpdateToData(Update, *Data);
+
+	// Updates are not looped back to the sender, matching how the connection sends them to SpatialOS.
+	for (TPair<uint32, FWorker>& Viewer : Workers)
+	{
+		if (Viewer.Key != WorkerHandle && Viewer.Value.VisibleEntities.Contains(EntityId))
+		{
+			Worker_ComponentUpdateOp& Op = AddOp(Viewer.Value, WORKER_OP_TYPE_COMPONENT_UPDATE).component_update;
+			Op.entity_id = EntityId;
+			Op.update = CopyComponentUpdate(Update);
+		}
+	}
+
+	if (Update.component_id == SpatialConstants::ENTITY_ACL_COMPONENT_ID)
+	{
+		UpdateAcl(*Entity);
+		RefreshEntity(EntityId, *Entity);
+	}
+}
+
+void FLoopbackDeployment::HandleCommandRequest(uint32 WorkerHandle, FWorker& Worker, FCommandRequest& Message)
+{
+	FPendingCommand Command{ WorkerHandle, 0, Message.RequestId, Message.EntityId, Message.Request.component_id, Message.CommandId };
+
+	const FEntity* Entity = Entities.Find(Message.EntityId);
+	const uint32* AuthoritativeWorker = Entity != nullptr ? Entity->Authority.Find(Message.Request.component_id) : nullptr;
+	if (AuthoritativeWorker == nullptr)
+	{
+		// SpatialOS would time out the request, but there is no reason to wait here.
+		SendCommandResponseOp(Command, Entity != nullptr ? WORKER_STATUS_CODE_TIMEOUT : WORKER_STATUS_CODE_NOT_FOUND,
+			FString::Printf(TEXT("No worker is authoritative over component %u on entity %lld."), Message.Request.component_id, Message.EntityId), nullptr);
+		Schema_DestroyCommandRequest(Message.Request.schema_type);
+		return;
+	}
+
+	Command.TargetHandle = *AuthoritativeWorker;
+
+	const Worker_RequestId RequestId = NextCommandRequestId++;
+	PendingCommands.Add(RequestId, Command);
+
+	FWorker& Target = Workers[Command.TargetHandle];
+
+	Worker_CommandRequestOp& Op = AddOp(Target, WORKER_OP_TYPE_COMMAND_REQUEST).command_request;
+	Op.request_id = RequestId;
+	Op.entity_id = Message.EntityId;
+	Op.timeout_millis = CommandTimeoutMillis;
+	Op.caller_worker_id = AddString(Target, Worker.WorkerId);
+
+	TArray<const char*>& CallerAttributes = Target.PendingOps->StringLists[Target.PendingOps->StringLists.AddDefaulted()];
+	for (const FString& Attribute : Worker.Attributes)
+	{
+		CallerAttributes.Add(AddString(Target, Attribute));
+	}
+	Op.caller_attribute_set.attribute_count = CallerAttributes.Num();
+	Op.caller_attribute_set.attributes = CallerAttributes.GetData();
+
+	// The op list takes ownership of the request.
+	Op.request = Message.Request;
+}
+
+void FLoopbackDeployment::HandleCommandResponse(Worker_RequestId RequestId, const Worker_CommandResponse* Response, const FString* FailureMessage)
+{
+	FPendingCommand Command;
+	if (!PendingCommands.RemoveAndCopyValue(RequestId, Command))
+	{
+		if (Response != nullptr)
+		{
+			Schema_DestroyCommandResponse(Response->schema_type);
+		}
+		return;
+	}
+
+	if (Response != nullptr)
+	{
+		SendCommandResponseOp(Command, WORKER_STATUS_CODE_SUCCESS, FString(), Response->schema_type);
+	}
+	else
+	{
+		SendCommandResponseOp(Command, WORKER_STATUS_CODE_APPLICATION_ERROR, *FailureMessage, nullptr);
+	}
+}
+
+void FLoopbackDeployment::SendCommandResponseOp(const FPendingCommand& Command, uint8 StatusCode, const FString& Message, Schema_CommandResponse* Response)
+{
+	FWorker* Caller = Workers.Find(Command.CallerHandle);
+	if (Caller == nullptr)
+	{
+		if (Response != nullptr)
+		{
+			Schema_DestroyCommandResponse(Response);
+		}
+		return;
+	}
+
+	Worker_CommandResponseOp& Op = AddOp(*Caller, WORKER_OP_TYPE_COMMAND_RESPONSE).command_response;
+	Op.request_id = Command.CallerRequestId;
+	Op.entity_id = Command.EntityId;
+	Op.status_code = StatusCode;
+	Op.message = AddString(*Caller, Message);
+	Op.command_id = Command.CommandId;
+	Op.response.component_id = Command.ComponentId;
+	Op.response.schema_type = Response;
+}
+
+void FLoopbackDeployment::HandleEntityQueryRequest(FWorker& Worker, FEntityQueryRequest& Message)
+{
+	const Worker_EntityQuery& Query = Message.EntityQuery;
+	FOwnedOpList& OpList = *Worker.PendingOps;
+
+	TArray<Worker_Entity>* Results = nullptr;
+	uint32 ResultCount = 0;
+
+	if (Query.result_type == WORKER_RESULT_TYPE_SNAPSHOT)
+	{
+		Results = &OpList.EntityLists[OpList.EntityLists.AddDefaulted()];
+	}
+
+	for (const TPair<Worker_EntityId_Key, FEntity>& Entity : Entities)
+	{
+		if (!MatchesConstraint(Query.constraint, Entity.Key, Entity.Value))
+		{
+			continue;
+		}
+
+		ResultCount++;
+
+		if (Results == nullptr)
+		{
+			continue;
+		}
+
+		TArray<Worker_ComponentData>& Components = OpList.ComponentDataLists[OpList.ComponentDataLists.AddDefaulted()];
+		for (const TPair<Worker_ComponentId, Worker_ComponentData>& Component : Entity.Value.Components)
+		{
+			bool bIncluded = Query.snapshot_result_type_component_ids == nullptr;
+			for (uint32 i = 0; i < Query.snapshot_result_type_component_id_count && !bIncluded; i++)
+			{
+				bIncluded = Query.snapshot_result_type_component_ids[i] == Component.Key;
+			}
+
+			if (bIncluded)
+			{
+				Components.Add(CopyComponentData(Component.Value));
+			}
+		}
+
+		Worker_Entity& Result = (*Results)[Results->AddZeroed()];
+		Result.entity_id = Entity.Key;
+		Result.component_count = Components.Num();
+		Result.components = Components.GetData();
+	}
+
+	Worker_EntityQueryResponseOp& Response = AddOp(Worker, WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE).entity_query_response;
+	Response.request_id = Message.RequestId;
+	Response.status_code = WORKER_STATUS_CODE_SUCCESS;
+	Response.message = AddString(Worker, FString());
+	Response.result_count = ResultCount;
+	Response.results = Results != nullptr ? Results->GetData() : nullptr;
+}
+
+bool FLoopbackDeployment::MatchesConstraint(const Worker_Constraint& Constraint, Worker_EntityId EntityId, const FEntity& Entity)
+{
+	switch (Constraint.constraint_type)
+	{
+	case WORKER_CONSTRAINT_TYPE_ENTITY_ID:
+		return Constraint.entity_id_constraint.entity_id == EntityId;
+	case WORKER_CONSTRAINT_TYPE_COMPONENT:
+		return Entity.Components.Contains(Constraint.component_constraint.component_id);
+	case WORKER_CONSTRAINT_TYPE_SPHERE:
+	{
+		const Worker_ComponentData* PositionData = Entity.Components.Find(SpatialConstants::POSITION_COMPONENT_ID);
+		if (PositionData == nullptr)
+		{
+			return false;
+		}
+
+		const Coordinates Coords = Position(*PositionData).Coords;
+		const Worker_SphereConstraint& Sphere = Constraint.sphere_constraint;
+		const double DistanceSquared = FMath::Square(Coords.X - Sphere.x) + FMath::Square(Coords.Y - Sphere.y) + FMath::Square(Coords.Z - Sphere.z);
+		return DistanceSquared <= FMath::Square(Sphere.radius);
+	}
+	case WORKER_CONSTRAINT_TYPE_AND:
+		for (uint32 i = 0; i < Constraint.and_constraint.constraint_count; i++)
+		{
+			if (!MatchesConstraint(Constraint.and_constraint.constraints[i], EntityId, Entity))
+			{
+				return false;
+			}
+		}
+		return true;
+	case WORKER_CONSTRAINT_TYPE_OR:
+		for (uint32 i = 0; i < Constraint.or_constraint.constraint_count; i++)
+		{
+			if (MatchesConstraint(Constraint.or_constraint.constraints[i], EntityId, Entity))
+			{
+				return true;
+			}
+		}
+		return false;
+	case WORKER_CONSTRAINT_TYPE_NOT:
+		return !MatchesConstraint(*Constraint.not_constraint.constraint, EntityId, Entity);
+	default:
+		return false;
+	}
+}
+
+void FLoopbackDeployment::UpdateAcl(FEntity& Entity)
+{
+	if (const Worker_ComponentData* AclData = Entity.Components.Find(SpatialConstants::ENTITY_ACL_COMPONENT_ID))
+	{
+		EntityAcl Acl(*AclData);
+		Entity.ReadAcl = MoveTemp(Acl.ReadAcl);
+		Entity.ComponentWriteAcl = MoveTemp(Acl.ComponentWriteAcl);
+	}
+	else
+	{
+		Entity.ReadAcl.Empty();
+		Entity.ComponentWriteAcl.Empty();
+	}
+}
+
+void FLoopbackDeployment::RefreshAllEntities()
+{
+	for (TPair<Worker_EntityId_Key, FEntity>& Entity : Entities)
+	{
+		RefreshEntity(Entity.Key, Entity.Value);
+	}
+}
+
+void FLoopbackDeployment::RefreshEntity(Worker_EntityId EntityId, FEntity& Entity)
+{
+	TMap<Worker_ComponentId, uint32> NewAuthority;
+	for (const TPair<Worker_ComponentId, Worker_ComponentData>& Component : Entity.Components)
+	{
+		const WorkerRequirementSet* WriteAcl = Entity.ComponentWriteAcl.Find(Component.Key);
+		if (WriteAcl == nullptr)
+		{
+			continue;
+		}
+
+		// Keep authority where it is if possible, otherwise give it to the earliest connected worker that satisfies the ACL.
+		const uint32* CurrentWorker = Entity.Authority.Find(Component.Key);
+		if (CurrentWorker != nullptr && Workers.Contains(*CurrentWorker) && SatisfiesRequirementSet(Workers[*CurrentWorker].Attributes, *WriteAcl))
+		{
+			NewAuthority.Add(Component.Key, *CurrentWorker);
+			continue;
+		}
+
+		uint32 NewWorker = 0;
+		for (const TPair<uint32, FWorker>& Worker : Workers)
+		{
+			if ((NewWorker == 0 || Worker.Key < NewWorker) && SatisfiesRequirementSet(Worker.Value.Attributes, *WriteAcl))
+			{
+				NewWorker = Worker.Key;
+			}
+		}
+
+		if (NewWorker != 0)
+		{
+			NewAuthority.Add(Component.Key, NewWorker);
+		}
+	}
+
+	for (TPair<uint32, FWorker>& Worker : Workers)
+	{
+		const bool bWasVisible = Worker.Value.VisibleEntities.Contains(EntityId);
+		const bool bIsVisible = SatisfiesRequirementSet(Worker.Value.Attributes, Entity.ReadAcl);
+
+		if (bWasVisible && !bIsVisible)
+		{
+			RemoveEntityFromView(Worker.Value, Worker.Key, EntityId, Entity);
+			continue;
+		}
+
+		if (!bIsVisible)
+		{
+			continue;
+		}
+
+		if (!bWasVisible)
+		{
+			// The GDK expects every component of a new entity to arrive in the same critical section.
+			AddOp(Worker.Value, WORKER_OP_TYPE_CRITICAL_SECTION).critical_section.in_critical_section = 1;
+			AddOp(Worker.Value, WORKER_OP_TYPE_ADD_ENTITY).add_entity.entity_id = EntityId;
+
+			for (const TPair<Worker_ComponentId, Worker_ComponentData>& Component : Entity.Components)
+			{
+				Worker_AddComponentOp& Op = AddOp(Worker.Value, WORKER_OP_TYPE_ADD_COMPONENT).add_component;
+				Op.entity_id = EntityId;
+				Op.data = CopyComponentData(Component.Value);
+			}
+		}
+
+		for (const TPair<Worker_ComponentId, Worker_ComponentData>& Component : Entity.Components)
+		{
+			const uint32* OldWorker = bWasVisible ? Entity.Authority.Find(Component.Key) : nullptr;
+			const uint32* NewWorker = NewAuthority.Find(Component.Key);
+			const bool bWasAuthoritative = OldWorker != nullptr && *OldWorker == Worker.Key;
+			const bool bIsAuthoritative = NewWorker != nullptr && *NewWorker == Worker.Key;
+
+			if (bWasAuthoritative != bIsAuthoritative)
+			{
+				Worker_AuthorityChangeOp& Op = AddOp(Worker.Value, WORKER_OP_TYPE_AUTHORITY_CHANGE).authority_change;
+				Op.entity_id = EntityId;
+				Op.component_id = Component.Key;
+				Op.authority = bIsAuthoritative ? WORKER_AUTHORITY_AUTHORITATIVE : WORKER_AUTHORITY_NOT_AUTHORITATIVE;
+			}
+		}
+
+		if (!bWasVisible)
+		{
+			AddOp(Worker.Value, WORKER_OP_TYPE_CRITICAL_SECTION).critical_section.in_critical_section = 0;
+			Worker.Value.VisibleEntities.Add(EntityId);
+		}
+	}
+
+	Entity.Authority = MoveTemp(NewAuthority);
+}
+
+void FLoopbackDeployment::RemoveEntityFromView(FWorker& Worker, uint32 WorkerHandle, Worker_EntityId EntityId, const FEntity& Entity)
+{
+	for (const TPair<Worker_ComponentId, uint32>& Authority : Entity.Authority)
+	{
+		if (Authority.Value == WorkerHandle)
+		{
+			Worker_AuthorityChangeOp& Op = AddOp(Worker, WORKER_OP_TYPE_AUTHORITY_CHANGE).authority_change;
+			Op.entity_id = EntityId;
+			Op.component_id = Authority.Key;
+			Op.authority = WORKER_AUTHORITY_NOT_AUTHORITATIVE;
+		}
+	}
+
+	for (const TPair<Worker_ComponentId, Worker_ComponentData>& Component : Entity.Components)
+	{
+		Worker_RemoveComponentOp& Op = AddOp(Worker, WORKER_OP_TYPE_REMOVE_COMPONENT).remove_component;
+		Op.entity_id = EntityId;
+		Op.component_id = Component.Key;
+	}
+
+	AddOp(Worker, WORKER_OP_TYPE_REMOVE_ENTITY).remove_entity.entity_id = EntityId;
+
+	Worker.VisibleEntities.Remove(EntityId);
+}
+
+Worker_Op& FLoopbackDeployment::AddOp(FWorker& Worker, uint8 OpType)
+{
+	TArray<Worker_Op>& Ops = Worker.PendingOps->Ops;
+	Worker_Op& Op = Ops[Ops.AddZeroed()];
+	Op.op_type = OpType;
+	return Op;
+}
+
+const char* FLoopbackDeployment::AddString(FWorker& Worker, const FString& String)
+{
+	FTCHARToUTF8 Converted(*String);
+
+	TArray<TArray<ANSICHAR>>& Strings = Worker.PendingOps->Strings;
+	TArray<ANSICHAR>& Storage = Strings[Strings.AddDefaulted()];
+	Storage.SetNumUninitialized(Converted.Length() + 1);
+	FMemory::Memcpy(Storage.GetData(), Converted.Get(), Converted.Length());
+	Storage[Converted.Length()] = '\0';
+	return Storage.GetData();
+}
+
+FLoopbackWorkerConnection::FLoopbackWorkerConnection(const TSharedRef<FLoopbackDeployment, ESPMode::ThreadSafe>& InDeployment, uint32 InWorkerHandle, const FString& InWorkerId, const TArray<FString>& InWorkerAttributes)
+	: Deployment(InDeployment)
+	, WorkerHandle(InWorkerHandle)
+	, WorkerId(InWorkerId)
+	, WorkerAttributes(InWorkerAttributes)
+{
+}
+
+FLoopbackWorkerConnection::~FLoopbackWorkerConnection()
+{
+	Deployment->RemoveWorker(WorkerHandle);
+}
+
+TUniquePtr<FLoopbackWorkerConnection> FLoopbackWorkerConnection::Connect(const FString& WorkerType, const FString& WorkerId)
+{
+	TSharedPtr<FLoopbackDeployment, ESPMode::ThreadSafe> Deployment;
+	{
+		FScopeLock Lock(&ActiveDeploymentMutex);
+
+		Deployment = ActiveDeployment.Pin();
+		if (!Deployment.IsValid())
+		{
+			Deployment = MakeShared<FLoopbackDeployment, ESPMode::ThreadSafe>();
+
+			FString SnapshotPath;
+			if (FParse::Value(FCommandLine::Get(), TEXT("SpatialLoopbackSnapshot="), SnapshotPath))
+			{
+				Deployment->LoadSnapshot(SnapshotPath);
+			}
+
+			ActiveDeployment = Deployment;
+		}
+	}
+
+	FString UniqueWorkerId = WorkerId;
+	TArray<FString> Attributes;
+	const uint32 WorkerHandle = Deployment->AddWorker(WorkerType, UniqueWorkerId, Attributes);
+
+	return TUniquePtr<FLoopbackWorkerConnection>(new FLoopbackWorkerConnection(Deployment.ToSharedRef(), WorkerHandle, UniqueWorkerId, Attributes));
+}
+
+void FLoopbackWorkerConnection::SendMessage(FOutgoingMessage& Message)
+{
+	Deployment->HandleMessage(WorkerHandle, Message);
+}
+
+void FLoopbackWorkerConnection::SendComponentUpdate(Worker_EntityId EntityId, const Worker_ComponentUpdate& Update)
+{
+	Deployment->HandleComponentUpdate(WorkerHandle, EntityId, Update);
+	Schema_DestroyComponentUpdate(Update.schema_type);
+}
+
+TUniquePtr<FOwnedOpList> FLoopbackWorkerConnection::GetOpList()
+{
+	return Deployment->TakeOpList(WorkerHandle);
+}
+
+} // namespace SpatialGDK
@@ -0,0 +1,719 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/OpListRecording.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialOpListRecording);
+
+namespace
+{
+	const uint32 RecordingMagic = 0x4C4F5053; // "SPOL"
+	const uint32 RecordingVersion = 1;
+
+	const uint32 NullStringLength = MAX_uint32;
+
+	class FOpListWriter
+	{
+	public:
+		explicit FOpListWriter(TArray<uint8>& InBuffer)
+			: Buffer(InBuffer)
+		{}
+
+		template <typename T>
+		void Write(T Value)
+		{
+			Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+		}
+
+		void WriteString(const char* String)
+		{
+			if (String == nullptr)
+			{
+				Write<uint32>(NullStringLength);
+				return;
+			}
+
+			const uint32 Length = FCStringAnsi::Strlen(String);
+			Write<uint32>(Length);
+			Buffer.Append(reinterpret_cast<const uint8*>(String), Length);
+		}
+
+		void WriteSchemaObject(const Schema_Object* Object)
+		{
+			const uint32 Length = Schema_GetWriteBufferLength(Object);
+			Write<uint32>(Length);
+
+			const int32 Offset = Buffer.AddUninitialized(Length);
+			Schema_SerializeToBuffer(Object, Buffer.GetData() + Offset, Length);
+		}
+
+		void WriteComponentData(const Worker_ComponentData& Data)
+		{
+			Write<uint32>(Data.component_id);
+			WriteSchemaObject(Schema_GetComponentDataFields(Data.schema_type));
+		}
+
+		void WriteComponentUpdate(const Worker_ComponentUpdate& Update)
+		{
+			Write<uint32>(Update.component_id);
+			WriteSchemaObject(Schema_GetComponentUpdateFields(Update.schema_type));
+			WriteSchemaObject(Schema_GetComponentUpdateEvents(Update.schema_type));
+
+			const uint32 ClearedFieldCount = Schema_GetComponentUpdateClearedFieldCount(Update.schema_type);
+			Write<uint32>(ClearedFieldCount);
+			if (ClearedFieldCount > 0)
+			{
+				TArray<Schema_FieldId> ClearedFields;
+				ClearedFields.SetNumUninitialized(ClearedFieldCount);
+				Schema_GetComponentUpdateClearedFieldList(Update.schema_type, ClearedFields.GetData());
+				for (Schema_FieldId FieldId : ClearedFields)
+				{
+					Write<uint32>(FieldId);
+				}
+			}
+		}
+
+		void WriteOp(const Worker_Op& Op)
+		{
+			Write<uint8>(Op.op_type);
+
+			switch (Op.op_type)
+			{
+			case WORKER_OP_TYPE_DISCONNECT:
+				Write<uint8>(Op.disconnect.connection_status_code);
+				WriteString(Op.disconnect.reason);
+				break;
+			case WORKER_OP_TYPE_FLAG_UPDATE:
+				WriteString(Op.flag_update.name);
+				WriteString(Op.flag_update.value);
+				break;
+			case WORKER_OP_TYPE_LOG_MESSAGE:
+				Write<uint8>(Op.log_message.level);
+				WriteString(Op.log_message.message);
+				break;
+			case WORKER_OP_TYPE_METRICS:
+				// Metrics are not needed to replay a session, so only the op itself is recorded.
+				break;
+			case WORKER_OP_TYPE_CRITICAL_SECTION:
+				Write<uint8>(Op.critical_section.in_critical_section);
+				break;
+			case WORKER_OP_TYPE_ADD_ENTITY:
+				Write<int64>(Op.add_entity.entity_id);
+				break;
+			case WORKER_OP_TYPE_REMOVE_ENTITY:
+				Write<int64>(Op.remove_entity.entity_id);
+				break;
+			case WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE:
+				Write<int64>(Op.reserve_entity_ids_response.request_id);
+				Write<uint8>(Op.reserve_entity_ids_response.status_code);
+				WriteString(Op.reserve_entity_ids_response.message);
+				Write<int64>(Op.reserve_entity_ids_response.first_entity_id);
+				Write<uint32>(Op.reserve_entity_ids_response.number_of_entity_ids);
+				break;
+			case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
+				Write<int64>(Op.create_entity_response.request_id);
+				Write<uint8>(Op.create_entity_response.status_code);
+				WriteString(Op.create_entity_response.message);
+				Write<int64>(Op.create_entity_response.entity_id);
+				break;
+			case WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE:
+				Write<int64>(Op.delete_entity_response.request_id);
+				Write<int64>(Op.delete_entity_response.entity_id);
+				Write<uint8>(Op.delete_entity_response.status_code);
+				WriteString(Op.delete_entity_response.message);
+				break;
+			case WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE:
+			{
+				const Worker_EntityQueryResponseOp& Response = Op.entity_query_response;
+				Write<int64>(Response.request_id);
+				Write<uint8>(Response.status_code);
+				WriteString(Response.message);
+				Write<uint32>(Response.result_count);
+
+				// Count queries have a result count but no results.
+				Write<uint8>(Response.results != nullptr);
+				if (Response.results != nullptr)
+				{
+					for (uint32 i = 0; i < Response.result_count; i++)
+					{
+						const Worker_Entity& Entity = Response.results[i];
+						Write<int64>(Entity.entity_id);
+						Write<uint32>(Entity.component_count);
+						for (uint32 j = 0; j < Entity.component_count; j++)
+						{
+							WriteComponentData(Entity.components[j]);
+						}
+					}
+				}
+				break;
+			}
+			case WORKER_OP_TYPE_ADD_COMPONENT:
+				Write<int64>(Op.add_component.entity_id);
+				WriteComponentData(Op.add_component.data);
+				break;
+			case WORKER_OP_TYPE_REMOVE_COMPONENT:
+				Write<int64>(Op.remove_component.entity_id);
+				Write<uint32>(Op.remove_component.component_id);
+				break;
+			case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+				Write<int64>(Op.authority_change.entity_id);
+				Write<uint32>(Op.authority_change.component_id);
+				Write<uint8>(Op.authority_change.authority);
+				break;
+			case WORKER_OP_TYPE_COMPONENT_UPDATE:
+				Write<int64>(Op.component_update.entity_id);
+				WriteComponentUpdate(Op.component_update.update);
+				break;
+			case WORKER_OP_TYPE_COMMAND_REQUEST:
+			{
+				const Worker_CommandRequestOp& Request = Op.command_request;
+				Write<int64>(Request.request_id);
+				Write<int64>(Request.entity_id);
+				Write<uint32>(Request.timeout_millis);
+				WriteString(Request.caller_worker_id);
+				Write<uint32>(Request.caller_attribute_set.attribute_count);
+				for (uint32 i = 0; i < Request.caller_attribute_set.attribute_count; i++)
+				{
+					WriteString(Request.caller_attribute_set.attributes[i]);
+				}
+				Write<uint32>(Request.request.component_id);
+				Write<uint32>(Schema_GetCommandRequestCommandIndex(Request.request.schema_type));
+				WriteSchemaObject(Schema_GetCommandRequestObject(Request.request.schema_type));
+				break;
+			}
+			case WORKER_OP_TYPE_COMMAND_RESPONSE:
+			{
+				const Worker_CommandResponseOp& Response = Op.command_response;
+				Write<int64>(Response.request_id);
+				Write<int64>(Response.entity_id);
+				Write<uint8>(Response.status_code);
+				WriteString(Response.message);
+				Write<uint32>(Response.command_id);
+				Write<uint32>(Response.response.component_id);
+
+				// Failed commands have no response payload.
+				Write<uint8>(Response.response.schema_type != nullptr);
+				if (Response.response.schema_type != nullptr)
+				{
+					Write<uint32>(Schema_GetCommandResponseCommandIndex(Response.response.schema_type));
+					WriteSchemaObject(Schema_GetCommandResponseObject(Response.response.schema_type));
+				}
+				break;
+			}
+			default:
+				// Not used by the GDK, so only the op type is recorded.
+				break;
+			}
+		}
+
+	private:
+		TArray<uint8>& Buffer;
+	};
+
+	class FOpListReader
+	{
+	public:
+		FOpListReader(const uint8* InData, int32 InSize, int32 InOffset = 0)
+			: Data(InData)
+			, Size(InSize)
+			, Offset(InOffset)
+			, bError(false)
+		{}
+
+		bool HasError() const { return bError; }
+		int32 GetOffset() const { return Offset; }
+
+		template <typename T>
+		T Read()
+		{
+			T Value{};
+			if (!CanRead(sizeof(T)))
+			{
+				return Value;
+			}
+
+			FMemory::Memcpy(&Value, Data + Offset, sizeof(T));
+			Offset += sizeof(T);
+			return Value;
+		}
+
+		FString ReadFString()
+		{
+			const uint32 Length = Read<uint32>();
+			if (Length == NullStringLength || !CanRead(Length))
+			{
+				return FString();
+			}
+
+			FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Offset), Length);
+			Offset += Length;
+			return FString(Converted.Length(), Converted.Get());
+		}
+
+		const char* ReadString(SpatialGDK::FOwnedOpList& OpList)
+		{
+			const uint32 Length = Read<uint32>();
+			if (Length == NullStringLength || !CanRead(Length))
+			{
+				return nullptr;
+			}
+
+			TArray<ANSICHAR>& String = OpList.Strings[OpList.Strings.AddDefaulted()];
+			String.SetNumUninitialized(Length + 1);
+			FMemory::Memcpy(String.GetData(), Data + Offset, Length);
+			String[Length] = '\0';
+			Offset += Length;
+			return String.GetData();
+		}
+
+		void ReadSchemaObject(Schema_Object* Object)
+		{
+			const uint32 Length = Read<uint32>();
+			if (!CanRead(Length))
+			{
+				return;
+			}
+
+			if (Length > 0 && !Schema_MergeFromBuffer(Object, Data + Offset, Length))
+			{
+				bError = true;
+				return;
+			}
+			Offset += Length;
+		}
+
+		Worker_ComponentData ReadComponentData()
+		{
+			Worker_ComponentData ComponentData{};
+			ComponentData.component_id = Read<uint32>();
+			ComponentData.schema_type = Schema_CreateComponentData(ComponentData.component_id);
+			ReadSchemaObject(Schema_GetComponentDataFields(ComponentData.schema_type));
+			return ComponentData;
+		}
+
+		Worker_ComponentUpdate ReadComponentUpdate()
+		{
+			Worker_ComponentUpdate Update{};
+			Update.component_id = Read<uint32>();
+			Update.schema_type = Schema_CreateComponentUpdate(Update.component_id);
+			ReadSchemaObject(Schema_GetComponentUpdateFields(Update.schema_type));
+			ReadSchemaObject(Schema_GetComponentUpdateEvents(Update.schema_type));
+
+			const uint32 ClearedFieldCount = Read<uint32>();
+			for (uint32 i = 0; i < ClearedFieldCount && !bError; i++)
+			{
+				Schema_AddComponentUpdateClearedField(Update.schema_type, Read<uint32>());
+			}
+			return Update;
+		}
+
+		void ReadOp(Worker_Op& Op, SpatialGDK::FOwnedOpList& OpList)
+		{
+			Op.op_type = Read<uint8>();
+
+			switch (Op.op_type)
+			{
+			case WORKER_OP_TYPE_DISCONNECT:
+				Op.disconnect.connection_status_code = Read<uint8>();
+				Op.disconnect.reason = ReadString(OpList);
+				break;
+			case WORKER_OP_TYPE_FLAG_UPDATE:
+				Op.flag_update.name = ReadString(OpList);
+				Op.flag_update.value = ReadString(OpList);
+				break;
+			case WORKER_OP_TYPE_LOG_MESSAGE:
+				Op.log_message.level = Read<uint8>();
+				Op.log_message.message = ReadString(OpList);
+				break;
+			case WORKER_OP_TYPE_METRICS:
+				break;
+			case WORKER_OP_TYPE_CRITICAL_SECTION:
+				Op.critical_section.in_critical_section = Read<uint8>();
+				break;
+			case WORKER_OP_TYPE_ADD_ENTITY:
+				Op.add_entity.entity_id = Read<int64>();
+				break;
+			case WORKER_OP_TYPE_REMOVE_ENTITY:
+				Op.remove_entity.entity_id = Read<int64>();
+				break;
+			case WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE:
+				Op.reserve_entity_ids_response.request_id = Read<int64>();
+				Op.reserve_entity_ids_response.status_code = Read<uint8>();
+				Op.reserve_entity_ids_response.message = ReadString(OpList);
+				Op.reserve_entity_ids_response.first_entity_id = Read<int64>();
+				Op.reserve_entity_ids_response.number_of_entity_ids = Read<uint32>();
+				break;
+			case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
+				Op.create_entity_response.request_id = Read<int64>();
+				Op.create_entity_response.status_code = Read<uint8>();
+				Op.create_entity_response.message = ReadString(OpList);
+				Op.create_entity_response.entity_id = Read<int64>();
+				break;
+			case WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE:
+				Op.delete_entity_response.request_id = Read<int64>();
+				Op.delete_entity_response.entity_id = Read<int64>();
+				Op.delete_entity_response.status_code = Read<uint8>();
+				Op.delete_entity_response.message = ReadString(OpList);
+				break;
+			case WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE:
+			{
+				Worker_EntityQueryResponseOp& Response = Op.entity_query_response;
+				Response.request_id = Read<int64>();
+				Response.status_code = Read<uint8>();
+				Response.message = ReadString(OpList);
+				Response.result_count = Read<uint32>();
+				Response.results = nullptr;
+
+				if (Read<uint8>() != 0)
+				{
+					TArray<Worker_Entity>& Entities = OpList.EntityLists[OpList.EntityLists.AddDefaulted()];
+					for (uint32 i = 0; i < Response.result_count && !bError; i++)
+					{
+						Worker_Entity& Entity = Entities[Entities.AddZeroed()];
+						Entity.entity_id = Read<int64>();
+						Entity.component_count = Read<uint32>();
+
+						TArray<Worker_ComponentData>& Components = OpList.ComponentDataLists[OpList.ComponentDataLists.AddDefaulted()];
+						for (uint32 j = 0; j < Entity.component_count && !bError; j++)
+						{
+							Components.Add(ReadComponentData());
+						}
+						Entity.component_count = Components.Num();
+						Entity.components = Components.GetData();
+					}
+					Response.result_count = Entities.Num();
+					Response.results = Entities.GetData();
+				}
+				break;
+			}
+			case WORKER_OP_TYPE_ADD_COMPONENT:
+				Op.add_component.entity_id = Read<int64>();
+				Op.add_component.data = ReadComponentData();
+				break;
+			case WORKER_OP_TYPE_REMOVE_COMPONENT:
+				Op.remove_component.entity_id = Read<int64>();
+				Op.remove_component.component_id = Read<uint32>();
+				break;
+			case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+				Op.authority_change.entity_id = Read<int64>();
+				Op.authority_change.component_id = Read<uint32>();
+				Op.authority_change.authority = Read<uint8>();
+				break;
+			case WORKER_OP_TYPE_COMPONENT_UPDATE:
+				Op.component_update.entity_id = Read<int64>();
+				Op.component_update.update = ReadComponentUpdate();
+				break;
+			case WORKER_OP_TYPE_COMMAND_REQUEST:
+			{
+				Worker_CommandRequestOp& Request = Op.command_request;
+				Request.request_id = Read<int64>();
+				Request.entity_id = Read<int64>();
+				Request.timeout_millis = Read<uint32>();
+				Request.caller_worker_id = ReadString(OpList);
+
+				const uint32 AttributeCount = Read<uint32>();
+				TArray<const char*>& Attributes = OpList.StringLists[OpList.StringLists.AddDefaulted()];
+				for (uint32 i = 0; i < AttributeCount && !bError; i++)
+				{
+					Attributes.Add(ReadString(OpList));
+				}
+				Request.caller_attribute_set.attribute_count = Attributes.Num();
+				Request.caller_attribute_set.attributes = Attributes.GetData();
+
+				Request.request.component_id = Read<uint32>();
+				const Schema_FieldId CommandIndex = Read<uint32>();
+				Request.request.schema_type = Schema_CreateCommandRequest(Request.request.component_id, CommandIndex);
+				ReadSchemaObject(Schema_GetCommandRequestObject(Request.request.schema_type));
+				break;
+			}
+			case WORKER_OP_TYPE_COMMAND_RESPONSE:
+			{
+				Worker_CommandResponseOp& Response = Op.command_response;
+				Response.request_id = Read<int64>();
+				Response.entity_id = Read<int64>();
+				Response.status_code = Read<uint8>();
+				Response.message = ReadString(OpList);
+				Response.command_id = Read<uint32>();
+				Response.response.component_id = Read<uint32>();
+
+				if (Read<uint8>() != 0)
+				{
+					const Schema_FieldId CommandIndex = Read<uint32>();
+					Response.response.schema_type = Schema_CreateCommandResponse(Response.response.component_id, CommandIndex);
+					ReadSchemaObject(Schema_GetCommandResponseObject(Response.response.schema_type));
+				}
+				break;
+			}
+			default:
+				// Op types that aren't recorded have no payload.
+				break;
+			}
+		}
+
+	private:
+		bool CanRead(uint32 NumBytes)
+		{
+			if (bError || static_cast<int64>(Offset) + NumBytes > Size)
+			{
+				bError = true;
+				return false;
+			}
+			return true;
+		}
+
+		const uint8* Data;
+		int32 Size;
+		int32 Offset;
+		bool bError;
+	};
+} // anonymous namespace
+
+namespace SpatialGDK
+{
+
+FOwnedOpList::FOwnedOpList()
+{
+	ops = nullptr;
+	op_count = 0;
+}
+
+FOwnedOpList::~FOwnedOpList()
+{
+	// A recording that failed to deserialize part way through leaves the schema objects of the remaining ops unset.
+	for (const Worker_Op& Op : Ops)
+	{
+		switch (Op.op_type)
+		{
+		case WORKER_OP_TYPE_ADD_COMPONENT:
+			if (Op.add_component.data.schema_type != nullptr)
+			{
+				Schema_DestroyComponentData(Op.add_component.data.schema_type);
+			}
+			break;
+		case WORKER_OP_TYPE_COMPONENT_UPDATE:
+			if (Op.component_update.update.schema_type != nullptr)
+			{
+				Schema_DestroyComponentUpdate(Op.component_update.update.schema_type);
+			}
+			break;
+		case WORKER_OP_TYPE_COMMAND_REQUEST:
+			if (Op.command_request.request.schema_type != nullptr)
+			{
+				Schema_DestroyCommandRequest(Op.command_request.request.schema_type);
+			}
+			break;
+		case WORKER_OP_TYPE_COMMAND_RESPONSE:
+			if (Op.command_response.response.schema_type != nullptr)
+			{
+				Schema_DestroyCommandResponse(Op.command_response.response.schema_type);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Entity query results are the only component data not owned by an op directly.
+	for (const TArray<Worker_ComponentData>& ComponentDataList : ComponentDataLists)
+	{
+		for (const Worker_ComponentData& ComponentData : ComponentDataList)
+		{
+			if (ComponentData.schema_type != nullptr)
+			{
+				Schema_DestroyComponentData(ComponentData.schema_type);
+			}
+		}
+	}
+}
+
+void SerializeOpList(const Worker_OpList& OpList, TArray<uint8>& OutData)
+{
+	FOpListWriter Writer(OutData);
+
+	Writer.Write<uint32>(OpList.op_count);
+	for (uint32 i = 0; i < OpList.op_count; i++)
+	{
+		Writer.WriteOp(OpList.ops[i]);
+	}
+}
+
+TUniquePtr<FOwnedOpList> DeserializeOpList(const uint8* Data, int32 Size)
+{
+	FOpListReader Reader(Data, Size);
+
+	TUniquePtr<FOwnedOpList> OpList = MakeUnique<FOwnedOpList>();
+
+	const uint32 OpCount = Reader.Read<uint32>();
+	for (uint32 i = 0; i < OpCount && !Reader.HasError(); i++)
+	{
+		Reader.ReadOp(OpList->Ops[OpList->Ops.AddZeroed()], *OpList);
+	}
+
+	OpList->ops = OpList->Ops.GetData();
+	OpList->op_count = OpList->Ops.Num();
+
+	if (Reader.HasError())
+	{
+		UE_LOG(LogSpatialOpListRecording, Error, TEXT("Failed to deserialize op list after %d ops."), OpList->Ops.Num());
+		return nullptr;
+	}
+
+	return OpList;
+}
+
+FOpListRecorder::FOpListRecorder(FArchive* InFileWriter)
+	: FileWriter(InFileWriter)
+	, StartTime(FPlatformTime::Seconds())
+	, NumRecordedOpLists(0)
+{
+}
+
+FOpListRecorder::~FOpListRecorder()
+{
+	UE_LOG(LogSpatialOpListRecording, Log, TEXT("Recorded %d op lists."), NumRecordedOpLists);
+
+	FileWriter->Close();
+	delete FileWriter;
+}
+
+TUniquePtr<FOpListRecorder> FOpListRecorder::Create(const FString& FilePath, const FString& WorkerId, const TArray<FString>& WorkerAttributes)
+{
+	FArchive* FileWriter = IFileManager::Get().CreateFileWriter(*FilePath);
+	if (FileWriter == nullptr)
+	{
+		UE_LOG(LogSpatialOpListRecording, Error, TEXT("Failed to open %s for recording op lists."), *FilePath);
+		return nullptr;
+	}
+
+	UE_LOG(LogSpatialOpListRecording, Log, TEXT("Recording op lists to %s."), *FilePath);
+
+	TUniquePtr<FOpListRecorder> Recorder(new FOpListRecorder(FileWriter));
+
+	FOpListWriter Writer(Recorder->Buffer);
+	Writer.Write<uint32>(RecordingMagic);
+	Writer.Write<uint32>(RecordingVersion);
+	Writer.WriteString(TCHAR_TO_UTF8(*WorkerId));
+	Writer.Write<uint32>(WorkerAttributes.Num());
+	for (const FString& Attribute : WorkerAttributes)
+	{
+		Writer.WriteString(TCHAR_TO_UTF8(*Attribute));
+	}
+
+	FileWriter->Serialize(Recorder->Buffer.GetData(), Recorder->Buffer.Num());
+	Recorder->Buffer.Reset();
+
+	return Recorder;
+}
+
+void FOpListRecorder::Record(const Worker_OpList& OpList)
+{
+	// Each record is the time since recording started, followed by the size of the op list and the op list itself.
+	FOpListWriter Writer(Buffer);
+	Writer.Write<double>(FPlatformTime::Seconds() - StartTime);
+	Writer.Write<uint32>(0);
+
+	const int32 OpListOffset = Buffer.Num();
+	SerializeOpList(OpList, Buffer);
+
+	const uint32 OpListSize = Buffer.Num() - OpListOffset;
+	FMemory::Memcpy(Buffer.GetData() + OpListOffset - sizeof(uint32), &OpListSize, sizeof(uint32));
+
+	FileWriter->Serialize(Buffer.GetData(), Buffer.Num());
+	Buffer.Reset();
+
+	NumRecordedOpLists++;
+}
+
+FOpListPlayer::FOpListPlayer(bool bInMaxSpeed)
+	: Offset(0)
+	, bMaxSpeed(bInMaxSpeed)
+	, StartTime(0.0)
+	, NumPlayedOpLists(0)
+	, NumPlayedOps(0)
+{
+}
+
+TUniquePtr<FOpListPlayer> FOpListPlayer::Create(const FString& FilePath, bool bInMaxSpeed)
+{
+	TUniquePtr<FOpListPlayer> Player(new FOpListPlayer(bInMaxSpeed));
+
+	if (!FFileHelper::LoadFileToArray(Player->Data, *FilePath))
+	{
+		UE_LOG(LogSpatialOpListRecording, Error, TEXT("Failed to load op list recording %s."), *FilePath);
+		return nullptr;
+	}
+
+	FOpListReader Reader(Player->Data.GetData(), Player->Data.Num());
+	const uint32 Magic = Reader.Read<uint32>();
+	const uint32 Version = Reader.Read<uint32>();
+	if (Magic != RecordingMagic || Version != RecordingVersion)
+	{
+		UE_LOG(LogSpatialOpListRecording, Error, TEXT("%s is not an op list recording, or was recorded with an unsupported version."), *FilePath);
+		return nullptr;
+	}
+
+	Player->WorkerId = Reader.ReadFString();
+	const uint32 AttributeCount = Reader.Read<uint32>();
+	for (uint32 i = 0; i < AttributeCount && !Reader.HasError(); i++)
+	{
+		Player->WorkerAttributes.Add(Reader.ReadFString());
+	}
+
+	if (Reader.HasError())
+	{
+		UE_LOG(LogSpatialOpListRecording, Error, TEXT("Op list recording %s is corrupt."), *FilePath);
+		return nullptr;
+	}
+
+	UE_LOG(LogSpatialOpListRecording, Log, TEXT("Playing back op lists from %s recorded by worker %s%s."), *FilePath, *Player->WorkerId, bInMaxSpeed ? TEXT(" at maximum speed") : TEXT(""));
+
+	Player->Offset = Reader.GetOffset();
+	Player->StartTime = FPlatformTime::Seconds();
+
+	return Player;
+}
+
+TUniquePtr<FOwnedOpList> FOpListPlayer::GetNextOpList()
+{
+	if (IsFinished())
+	{
+		return nullptr;
+	}
+
+	FOpListReader Reader(Data.GetData(), Data.Num(), Offset);
+	const double RecordedTime = Reader.Read<double>();
+	const uint32 OpListSize = Reader.Read<uint32>();
+
+	if (Reader.HasError() || Reader.GetOffset() + static_cast<int64>(OpListSize) > Data.Num())
+	{
+		UE_LOG(LogSpatialOpListRecording, Error, TEXT("Op list recording is truncated, stopping playback."));
+		Offset = Data.Num();
+		return nullptr;
+	}
+
+	if (!bMaxSpeed && FPlatformTime::Seconds() - StartTime < RecordedTime)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FOwnedOpList> OpList = DeserializeOpList(Data.GetData() + Reader.GetOffset(), OpListSize);
+	Offset = Reader.GetOffset() + OpListSize;
+
+	if (OpList.IsValid())
+	{
+		NumPlayedOpLists++;
+		NumPlayedOps += OpList->op_count;
+	}
+
+	if (IsFinished())
+	{
+		UE_LOG(LogSpatialOpListRecording, Log, TEXT("Finished playing back %d op lists (%lld ops) in %.3f seconds."), NumPlayedOpLists, NumPlayedOps, FPlatformTime::Seconds() - StartTime);
+	}
+
+	return OpList;
+}
+
+} // namespace SpatialGDK
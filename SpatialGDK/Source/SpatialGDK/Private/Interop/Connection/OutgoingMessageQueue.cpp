@@ -0,0 +1,132 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/OutgoingMessageQueue.h"
+
+namespace SpatialGDK
+{
+
+FOutgoingMessageQueue::FOutgoingMessageQueue()
+	: PendingBlock(nullptr)
+	, PendingIndex(0)
+	, NumQueued(0)
+	, NumBlocks(1)
+{
+	FBlock* InitialBlock = new FBlock();
+	InitialBlock->Next.store(InitialBlock, std::memory_order_relaxed);
+
+	FrontBlock.store(InitialBlock, std::memory_order_relaxed);
+	TailBlock.store(InitialBlock, std::memory_order_relaxed);
+}
+
+FOutgoingMessageQueue::~FOutgoingMessageQueue()
+{
+	while (Peek() != nullptr)
+	{
+		Pop();
+	}
+
+	FBlock* FirstBlock = FrontBlock.load(std::memory_order_relaxed);
+	FBlock* Block = FirstBlock;
+	do
+	{
+		FBlock* NextBlock = Block->Next.load(std::memory_order_relaxed);
+		delete Block;
+		Block = NextBlock;
+	} while (Block != FirstBlock);
+}
+
+void* FOutgoingMessageQueue::AllocateSlot()
+{
+	FBlock* Block = TailBlock.load(std::memory_order_relaxed);
+	const uint32 Tail = Block->Tail.load(std::memory_order_relaxed);
+
+	// Room left in the current block.
+	if (((Tail + 1) & BlockMask) != Block->Front.load(std::memory_order_acquire))
+	{
+		PendingBlock = Block;
+		PendingIndex = Tail;
+		return Block->GetSlot(Tail);
+	}
+
+	// The next block in the ring has been drained by the consumer and can be reused.
+	FBlock* NextBlock = Block->Next.load(std::memory_order_relaxed);
+	if (NextBlock != FrontBlock.load(std::memory_order_acquire))
+	{
+		const uint32 NextTail = NextBlock->Tail.load(std::memory_order_relaxed);
+		check(NextTail == NextBlock->Front.load(std::memory_order_relaxed));
+
+		PendingBlock = NextBlock;
+		PendingIndex = NextTail;
+		return NextBlock->GetSlot(NextTail);
+	}
+
+	// The consumer is still reading the next block, so grow the ring. The consumer can't follow Block->Next
+	// until TailBlock moves past Block, which only happens in PublishSlot.
+	FBlock* NewBlock = new FBlock();
+	NewBlock->Next.store(NextBlock, std::memory_order_relaxed);
+	Block->Next.store(NewBlock, std::memory_order_relaxed);
+	NumBlocks.fetch_add(1, std::memory_order_relaxed);
+
+	PendingBlock = NewBlock;
+	PendingIndex = 0;
+	return NewBlock->GetSlot(0);
+}
+
+void FOutgoingMessageQueue::PublishSlot()
+{
+	check(PendingBlock != nullptr);
+
+	PendingBlock->Tail.store((PendingIndex + 1) & BlockMask, std::memory_order_release);
+	if (PendingBlock != TailBlock.load(std::memory_order_relaxed))
+	{
+		TailBlock.store(PendingBlock, std::memory_order_release);
+	}
+	PendingBlock = nullptr;
+
+	NumQueued.fetch_add(1, std::memory_order_relaxed);
+}
+
+FOutgoingMessage* FOutgoingMessageQueue::Peek()
+{
+	FBlock* Block = FrontBlock.load(std::memory_order_relaxed);
+	const uint32 Front = Block->Front.load(std::memory_order_relaxed);
+
+	if (Front != Block->Tail.load(std::memory_order_acquire))
+	{
+		return static_cast<FOutgoingMessage*>(Block->GetSlot(Front));
+	}
+
+	if (Block == TailBlock.load(std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+
+	// The producer has moved on from this block, but may have published more messages into it before doing so.
+	if (Front != Block->Tail.load(std::memory_order_acquire))
+	{
+		return static_cast<FOutgoingMessage*>(Block->GetSlot(Front));
+	}
+
+	// This block is drained, move on to the next one. It must contain at least one message,
+	// since the producer only moves TailBlock after publishing into the new block.
+	FBlock* NextBlock = Block->Next.load(std::memory_order_relaxed);
+	FrontBlock.store(NextBlock, std::memory_order_release);
+
+	const uint32 NextFront = NextBlock->Front.load(std::memory_order_relaxed);
+	check(NextFront != NextBlock->Tail.load(std::memory_order_acquire));
+	return static_cast<FOutgoingMessage*>(NextBlock->GetSlot(NextFront));
+}
+
+void FOutgoingMessageQueue::Pop()
+{
+	FBlock* Block = FrontBlock.load(std::memory_order_relaxed);
+	const uint32 Front = Block->Front.load(std::memory_order_relaxed);
+	check(Front != Block->Tail.load(std::memory_order_relaxed));
+
+	static_cast<FOutgoingMessage*>(Block->GetSlot(Front))->~FOutgoingMessage();
+
+	Block->Front.store((Front + 1) & BlockMask, std::memory_order_release);
+	NumQueued.fetch_sub(1, std::memory_order_relaxed);
+}
+
+} // namespace SpatialGDK
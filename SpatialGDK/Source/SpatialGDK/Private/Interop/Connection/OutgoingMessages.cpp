@@ -2,9 +2,123 @@
 
 #include "Interop/Connection/OutgoingMessages.h"
 
+#include <WorkerSDK/improbable/c_schema.h>
+
 namespace SpatialGDK
 {
 
+FName GetOutgoingMessageTypeName(EOutgoingMessageType Type)
+{
+	static const FName Names[NumOutgoingMessageTypes] =
+	{
+		TEXT("ReserveEntityIdsRequest"),
+		TEXT("CreateEntityRequest"),
+		TEXT("DeleteEntityRequest"),
+		TEXT("AddComponent"),
+		TEXT("RemoveComponent"),
+		TEXT("ComponentUpdate"),
+		TEXT("CommandRequest"),
+		TEXT("CommandResponse"),
+		TEXT("CommandFailure"),
+		TEXT("LogMessage"),
+		TEXT("ComponentInterest"),
+		TEXT("EntityQueryRequest"),
+		TEXT("Metrics")
+	};
+
+	return Names[static_cast<int32>(Type)];
+}
+
+EOutgoingMessagePriority GetOutgoingMessagePriority(EOutgoingMessageType Type)
+{
+	switch (Type)
+	{
+	case EOutgoingMessageType::ReserveEntityIdsRequest:
+		return TOutgoingMessagePriority<FReserveEntityIdsRequest>::Value;
+	case EOutgoingMessageType::EntityQueryRequest:
+		return TOutgoingMessagePriority<FEntityQueryRequest>::Value;
+	case EOutgoingMessageType::LogMessage:
+		return TOutgoingMessagePriority<FLogMessage>::Value;
+	case EOutgoingMessageType::Metrics:
+		return TOutgoingMessagePriority<FMetrics>::Value;
+	default:
+		return EOutgoingMessagePriority::Critical;
+	}
+}
+
+void DestroyOutgoingMessageSchemaObjects(FOutgoingMessage& Message)
+{
+	switch (Message.Type)
+	{
+	case EOutgoingMessageType::CreateEntityRequest:
+		for (Worker_ComponentData& Component : static_cast<FCreateEntityRequest&>(Message).Components)
+		{
+			Schema_DestroyComponentData(Component.schema_type);
+		}
+		break;
+	case EOutgoingMessageType::AddComponent:
+		Schema_DestroyComponentData(static_cast<FAddComponent&>(Message).Data.schema_type);
+		break;
+	case EOutgoingMessageType::ComponentUpdate:
+		Schema_DestroyComponentUpdate(static_cast<FComponentUpdate&>(Message).Update.schema_type);
+		break;
+	case EOutgoingMessageType::CommandRequest:
+		Schema_DestroyCommandRequest(static_cast<FCommandRequest&>(Message).Request.schema_type);
+		break;
+	case EOutgoingMessageType::CommandResponse:
+		Schema_DestroyCommandResponse(static_cast<FCommandResponse&>(Message).Response.schema_type);
+		break;
+	default:
+		break;
+	}
+}
+
+uint32 GetOutgoingMessageSize(const FOutgoingMessage& Message)
+{
+	switch (Message.Type)
+	{
+	case EOutgoingMessageType::CreateEntityRequest:
+	{
+		uint32 Size = sizeof(Worker_EntityId);
+		for (const Worker_ComponentData& Component : static_cast<const FCreateEntityRequest&>(Message).Components)
+		{
+			Size += sizeof(Worker_ComponentId) + Schema_GetWriteBufferLength(Schema_GetComponentDataFields(Component.schema_type));
+		}
+		return Size;
+	}
+	case EOutgoingMessageType::AddComponent:
+	{
+		const FAddComponent& AddComponent = static_cast<const FAddComponent&>(Message);
+		return sizeof(Worker_EntityId) + sizeof(Worker_ComponentId) + Schema_GetWriteBufferLength(Schema_GetComponentDataFields(AddComponent.Data.schema_type));
+	}
+	case EOutgoingMessageType::ComponentUpdate:
+	{
+		const FComponentUpdate& ComponentUpdate = static_cast<const FComponentUpdate&>(Message);
+		return sizeof(Worker_EntityId) + sizeof(Worker_ComponentId)
+			+ Schema_GetWriteBufferLength(Schema_GetComponentUpdateFields(ComponentUpdate.Update.schema_type))
+			+ Schema_GetWriteBufferLength(Schema_GetComponentUpdateEvents(ComponentUpdate.Update.schema_type));
+	}
+	case EOutgoingMessageType::CommandRequest:
+	{
+		const FCommandRequest& CommandRequest = static_cast<const FCommandRequest&>(Message);
+		return sizeof(Worker_EntityId) + sizeof(Worker_ComponentId) + Schema_GetWriteBufferLength(Schema_GetCommandRequestObject(CommandRequest.Request.schema_type));
+	}
+	case EOutgoingMessageType::CommandResponse:
+	{
+		const FCommandResponse& CommandResponse = static_cast<const FCommandResponse&>(Message);
+		return sizeof(Worker_RequestId) + Schema_GetWriteBufferLength(Schema_GetCommandResponseObject(CommandResponse.Response.schema_type));
+	}
+	case EOutgoingMessageType::CommandFailure:
+		return sizeof(Worker_RequestId) + static_cast<const FCommandFailure&>(Message).Message.Len();
+	case EOutgoingMessageType::LogMessage:
+		return static_cast<const FLogMessage&>(Message).Message.Len();
+	case EOutgoingMessageType::ComponentInterest:
+		return sizeof(Worker_EntityId) + static_cast<const FComponentInterest&>(Message).Interests.Num() * sizeof(Worker_InterestOverride);
+	default:
+		return sizeof(Worker_EntityId);
+	}
+}
+
 void FEntityQueryRequest::TraverseConstraint(Worker_Constraint* Constraint)
 {
 	switch (Constraint->constraint_type)
@@ -17,6 +17,7 @@
 #include "EngineClasses/SpatialNetDriver.h"
 #include "SpatialGDKSettings.h"
 #include "Utils/ErrorCodeRemapping.h"
+#include "Utils/SpatialTraceRecorder.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialWorkerConnection);
 
@@ -43,6 +44,12 @@ void USpatialWorkerConnection::DestroyConnection()
 		OpsProcessingThread = nullptr;
 	}
 
+	if (OpsProcessingThreadWakeEvent != nullptr)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(OpsProcessingThreadWakeEvent);
+		OpsProcessingThreadWakeEvent = nullptr;
+	}
+
 	if (WorkerConnection)
 	{
 		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WorkerConnection = WorkerConnection]
@@ -63,6 +70,17 @@ void USpatialWorkerConnection::DestroyConnection()
 		WorkerLocator = nullptr;
 	}
 
+	Worker_OpList* OpList;
+	while (OpListQueue.Dequeue(OpList))
+	{
+		DestroyOpList(OpList);
+	}
+
+	OpListRecorder.Reset();
+	OpListPlayer.Reset();
+	LoopbackConnection.Reset();
+	SentRequestIdRemapping.Empty();
+
 	bIsConnected = false;
 	NextRequestId = 0;
 	KeepRunning.AtomicSet(true);
@@ -85,6 +103,19 @@ void USpatialWorkerConnection::Connect(bool bInitAsClient)
 		return;
 	}
 
+	FString OpListPlaybackPath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("SpatialPlaybackOps="), OpListPlaybackPath))
+	{
+		ConnectToOpListPlayback(OpListPlaybackPath);
+		return;
+	}
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("SpatialLoopback")))
+	{
+		ConnectToLoopback(bInitAsClient);
+		return;
+	}
+
 	switch (GetConnectionType())
 	{
 	case SpatialConnectionType::Receptionist:
@@ -308,6 +339,31 @@ void USpatialWorkerConnection::FinishConnecting(Worker_ConnectionFuture* Connect
 	});
 }
 
+void USpatialWorkerConnection::ConnectToOpListPlayback(const FString& FilePath)
+{
+	OpListPlayer = FOpListPlayer::Create(FilePath, FParse::Param(FCommandLine::Get(), TEXT("SpatialPlaybackOpsMaxSpeed")));
+	if (!OpListPlayer.IsValid())
+	{
+		OnPreConnectionFailure(FString::Printf(TEXT("Failed to load op list recording %s"), *FilePath));
+		return;
+	}
+
+	CachedWorkerAttributes = OpListPlayer->GetWorkerAttributes();
+	OnConnectionSuccess();
+}
+
+void USpatialWorkerConnection::ConnectToLoopback(bool bConnectAsClient)
+{
+	if (ReceptionistConfig.WorkerType.IsEmpty())
+	{
+		ReceptionistConfig.WorkerType = bConnectAsClient ? SpatialConstants::DefaultClientWorkerType.ToString() : SpatialConstants::DefaultServerWorkerType.ToString();
+	}
+
+	LoopbackConnection = FLoopbackWorkerConnection::Connect(ReceptionistConfig.WorkerType, ReceptionistConfig.WorkerId);
+	CachedWorkerAttributes = LoopbackConnection->GetWorkerAttributes();
+	OnConnectionSuccess();
+}
+
 SpatialConnectionType USpatialWorkerConnection::GetConnectionType() const
 {
 	if (!LocatorConfig.PlayerIdentityToken.IsEmpty())
@@ -333,22 +389,42 @@ TArray<Worker_OpList*> USpatialWorkerConnection::GetOpList()
 	return OpLists;
 }
 
+void USpatialWorkerConnection::DestroyOpList(Worker_OpList* OpList)
+{
+	if (bPredecodeComponentUpdates)
+	{
+		ComponentUpdatePredecoder.ReleaseOpList(OpList);
+	}
+
+	if (OpListPlayer.IsValid() || LoopbackConnection.IsValid())
+	{
+		delete static_cast<FOwnedOpList*>(OpList);
+	}
+	else
+	{
+		Worker_OpList_Destroy(OpList);
+	}
+}
+
 Worker_RequestId USpatialWorkerConnection::SendReserveEntityIdsRequest(uint32_t NumOfEntities)
 {
-	QueueOutgoingMessage<FReserveEntityIdsRequest>(NumOfEntities);
-	return NextRequestId++;
+	const Worker_RequestId RequestId = NextRequestId++;
+	QueueOutgoingMessage<FReserveEntityIdsRequest>(RequestId, NumOfEntities);
+	return RequestId;
 }
 
 Worker_RequestId USpatialWorkerConnection::SendCreateEntityRequest(TArray<Worker_ComponentData>&& Components, const Worker_EntityId* EntityId)
 {
-	QueueOutgoingMessage<FCreateEntityRequest>(MoveTemp(Components), EntityId);
-	return NextRequestId++;
+	const Worker_RequestId RequestId = NextRequestId++;
+	QueueOutgoingMessage<FCreateEntityRequest>(RequestId, MoveTemp(Components), EntityId);
+	return RequestId;
 }
 
 Worker_RequestId USpatialWorkerConnection::SendDeleteEntityRequest(Worker_EntityId EntityId)
 {
-	QueueOutgoingMessage<FDeleteEntityRequest>(EntityId);
-	return NextRequestId++;
+	const Worker_RequestId RequestId = NextRequestId++;
+	QueueOutgoingMessage<FDeleteEntityRequest>(RequestId, EntityId);
+	return RequestId;
 }
 
 void USpatialWorkerConnection::SendAddComponent(Worker_EntityId EntityId, Worker_ComponentData* ComponentData)
@@ -368,8 +444,9 @@ void USpatialWorkerConnection::SendComponentUpdate(Worker_EntityId EntityId, con
 
 Worker_RequestId USpatialWorkerConnection::SendCommandRequest(Worker_EntityId EntityId, const Worker_CommandRequest* Request, uint32_t CommandId)
 {
-	QueueOutgoingMessage<FCommandRequest>(EntityId, *Request, CommandId);
-	return NextRequestId++;
+	const Worker_RequestId RequestId = NextRequestId++;
+	QueueOutgoingMessage<FCommandRequest>(RequestId, EntityId, *Request, CommandId);
+	return RequestId;
 }
 
 void USpatialWorkerConnection::SendCommandResponse(Worker_RequestId RequestId, const Worker_CommandResponse* Response)
@@ -387,6 +464,11 @@ void USpatialWorkerConnection::SendLogMessage(const uint8_t Level, const FName&
 	QueueOutgoingMessage<FLogMessage>(Level, LoggerName, Message);
 }
 
+void USpatialWorkerConnection::SendLogMessage(const uint8_t Level, const FName& LoggerName, FString&& Message)
+{
+	QueueOutgoingMessage<FLogMessage>(Level, LoggerName, MoveTemp(Message));
+}
+
 void USpatialWorkerConnection::SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride>&& ComponentInterest)
 {
 	QueueOutgoingMessage<FComponentInterest>(EntityId, MoveTemp(ComponentInterest));
@@ -394,8 +476,9 @@ void USpatialWorkerConnection::SendComponentInterest(Worker_EntityId EntityId, T
 
 Worker_RequestId USpatialWorkerConnection::SendEntityQueryRequest(const Worker_EntityQuery* EntityQuery)
 {
-	QueueOutgoingMessage<FEntityQueryRequest>(*EntityQuery);
-	return NextRequestId++;
+	const Worker_RequestId RequestId = NextRequestId++;
+	QueueOutgoingMessage<FEntityQueryRequest>(RequestId, *EntityQuery);
+	return RequestId;
 }
 
 void USpatialWorkerConnection::SendMetrics(const SpatialMetrics& Metrics)
@@ -405,6 +488,16 @@ void USpatialWorkerConnection::SendMetrics(const SpatialMetrics& Metrics)
 
 FString USpatialWorkerConnection::GetWorkerId() const
 {
+	if (OpListPlayer.IsValid())
+	{
+		return OpListPlayer->GetWorkerId();
+	}
+
+	if (LoopbackConnection.IsValid())
+	{
+		return LoopbackConnection->GetWorkerId();
+	}
+
 	return FString(UTF8_TO_TCHAR(Worker_Connection_GetWorkerId(WorkerConnection)));
 }
 
@@ -413,6 +506,26 @@ const TArray<FString>& USpatialWorkerConnection::GetWorkerAttributes() const
 	return CachedWorkerAttributes;
 }
 
+int32 USpatialWorkerConnection::GetOutgoingMessageQueueDepth() const
+{
+	int32 Depth = 0;
+	for (const FOutgoingMessageQueue& Queue : OutgoingMessagesQueues)
+	{
+		Depth += Queue.Num();
+	}
+	return Depth;
+}
+
+int32 USpatialWorkerConnection::GetOutgoingMessageQueueHighWaterMark() const
+{
+	return OutgoingMessageQueueHighWaterMark.load(std::memory_order_relaxed);
+}
+
+void USpatialWorkerConnection::ResetOutgoingMessageQueueHighWaterMark()
+{
+	OutgoingMessageQueueHighWaterMark.store(GetOutgoingMessageQueueDepth(), std::memory_order_relaxed);
+}
+
 void USpatialWorkerConnection::CacheWorkerAttributes()
 {
 	const Worker_WorkerAttributes* Attributes = Worker_Connection_GetWorkerAttributes(WorkerConnection);
@@ -489,9 +602,24 @@ uint32 USpatialWorkerConnection::Run()
 {
 	while (KeepRunning)
 	{
-		FPlatformProcess::Sleep(OpsUpdateInterval);
+		ResetOutgoingMessageBudgets();
 
-		QueueLatestOpList();
+		if (bEventDrivenOpsUpdate)
+		{
+			// Wait until the game thread has something to send, then block for incoming ops instead of sleeping.
+			// Messages queued while blocked re-trigger the event, so they are picked up straight after.
+			OpsProcessingThreadWakeEvent->Wait(EventDrivenMaxIdleTimeMs);
+
+			ProcessOutgoingMessages();
+
+			QueueLatestOpList(EventDrivenOpListTimeoutMs);
+		}
+		else
+		{
+			FPlatformProcess::Sleep(OpsUpdateInterval);
+
+			QueueLatestOpList(0);
+		}
 
 		ProcessOutgoingMessages();
 	}
@@ -502,22 +630,114 @@ uint32 USpatialWorkerConnection::Run()
 void USpatialWorkerConnection::Stop()
 {
 	KeepRunning.AtomicSet(false);
+
+	if (OpsProcessingThreadWakeEvent != nullptr)
+	{
+		OpsProcessingThreadWakeEvent->Trigger();
+	}
+}
+
+void USpatialWorkerConnection::WakeOpsProcessingThread()
+{
+	if (bEventDrivenOpsUpdate && OpsProcessingThreadWakeEvent != nullptr)
+	{
+		OpsProcessingThreadWakeEvent->Trigger();
+	}
 }
 
 void USpatialWorkerConnection::InitializeOpsProcessingThread()
 {
 	check(IsInGameThread());
 
+	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
+	bEventDrivenOpsUpdate = SpatialGDKSettings->bEventDrivenOpsUpdate;
+	EventDrivenMaxIdleTimeMs = static_cast<uint32>(FMath::Max(SpatialGDKSettings->EventDrivenOpsUpdateMaxIdleTime, 0.0f) * 1000.0f);
+	EventDrivenOpListTimeoutMs = SpatialGDKSettings->EventDrivenOpListTimeoutMs;
+	bCoalesceComponentUpdates = SpatialGDKSettings->bCoalesceOutgoingComponentUpdates;
+	bPredecodeComponentUpdates = SpatialGDKSettings->bPredecodeComponentUpdates;
+
+	bUseOutgoingMessageBudgets = false;
+	for (int32 TypeIndex = 0; TypeIndex < NumOutgoingMessageTypes; TypeIndex++)
+	{
+		const EOutgoingMessageType Type = static_cast<EOutgoingMessageType>(TypeIndex);
+		const FName TypeName = GetOutgoingMessageTypeName(Type);
+		const FOutgoingMessageBudget* Budget = SpatialGDKSettings->OutgoingMessageBudgets.Find(TypeName);
+
+		// A Critical message over budget would hold back every other entity and component change queued after it.
+		if (Budget != nullptr && GetOutgoingMessagePriority(Type) == EOutgoingMessagePriority::Critical)
+		{
+			UE_LOG(LogSpatialWorkerConnection, Warning, TEXT("Outgoing message budget set for %s, which changes entity state and can't be held back. It will be ignored."), *TypeName.ToString());
+			Budget = nullptr;
+		}
+
+		OutgoingMessageBudgets[TypeIndex] = Budget != nullptr ? *Budget : FOutgoingMessageBudget();
+		bUseOutgoingMessageBudgets |= Budget != nullptr && (Budget->MaxMessagesPerUpdate > 0 || Budget->MaxBytesPerUpdate > 0);
+	}
+
+	for (const TPair<FName, FOutgoingMessageBudget>& Budget : SpatialGDKSettings->OutgoingMessageBudgets)
+	{
+		bool bIsKnownType = false;
+		for (int32 TypeIndex = 0; TypeIndex < NumOutgoingMessageTypes && !bIsKnownType; TypeIndex++)
+		{
+			bIsKnownType = GetOutgoingMessageTypeName(static_cast<EOutgoingMessageType>(TypeIndex)) == Budget.Key;
+		}
+
+		if (!bIsKnownType)
+		{
+			UE_LOG(LogSpatialWorkerConnection, Warning, TEXT("Outgoing message budget set for unknown message type %s, it will be ignored."), *Budget.Key.ToString());
+		}
+	}
+
+	FString OpListRecordingPath;
+	if (!OpListPlayer.IsValid() && FParse::Value(FCommandLine::Get(), TEXT("SpatialRecordOps="), OpListRecordingPath))
+	{
+		// Several workers can share a command line in PIE, so the worker ID can be added to the path.
+		const FString WorkerId = GetWorkerId();
+		OpListRecorder = FOpListRecorder::Create(OpListRecordingPath.Replace(TEXT("{WorkerId}"), *WorkerId), WorkerId, CachedWorkerAttributes);
+	}
+
+	if (OpsProcessingThreadWakeEvent == nullptr)
+	{
+		OpsProcessingThreadWakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	}
+
 	OpsProcessingThread = FRunnableThread::Create(this, TEXT("SpatialWorkerConnectionWorker"), 0);
 	check(OpsProcessingThread);
 }
 
-void USpatialWorkerConnection::QueueLatestOpList()
+void USpatialWorkerConnection::QueueLatestOpList(uint32 TimeoutMillis)
 {
-	Worker_OpList* OpList = Worker_Connection_GetOpList(WorkerConnection, 0);
+	if (OpListPlayer.IsValid())
+	{
+		QueuePlaybackOpLists();
+		return;
+	}
+
+	if (LoopbackConnection.IsValid())
+	{
+		if (TUniquePtr<FOwnedOpList> OpList = LoopbackConnection->GetOpList())
+		{
+			if (OpListRecorder.IsValid())
+			{
+				OpListRecorder->Record(*OpList);
+			}
+
+			EnqueueOpList(OpList.Release());
+		}
+		return;
+	}
+
+	Worker_OpList* OpList = Worker_Connection_GetOpList(WorkerConnection, TimeoutMillis);
 	if (OpList->op_count > 0)
 	{
-		OpListQueue.Enqueue(OpList);
+		RemapResponseRequestIds(*OpList);
+
+		if (OpListRecorder.IsValid())
+		{
+			OpListRecorder->Record(*OpList);
+		}
+
+		EnqueueOpList(OpList);
 	}
 	else
 	{
@@ -525,47 +745,161 @@ void USpatialWorkerConnection::QueueLatestOpList()
 	}
 }
 
+void USpatialWorkerConnection::EnqueueOpList(Worker_OpList* OpList)
+{
+	if (bPredecodeComponentUpdates)
+	{
+		ComponentUpdatePredecoder.PredecodeOpList(*OpList);
+	}
+
+	OpListQueue.Enqueue(OpList);
+}
+
+void USpatialWorkerConnection::TrackSentRequestId(Worker_RequestId RequestId, Worker_RequestId SentRequestId)
+{
+	// Requests in different priority classes can be sent in a different order to the one they were queued in.
+	if (SentRequestId != RequestId)
+	{
+		SentRequestIdRemapping.Add(SentRequestId, RequestId);
+	}
+}
+
+void USpatialWorkerConnection::RemapResponseRequestIds(Worker_OpList& OpList)
+{
+	if (SentRequestIdRemapping.Num() == 0)
+	{
+		return;
+	}
+
+	for (uint32 i = 0; i < OpList.op_count; i++)
+	{
+		Worker_Op& Op = OpList.ops[i];
+
+		Worker_RequestId* RequestId = nullptr;
+		switch (Op.op_type)
+		{
+		case WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE:
+			RequestId = &Op.reserve_entity_ids_response.request_id;
+			break;
+		case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
+			RequestId = &Op.create_entity_response.request_id;
+			break;
+		case WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE:
+			RequestId = &Op.delete_entity_response.request_id;
+			break;
+		case WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE:
+			RequestId = &Op.entity_query_response.request_id;
+			break;
+		case WORKER_OP_TYPE_COMMAND_RESPONSE:
+			RequestId = &Op.command_response.request_id;
+			break;
+		default:
+			break;
+		}
+
+		Worker_RequestId QueuedRequestId;
+		if (RequestId != nullptr && SentRequestIdRemapping.RemoveAndCopyValue(*RequestId, QueuedRequestId))
+		{
+			*RequestId = QueuedRequestId;
+		}
+	}
+}
+
+void USpatialWorkerConnection::QueuePlaybackOpLists()
+{
+	if (OpListPlayer->IsMaxSpeed())
+	{
+		// Only queue the next op list once the game thread has taken the previous one, so playback is paced by op processing.
+		if (OpListQueue.IsEmpty())
+		{
+			if (TUniquePtr<FOwnedOpList> OpList = OpListPlayer->GetNextOpList())
+			{
+				EnqueueOpList(OpList.Release());
+			}
+		}
+		return;
+	}
+
+	while (TUniquePtr<FOwnedOpList> OpList = OpListPlayer->GetNextOpList())
+	{
+		EnqueueOpList(OpList.Release());
+	}
+}
+
 void USpatialWorkerConnection::ProcessOutgoingMessages()
 {
-	while (!OutgoingMessagesQueue.IsEmpty())
+	SPATIAL_TRACE_SCOPE(TEXT("ProcessOutgoingMessages"), TEXT("Connection"));
+
+	int32 Priority = 0;
+	int32 NumDeferred = 0;
+	while (FOutgoingMessage* OutgoingMessage = PeekOutgoingMessage(Priority, NumDeferred))
 	{
-		TUniquePtr<FOutgoingMessage> OutgoingMessage;
-		OutgoingMessagesQueue.Dequeue(OutgoingMessage);
+		if (OpListPlayer.IsValid())
+		{
+			// There is no connection to send to during playback.
+			DestroyOutgoingMessageSchemaObjects(*OutgoingMessage);
+			OutgoingMessagesQueues[Priority].Pop();
+			continue;
+		}
+
+		if (bCoalesceComponentUpdates)
+		{
+			if (OutgoingMessage->Type == EOutgoingMessageType::ComponentUpdate && CoalesceComponentUpdate(*static_cast<FComponentUpdate*>(OutgoingMessage)))
+			{
+				SendLatencyHistogram.Record(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - OutgoingMessage->EnqueueCycles));
+
+				OutgoingMessagesQueues[Priority].Pop();
+				continue;
+			}
+
+			// The pending update was queued before this message, so it has to go out first.
+			SendPendingComponentUpdate();
+		}
+
+		if (LoopbackConnection.IsValid())
+		{
+			LoopbackConnection->SendMessage(*OutgoingMessage);
+
+			SendLatencyHistogram.Record(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - OutgoingMessage->EnqueueCycles));
+
+			OutgoingMessagesQueues[Priority].Pop();
+			continue;
+		}
 
 		switch (OutgoingMessage->Type)
 		{
 		case EOutgoingMessageType::ReserveEntityIdsRequest:
 		{
-			FReserveEntityIdsRequest* Message = static_cast<FReserveEntityIdsRequest*>(OutgoingMessage.Get());
+			FReserveEntityIdsRequest* Message = static_cast<FReserveEntityIdsRequest*>(OutgoingMessage);
 
-			Worker_Connection_SendReserveEntityIdsRequest(WorkerConnection,
+			TrackSentRequestId(Message->RequestId, Worker_Connection_SendReserveEntityIdsRequest(WorkerConnection,
 				Message->NumOfEntities,
-				nullptr);
+				nullptr));
 			break;
 		}
 		case EOutgoingMessageType::CreateEntityRequest:
 		{
-			FCreateEntityRequest* Message = static_cast<FCreateEntityRequest*>(OutgoingMessage.Get());
+			FCreateEntityRequest* Message = static_cast<FCreateEntityRequest*>(OutgoingMessage);
 
-			Worker_Connection_SendCreateEntityRequest(WorkerConnection,
+			TrackSentRequestId(Message->RequestId, Worker_Connection_SendCreateEntityRequest(WorkerConnection,
 				Message->Components.Num(),
 				Message->Components.GetData(),
 				Message->EntityId.IsSet() ? &(Message->EntityId.GetValue()) : nullptr,
-				nullptr);
+				nullptr));
 			break;
 		}
 		case EOutgoingMessageType::DeleteEntityRequest:
 		{
-			FDeleteEntityRequest* Message = static_cast<FDeleteEntityRequest*>(OutgoingMessage.Get());
+			FDeleteEntityRequest* Message = static_cast<FDeleteEntityRequest*>(OutgoingMessage);
 
-			Worker_Connection_SendDeleteEntityRequest(WorkerConnection,
+			TrackSentRequestId(Message->RequestId, Worker_Connection_SendDeleteEntityRequest(WorkerConnection,
 				Message->EntityId,
-				nullptr);
+				nullptr));
 			break;
 		}
 		case EOutgoingMessageType::AddComponent:
 		{
-			FAddComponent* Message = static_cast<FAddComponent*>(OutgoingMessage.Get());
+			FAddComponent* Message = static_cast<FAddComponent*>(OutgoingMessage);
 
 			static const Worker_UpdateParameters DisableLoopback{ false /* loopback */ };
 			Worker_Connection_SendAddComponent(WorkerConnection,
@@ -576,7 +910,7 @@ void USpatialWorkerConnection::ProcessOutgoingMessages()
 		}
 		case EOutgoingMessageType::RemoveComponent:
 		{
-			FRemoveComponent* Message = static_cast<FRemoveComponent*>(OutgoingMessage.Get());
+			FRemoveComponent* Message = static_cast<FRemoveComponent*>(OutgoingMessage);
 
 			static const Worker_UpdateParameters DisableLoopback{ false /* loopback */ };
 			Worker_Connection_SendRemoveComponent(WorkerConnection,
@@ -587,7 +921,7 @@ void USpatialWorkerConnection::ProcessOutgoingMessages()
 		}
 		case EOutgoingMessageType::ComponentUpdate:
 		{
-			FComponentUpdate* Message = static_cast<FComponentUpdate*>(OutgoingMessage.Get());
+			FComponentUpdate* Message = static_cast<FComponentUpdate*>(OutgoingMessage);
 
 			static const Worker_UpdateParameters DisableLoopback{ false /* loopback */ };
 			Worker_Alpha_Connection_SendComponentUpdate(WorkerConnection,
@@ -598,20 +932,20 @@ void USpatialWorkerConnection::ProcessOutgoingMessages()
 		}
 		case EOutgoingMessageType::CommandRequest:
 		{
-			FCommandRequest* Message = static_cast<FCommandRequest*>(OutgoingMessage.Get());
+			FCommandRequest* Message = static_cast<FCommandRequest*>(OutgoingMessage);
 
 			static const Worker_CommandParameters DefaultCommandParams{};
-			Worker_Connection_SendCommandRequest(WorkerConnection,
+			TrackSentRequestId(Message->RequestId, Worker_Connection_SendCommandRequest(WorkerConnection,
 				Message->EntityId,
 				&Message->Request,
 				Message->CommandId,
 				nullptr,
-				&DefaultCommandParams);
+				&DefaultCommandParams));
 			break;
 		}
 		case EOutgoingMessageType::CommandResponse:
 		{
-			FCommandResponse* Message = static_cast<FCommandResponse*>(OutgoingMessage.Get());
+			FCommandResponse* Message = static_cast<FCommandResponse*>(OutgoingMessage);
 
 			Worker_Connection_SendCommandResponse(WorkerConnection,
 				Message->RequestId,
@@ -620,7 +954,7 @@ void USpatialWorkerConnection::ProcessOutgoingMessages()
 		}
 		case EOutgoingMessageType::CommandFailure:
 		{
-			FCommandFailure* Message = static_cast<FCommandFailure*>(OutgoingMessage.Get());
+			FCommandFailure* Message = static_cast<FCommandFailure*>(OutgoingMessage);
 
 			Worker_Connection_SendCommandFailure(WorkerConnection,
 				Message->RequestId,
@@ -629,21 +963,28 @@ void USpatialWorkerConnection::ProcessOutgoingMessages()
 		}
 		case EOutgoingMessageType::LogMessage:
 		{
-			FLogMessage* Message = static_cast<FLogMessage*>(OutgoingMessage.Get());
+			FLogMessage* Message = static_cast<FLogMessage*>(OutgoingMessage);
+
+			if (Message->LoggerName != CachedLoggerName || CachedLoggerNameUTF8.Num() == 0)
+			{
+				FTCHARToUTF8 LoggerName(*Message->LoggerName.ToString());
+				CachedLoggerName = Message->LoggerName;
+				CachedLoggerNameUTF8.SetNum(LoggerName.Length() + 1);
+				FMemory::Memcpy(CachedLoggerNameUTF8.GetData(), LoggerName.Get(), LoggerName.Length() + 1);
+			}
 
-			FTCHARToUTF8 LoggerName(*Message->LoggerName.ToString());
 			FTCHARToUTF8 LogString(*Message->Message);
 
 			Worker_LogMessage LogMessage{};
 			LogMessage.level = Message->Level;
-			LogMessage.logger_name = LoggerName.Get();
+			LogMessage.logger_name = CachedLoggerNameUTF8.GetData();
 			LogMessage.message = LogString.Get();
 			Worker_Connection_SendLogMessage(WorkerConnection, &LogMessage);
 			break;
 		}
 		case EOutgoingMessageType::ComponentInterest:
 		{
-			FComponentInterest* Message = static_cast<FComponentInterest*>(OutgoingMessage.Get());
+			FComponentInterest* Message = static_cast<FComponentInterest*>(OutgoingMessage);
 
 			Worker_Connection_SendComponentInterest(WorkerConnection,
 				Message->EntityId,
@@ -653,16 +994,16 @@ void USpatialWorkerConnection::ProcessOutgoingMessages()
 		}
 		case EOutgoingMessageType::EntityQueryRequest:
 		{
-			FEntityQueryRequest* Message = static_cast<FEntityQueryRequest*>(OutgoingMessage.Get());
+			FEntityQueryRequest* Message = static_cast<FEntityQueryRequest*>(OutgoingMessage);
 
-			Worker_Connection_SendEntityQueryRequest(WorkerConnection,
+			TrackSentRequestId(Message->RequestId, Worker_Connection_SendEntityQueryRequest(WorkerConnection,
 				&Message->EntityQuery,
-				nullptr);
+				nullptr));
 			break;
 		}
 		case EOutgoingMessageType::Metrics:
 		{
-			FMetrics* Message = static_cast<FMetrics*>(OutgoingMessage.Get());
+			FMetrics* Message = static_cast<FMetrics*>(OutgoingMessage);
 
 			// Do the conversion here so we can store everything on the stack.
 			Worker_Metrics WorkerMetrics;
@@ -683,6 +1024,7 @@ void USpatialWorkerConnection::ProcessOutgoingMessages()
 			TArray<Worker_HistogramMetric> WorkerHistogramMetrics;
 			TArray<TArray<Worker_HistogramMetricBucket>> WorkerHistogramMetricBuckets;
 			WorkerHistogramMetrics.SetNum(Message->Metrics.HistogramMetrics.Num());
+			WorkerHistogramMetricBuckets.SetNum(Message->Metrics.HistogramMetrics.Num());
 			for (int i = 0; i < Message->Metrics.HistogramMetrics.Num(); i++)
 			{
 				WorkerHistogramMetrics[i].key = Message->Metrics.HistogramMetrics[i].Key.c_str();
@@ -711,13 +1053,137 @@ void USpatialWorkerConnection::ProcessOutgoingMessages()
 			break;
 		}
 		}
+
+		SendLatencyHistogram.Record(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - OutgoingMessage->EnqueueCycles));
+
+		OutgoingMessagesQueues[Priority].Pop();
+	}
+
+	SendPendingComponentUpdate();
+
+	NumDeferredOutgoingMessages.store(NumDeferred, std::memory_order_relaxed);
+}
+
+FOutgoingMessage* USpatialWorkerConnection::PeekOutgoingMessage(int32& Priority, int32& NumDeferred)
+{
+	for (; Priority < NumOutgoingMessagePriorities; Priority++)
+	{
+		FOutgoingMessageQueue& Queue = OutgoingMessagesQueues[Priority];
+		if (FOutgoingMessage* OutgoingMessage = Queue.Peek())
+		{
+			if (!bUseOutgoingMessageBudgets || ConsumeOutgoingMessageBudget(*OutgoingMessage))
+			{
+				return OutgoingMessage;
+			}
+
+			// Over budget. The rest of this priority class waits for the next network update, so that it stays in order.
+			NumDeferred += Queue.Num();
+		}
+	}
+
+	return nullptr;
+}
+
+bool USpatialWorkerConnection::ConsumeOutgoingMessageBudget(const FOutgoingMessage& Message)
+{
+	const int32 TypeIndex = static_cast<int32>(Message.Type);
+	const FOutgoingMessageBudget& Budget = OutgoingMessageBudgets[TypeIndex];
+
+	if (Budget.MaxMessagesPerUpdate > 0 && MessagesSentThisUpdate[TypeIndex] >= Budget.MaxMessagesPerUpdate)
+	{
+		return false;
+	}
+
+	if (Budget.MaxBytesPerUpdate > 0)
+	{
+		const int32 Size = static_cast<int32>(GetOutgoingMessageSize(Message));
+
+		// Always let the first message through, otherwise a message larger than the budget would never be sent.
+		if (BytesSentThisUpdate[TypeIndex] > 0 && BytesSentThisUpdate[TypeIndex] + Size > Budget.MaxBytesPerUpdate)
+		{
+			return false;
+		}
+
+		BytesSentThisUpdate[TypeIndex] += Size;
 	}
+
+	MessagesSentThisUpdate[TypeIndex]++;
+	return true;
+}
+
+void USpatialWorkerConnection::ResetOutgoingMessageBudgets()
+{
+	FMemory::Memzero(MessagesSentThisUpdate);
+	FMemory::Memzero(BytesSentThisUpdate);
+}
+
+bool USpatialWorkerConnection::CoalesceComponentUpdate(FComponentUpdate& Message)
+{
+	if (PendingComponentUpdate.IsSet())
+	{
+		TPair<Worker_EntityId, Worker_ComponentUpdate>& Pending = PendingComponentUpdate.GetValue();
+		if (Pending.Key == Message.EntityId && Pending.Value.component_id == Message.Update.component_id)
+		{
+			// Later field values replace earlier ones, events are appended and cleared fields are combined.
+			if (!Schema_MergeComponentUpdateIntoUpdate(Message.Update.schema_type, Pending.Value.schema_type))
+			{
+				UE_LOG(LogSpatialWorkerConnection, Warning, TEXT("Failed to coalesce update for component %d on entity %lld, sending it separately."), Message.Update.component_id, Message.EntityId);
+				return false;
+			}
+
+			Schema_DestroyComponentUpdate(Message.Update.schema_type);
+			NumCoalescedComponentUpdates.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		// Only merging into the update right before keeps the order of events across entities and components.
+		SendPendingComponentUpdate();
+	}
+
+	PendingComponentUpdate.Emplace(Message.EntityId, Message.Update);
+	return true;
+}
+
+void USpatialWorkerConnection::SendPendingComponentUpdate()
+{
+	if (!PendingComponentUpdate.IsSet())
+	{
+		return;
+	}
+
+	TPair<Worker_EntityId, Worker_ComponentUpdate>& Update = PendingComponentUpdate.GetValue();
+	if (LoopbackConnection.IsValid())
+	{
+		LoopbackConnection->SendComponentUpdate(Update.Key, Update.Value);
+	}
+	else
+	{
+		static const Worker_UpdateParameters DisableLoopback{ false /* loopback */ };
+		Worker_Alpha_Connection_SendComponentUpdate(WorkerConnection,
+			Update.Key,
+			&Update.Value,
+			&DisableLoopback);
+	}
+
+	PendingComponentUpdate.Reset();
 }
 
 template <typename T, typename... ArgsType>
 void USpatialWorkerConnection::QueueOutgoingMessage(ArgsType&&... Args)
 {
-	// TODO UNR-1271: As later optimization, we can change the queue to hold a union
-	// of all outgoing message types, rather than having a pointer.
-	OutgoingMessagesQueue.Enqueue(MakeUnique<T>(Forward<ArgsType>(Args)...));
+	FOutgoingMessageQueue& Queue = OutgoingMessagesQueues[static_cast<int32>(TOutgoingMessagePriority<T>::Value)];
+	Queue.Enqueue<T>(Forward<ArgsType>(Args)...);
+
+	// Only the game thread queues messages, so the high-water mark can't be raised concurrently.
+	const int32 Depth = GetOutgoingMessageQueueDepth();
+	if (Depth > OutgoingMessageQueueHighWaterMark.load(std::memory_order_relaxed))
+	{
+		OutgoingMessageQueueHighWaterMark.store(Depth, std::memory_order_relaxed);
+	}
+
+	// Only wake the ops processing thread when the queue becomes non-empty, since it drains everything queued after that.
+	if (Queue.Num() == 1)
+	{
+		WakeOpsProcessingThread();
+	}
 }
@@ -120,9 +120,22 @@ void USpatialClassInfoManager::CreateClassInfoForClass(UClass* Class)
 		RPCInfo.Index = Info->RPCs.Num();
 
 		Info->RPCs.Add(RemoteFunction);
+		Info->RPCInfos.Add(RPCInfo);
 		Info->RPCInfoMap.Add(RemoteFunction, RPCInfo);
 	}
 
+	// Redirect the functions overridden by the RPCs, so that calls to them resolve without searching by name.
+	for (const FRPCInfo& RPCInfo : Info->RPCInfos)
+	{
+		for (UFunction* SuperFunction = Info->RPCs[RPCInfo.Index]->GetSuperFunction(); SuperFunction != nullptr; SuperFunction = SuperFunction->GetSuperFunction())
+		{
+			if (!Info->RPCInfoMap.Contains(SuperFunction))
+			{
+				Info->RPCInfoMap.Add(SuperFunction, RPCInfo);
+			}
+		}
+	}
+
 	const bool bEnableHandover = GetDefault<USpatialGDKSettings>()->bEnableHandover;
 
 	for (TFieldIterator<UProperty> PropertyIt(Class); PropertyIt; ++PropertyIt)
@@ -138,6 +151,7 @@ void USpatialClassInfoManager::CreateClassInfoForClass(UClass* Class)
 				HandoverInfo.Offset = Property->GetOffset_ForGC() + Property->ElementSize * ArrayIdx;
 				HandoverInfo.ArrayIdx = ArrayIdx;
 				HandoverInfo.Property = Property;
+				HandoverInfo.SchemaInfo = SpatialGDK::CreateSchemaPropertyInfo(Property);
 
 				Info->HandoverProperties.Add(HandoverInfo);
 			}
@@ -156,6 +170,10 @@ void USpatialClassInfoManager::CreateClassInfoForClass(UClass* Class)
 		}
 	}
 
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(Class);
+	Info->RepWritePlan = SpatialGDK::CreateRepLayoutWritePlan(*RepLayout);
+	Info->RepReadPlan = SpatialGDK::CreateRepLayoutReadPlan(*RepLayout);
+
 	if (Class->IsChildOf<AActor>())
 	{
 		FinishConstructingActorClassInfo(ClassPath, Info);
@@ -421,20 +439,10 @@ const FRPCInfo& USpatialClassInfoManager::GetRPCInfo(UObject* Object, UFunction*
 
 	const FClassInfo& Info = GetOrCreateClassInfoByObject(Object);
 	const FRPCInfo* RPCInfoPtr = Info.RPCInfoMap.Find(Function);
-
-	// We potentially have a parent function and need to find the child function.
-	// This exists as it's possible in blueprints to explicitly call the parent function.
 	if (RPCInfoPtr == nullptr)
 	{
-		for (auto It = Info.RPCInfoMap.CreateConstIterator(); It; ++It)
-		{
-			if (It.Key()->GetName() == Function->GetName())
-			{
-				// Matching child function found. Use this for the remote function call.
-				RPCInfoPtr = &It.Value();
-				break;
-			}
-		}
+		UE_LOG(LogSpatialClassInfoManager, Error, TEXT("No RPC info found for function %s called on %s (class %s)."),
+			*GetPathNameSafe(Function), *Object->GetName(), *GetNameSafe(Info.Class.Get()));
 	}
 	check(RPCInfoPtr != nullptr);
 	return *RPCInfoPtr;
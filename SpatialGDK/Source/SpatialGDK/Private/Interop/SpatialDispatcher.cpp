@@ -4,15 +4,111 @@
 
 #include "EngineClasses/SpatialNetConnection.h"
 #include "EngineClasses/SpatialNetDriver.h"
+#include "Interop/Connection/SpatialWorkerConnection.h"
 #include "Interop/SpatialReceiver.h"
 #include "Interop/SpatialStaticComponentView.h"
 #include "Interop/SpatialWorkerFlags.h"
+#include "SpatialGDKSettings.h"
 #include "UObject/UObjectIterator.h"
 #include "Utils/OpUtils.h"
+#include "Utils/SpatialTraceRecorder.h"
 
 
 DEFINE_LOG_CATEGORY(LogSpatialView);
 
+DECLARE_CYCLE_STAT(TEXT("SkipStartupOps"), STAT_SpatialDispatcherSkipStartupOps, STATGROUP_SpatialNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Skipped Startup Ops"), STAT_SpatialDispatcherSkippedStartupOps, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("FoldComponentUpdates"), STAT_SpatialDispatcherFoldComponentUpdates, STATGROUP_SpatialNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Folded Component Updates"), STAT_SpatialDispatcherFoldedComponentUpdates, STATGROUP_SpatialNet);
+
+namespace
+{
+	const TCHAR* GetOpTraceName(uint8 OpType)
+	{
+		switch (OpType)
+		{
+		case WORKER_OP_TYPE_DISCONNECT:
+			return TEXT("Disconnect");
+		case WORKER_OP_TYPE_FLAG_UPDATE:
+			return TEXT("FlagUpdate");
+		case WORKER_OP_TYPE_LOG_MESSAGE:
+			return TEXT("LogMessage");
+		case WORKER_OP_TYPE_METRICS:
+			return TEXT("Metrics");
+		case WORKER_OP_TYPE_CRITICAL_SECTION:
+			return TEXT("CriticalSection");
+		case WORKER_OP_TYPE_ADD_ENTITY:
+			return TEXT("AddEntity");
+		case WORKER_OP_TYPE_REMOVE_ENTITY:
+			return TEXT("RemoveEntity");
+		case WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE:
+			return TEXT("ReserveEntityIdsResponse");
+		case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
+			return TEXT("CreateEntityResponse");
+		case WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE:
+			return TEXT("DeleteEntityResponse");
+		case WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE:
+			return TEXT("EntityQueryResponse");
+		case WORKER_OP_TYPE_ADD_COMPONENT:
+			return TEXT("AddComponent");
+		case WORKER_OP_TYPE_REMOVE_COMPONENT:
+			return TEXT("RemoveComponent");
+		case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+			return TEXT("AuthorityChange");
+		case WORKER_OP_TYPE_COMPONENT_UPDATE:
+			return TEXT("ComponentUpdate");
+		case WORKER_OP_TYPE_COMMAND_REQUEST:
+			return TEXT("CommandRequest");
+		case WORKER_OP_TYPE_COMMAND_RESPONSE:
+			return TEXT("CommandResponse");
+		default:
+			return TEXT("Unknown");
+		}
+	}
+
+	FString GetOpTraceDetail(const Worker_Op* Op)
+	{
+		const Worker_ComponentId ComponentId = SpatialGDK::GetComponentId(Op);
+
+		Worker_EntityId EntityId = SpatialConstants::INVALID_ENTITY_ID;
+		switch (Op->op_type)
+		{
+		case WORKER_OP_TYPE_ADD_ENTITY:
+			EntityId = Op->add_entity.entity_id;
+			break;
+		case WORKER_OP_TYPE_REMOVE_ENTITY:
+			EntityId = Op->remove_entity.entity_id;
+			break;
+		case WORKER_OP_TYPE_ADD_COMPONENT:
+			EntityId = Op->add_component.entity_id;
+			break;
+		case WORKER_OP_TYPE_REMOVE_COMPONENT:
+			EntityId = Op->remove_component.entity_id;
+			break;
+		case WORKER_OP_TYPE_COMPONENT_UPDATE:
+			EntityId = Op->component_update.entity_id;
+			break;
+		case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+			EntityId = Op->authority_change.entity_id;
+			break;
+		case WORKER_OP_TYPE_COMMAND_REQUEST:
+			EntityId = Op->command_request.entity_id;
+			break;
+		case WORKER_OP_TYPE_COMMAND_RESPONSE:
+			EntityId = Op->command_response.entity_id;
+			break;
+		default:
+			return FString();
+		}
+
+		if (ComponentId == SpatialConstants::INVALID_COMPONENT_ID)
+		{
+			return FString::Printf(TEXT("Entity %lld"), EntityId);
+		}
+		return FString::Printf(TEXT("Entity %lld, component %u"), EntityId, ComponentId);
+	}
+}
+
 void USpatialDispatcher::Init(USpatialNetDriver* InNetDriver)
 {
 	NetDriver = InNetDriver;
@@ -22,17 +118,55 @@ void USpatialDispatcher::Init(USpatialNetDriver* InNetDriver)
 
 void USpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 {
-	for (size_t i = 0; i < OpList->op_count; ++i)
+	ProcessOps(OpList, 0, MAX_uint64);
+}
+
+uint32 USpatialDispatcher::ProcessOps(Worker_OpList* OpList, uint32 StartIndex, uint64 DeadlineCycles)
+{
+	SPATIAL_TRACE_SCOPE_DETAIL(TEXT("ProcessOps"), TEXT("Dispatch"), FString::Printf(TEXT("%u ops from %u"), static_cast<uint32>(OpList->op_count), StartIndex));
+
+	if (StartIndex == 0)
+	{
+		FoldedOpList = nullptr;
+
+		// Startup ops may have been processed already, so don't merge them into ops that haven't.
+		if (GetDefault<USpatialGDKSettings>()->bFoldReceivedComponentUpdates && OpsToSkip.Num() == 0)
+		{
+			FoldComponentUpdates(OpList);
+		}
+	}
+
+	SpatialGDK::FComponentUpdatePredecoder* Predecoder = NetDriver->Connection->GetComponentUpdatePredecoder();
+	const SpatialGDK::FPredecodedOpList* PredecodedOps = Predecoder != nullptr ? Predecoder->FindOpList(OpList) : nullptr;
+
+	uint32 OpIndex = StartIndex;
+	for (; OpIndex < OpList->op_count; ++OpIndex)
 	{
-		Worker_Op* Op = &OpList->ops[i];
+		// Always process at least one op so that every call makes progress.
+		if (OpIndex > StartIndex && !bInCriticalSection && DeadlineCycles != MAX_uint64 && FPlatformTime::Cycles64() >= DeadlineCycles)
+		{
+			break;
+		}
 
-		if (OpsToSkip.Num() != 0 &&
-			OpsToSkip.Contains(Op))
+		if (FoldedOpList == OpList && FoldedOps[OpIndex])
 		{
-			OpsToSkip.Remove(Op);
 			continue;
 		}
 
+		Worker_Op* Op = &OpList->ops[OpIndex];
+
+		SPATIAL_TRACE_SCOPE_DETAIL(GetOpTraceName(Op->op_type), TEXT("Dispatch"), GetOpTraceDetail(Op));
+
+		if (OpsToSkip.Num() != 0)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherSkipStartupOps);
+			if (OpsToSkip.Remove(Op) > 0)
+			{
+				INC_DWORD_STAT(STAT_SpatialDispatcherSkippedStartupOps);
+				continue;
+			}
+		}
+
 		if (IsExternalSchemaOp(Op))
 		{
 			ProcessExternalSchemaOp(Op);
@@ -43,7 +177,8 @@ void USpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 		{
 		// Critical Section
 		case WORKER_OP_TYPE_CRITICAL_SECTION:
-			Receiver->OnCriticalSection(Op->critical_section.in_critical_section != 0);
+			bInCriticalSection = Op->critical_section.in_critical_section != 0;
+			Receiver->OnCriticalSection(bInCriticalSection);
 			break;
 
 		// Entity Lifetime
@@ -66,7 +201,7 @@ void USpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 			break;
 		case WORKER_OP_TYPE_COMPONENT_UPDATE:
 			StaticComponentView->OnComponentUpdate(Op->component_update);
-			Receiver->OnComponentUpdate(Op->component_update);
+			Receiver->OnComponentUpdate(Op->component_update, PredecodedOps != nullptr ? PredecodedOps->Find(OpIndex) : nullptr);
 			break;
 
 		// Commands
@@ -113,8 +248,120 @@ void USpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 		}
 	}
 
+	RunBatchCallbacks();
+
 	Receiver->FlushRemoveComponentOps();
 	Receiver->FlushRetryRPCs();
+
+	return OpIndex;
+}
+
+void USpatialDispatcher::FoldComponentUpdates(Worker_OpList* OpList)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherFoldComponentUpdates);
+
+	// The last update to each component that later updates can be merged into.
+	TMap<TPair<Worker_EntityId_Key, Worker_ComponentId>, uint32> LastUpdateOpIndices;
+	// The last op for each entity that later updates must not be moved across.
+	TMap<Worker_EntityId_Key, uint32> LastBarrierOpIndices;
+
+	SpatialGDK::FComponentUpdatePredecoder* Predecoder = NetDriver->Connection->GetComponentUpdatePredecoder();
+	uint32 NumFoldedUpdates = 0;
+
+	for (uint32 OpIndex = 0; OpIndex < OpList->op_count; ++OpIndex)
+	{
+		Worker_Op* Op = &OpList->ops[OpIndex];
+
+		Worker_EntityId EntityId = SpatialConstants::INVALID_ENTITY_ID;
+		switch (Op->op_type)
+		{
+		case WORKER_OP_TYPE_ADD_ENTITY:
+			EntityId = Op->add_entity.entity_id;
+			break;
+		case WORKER_OP_TYPE_REMOVE_ENTITY:
+			EntityId = Op->remove_entity.entity_id;
+			break;
+		case WORKER_OP_TYPE_ADD_COMPONENT:
+			EntityId = Op->add_component.entity_id;
+			break;
+		case WORKER_OP_TYPE_REMOVE_COMPONENT:
+			EntityId = Op->remove_component.entity_id;
+			break;
+		case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+			EntityId = Op->authority_change.entity_id;
+			break;
+		case WORKER_OP_TYPE_COMMAND_REQUEST:
+			EntityId = Op->command_request.entity_id;
+			break;
+		case WORKER_OP_TYPE_COMMAND_RESPONSE:
+			EntityId = Op->command_response.entity_id;
+			break;
+		case WORKER_OP_TYPE_COMPONENT_UPDATE:
+			break;
+		default:
+			// Critical sections, world command responses and the like may depend on any entity, so don't merge across them.
+			LastUpdateOpIndices.Reset();
+			continue;
+		}
+
+		if (Op->op_type != WORKER_OP_TYPE_COMPONENT_UPDATE)
+		{
+			LastBarrierOpIndices.Add(EntityId, OpIndex);
+			continue;
+		}
+
+		const Worker_ComponentUpdateOp& UpdateOp = Op->component_update;
+
+		// Users' callbacks for external components expect every op.
+		if (IsExternalSchemaOp(Op))
+		{
+			continue;
+		}
+
+		// Events include RPCs, which must be applied in order with updates to the entity's other components.
+		if (Schema_GetUniqueFieldIdCount(Schema_GetComponentUpdateEvents(UpdateOp.update.schema_type)) > 0)
+		{
+			LastBarrierOpIndices.Add(UpdateOp.entity_id, OpIndex);
+			continue;
+		}
+
+		const TPair<Worker_EntityId_Key, Worker_ComponentId> Key(UpdateOp.entity_id, UpdateOp.update.component_id);
+		uint32* LastUpdateOpIndex = LastUpdateOpIndices.Find(Key);
+		const uint32* LastBarrierOpIndex = LastBarrierOpIndices.Find(UpdateOp.entity_id);
+
+		if (LastUpdateOpIndex != nullptr && (LastBarrierOpIndex == nullptr || *LastBarrierOpIndex < *LastUpdateOpIndex))
+		{
+			// Merging gives the values of the later update precedence, so merge into the earlier update and then swap the
+			// updates, so the merged update is applied in the position of the later one. The op list still owns both.
+			Worker_ComponentUpdate& EarlierUpdate = OpList->ops[*LastUpdateOpIndex].component_update.update;
+			Worker_ComponentUpdate& LaterUpdate = Op->component_update.update;
+			if (Schema_MergeComponentUpdateIntoUpdate(LaterUpdate.schema_type, EarlierUpdate.schema_type))
+			{
+				Swap(EarlierUpdate.schema_type, LaterUpdate.schema_type);
+
+				if (FoldedOpList != OpList)
+				{
+					FoldedOpList = OpList;
+					FoldedOps.Init(false, OpList->op_count);
+				}
+				FoldedOps[*LastUpdateOpIndex] = true;
+				NumFoldedUpdates++;
+
+				if (Predecoder != nullptr)
+				{
+					Predecoder->Invalidate(OpList, OpIndex);
+				}
+			}
+			else
+			{
+				UE_LOG(LogSpatialView, Warning, TEXT("Failed to merge updates to component %u on entity %lld, applying them separately."), UpdateOp.update.component_id, UpdateOp.entity_id);
+			}
+		}
+
+		LastUpdateOpIndices.Add(Key, OpIndex);
+	}
+
+	INC_DWORD_STAT_BY(STAT_SpatialDispatcherFoldedComponentUpdates, NumFoldedUpdates);
 }
 
 bool USpatialDispatcher::IsExternalSchemaOp(Worker_Op* Op) const
@@ -195,78 +442,215 @@ USpatialDispatcher::FCallbackId USpatialDispatcher::OnCommandResponse(Worker_Com
 	});
 }
 
+USpatialDispatcher::FCallbackId USpatialDispatcher::OnComponentOps(Worker_ComponentId ComponentId, const TFunction<void(const TArray<const Worker_Op*>&)>& Callback)
+{
+	check(SpatialConstants::MIN_EXTERNAL_SCHEMA_ID <= ComponentId && ComponentId <= SpatialConstants::MAX_EXTERNAL_SCHEMA_ID);
+	const FCallbackId NewCallbackId = NextCallbackId++;
+	AddCallback(FPendingCallback{ ComponentId, BatchCallbackOpTypeIndex, UserOpCallbackData{}, UserBatchCallbackData{ NewCallbackId, Callback } });
+	CallbackIdToDataMap.Add(NewCallbackId, CallbackIdData{ ComponentId, BatchCallbackOpTypeIndex });
+	return NewCallbackId;
+}
+
+int32 USpatialDispatcher::GetCallbackOpTypeIndex(uint8 OpType)
+{
+	switch (OpType)
+	{
+	case WORKER_OP_TYPE_ADD_COMPONENT:
+		return 0;
+	case WORKER_OP_TYPE_REMOVE_COMPONENT:
+		return 1;
+	case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+		return 2;
+	case WORKER_OP_TYPE_COMPONENT_UPDATE:
+		return 3;
+	case WORKER_OP_TYPE_COMMAND_REQUEST:
+		return 4;
+	case WORKER_OP_TYPE_COMMAND_RESPONSE:
+		return 5;
+	default:
+		checkNoEntry();
+		return INDEX_NONE;
+	}
+}
+
+USpatialDispatcher::FExternalComponentCallbacks& USpatialDispatcher::GetOrCreateExternalComponentCallbacks(Worker_ComponentId ComponentId)
+{
+	if (ExternalComponentCallbacks.Num() == 0)
+	{
+		ExternalComponentCallbacks.SetNum(SpatialConstants::MAX_EXTERNAL_SCHEMA_ID - SpatialConstants::MIN_EXTERNAL_SCHEMA_ID + 1);
+	}
+	return ExternalComponentCallbacks[ComponentId - SpatialConstants::MIN_EXTERNAL_SCHEMA_ID];
+}
+
 USpatialDispatcher::FCallbackId USpatialDispatcher::AddGenericOpCallback(Worker_ComponentId ComponentId, Worker_OpType OpType, const TFunction<void(const Worker_Op*)>& Callback)
 {
 	check(SpatialConstants::MIN_EXTERNAL_SCHEMA_ID <= ComponentId && ComponentId <= SpatialConstants::MAX_EXTERNAL_SCHEMA_ID);
 	const FCallbackId NewCallbackId = NextCallbackId++;
-	ComponentOpTypeToCallbacksMap.FindOrAdd(ComponentId).FindOrAdd(OpType).Add(UserOpCallbackData{ NewCallbackId, Callback });
-	CallbackIdToDataMap.Add(NewCallbackId, CallbackIdData{ ComponentId, OpType });
+	const int32 OpTypeIndex = GetCallbackOpTypeIndex(OpType);
+	AddCallback(FPendingCallback{ ComponentId, OpTypeIndex, UserOpCallbackData{ NewCallbackId, Callback }, UserBatchCallbackData{} });
+	CallbackIdToDataMap.Add(NewCallbackId, CallbackIdData{ ComponentId, OpTypeIndex });
 	return NewCallbackId;
 }
 
+void USpatialDispatcher::AddCallback(FPendingCallback&& Callback)
+{
+	if (CallbackDispatchDepth > 0)
+	{
+		PendingCallbacks.Add(MoveTemp(Callback));
+		return;
+	}
+
+	FExternalComponentCallbacks& Callbacks = GetOrCreateExternalComponentCallbacks(Callback.ComponentId);
+	if (Callback.OpTypeIndex == BatchCallbackOpTypeIndex)
+	{
+		Callbacks.BatchCallbacks.Add(MoveTemp(Callback.BatchCallback));
+	}
+	else
+	{
+		Callbacks.OpCallbacks[Callback.OpTypeIndex].Add(MoveTemp(Callback.OpCallback));
+	}
+}
+
 bool USpatialDispatcher::RemoveOpCallback(FCallbackId CallbackId)
 {
-	CallbackIdData* CallbackData = CallbackIdToDataMap.Find(CallbackId);
-	if (CallbackData == nullptr)
+	CallbackIdData CallbackData;
+	if (!CallbackIdToDataMap.RemoveAndCopyValue(CallbackId, CallbackData))
 	{
 		return false;
 	}
 
-	OpTypeToCallbacksMap* OpTypesToCallbacks = ComponentOpTypeToCallbacksMap.Find(CallbackData->ComponentId);
-	if (OpTypesToCallbacks == nullptr)
+	if (CallbackDispatchDepth > 0)
 	{
-		return false;
+		const int32 NumPendingCallbacks = PendingCallbacks.Num();
+		PendingCallbacks.RemoveAll([CallbackId](const FPendingCallback& Callback)
+		{
+			return (Callback.OpTypeIndex == BatchCallbackOpTypeIndex ? Callback.BatchCallback.Id : Callback.OpCallback.Id) == CallbackId;
+		});
+		return PendingCallbacks.Num() != NumPendingCallbacks || MarkCallbackRemoved(CallbackId, CallbackData);
 	}
 
-	TArray<UserOpCallbackData>* ComponentCallbacks = OpTypesToCallbacks->Find(CallbackData->OpType);
-	if (ComponentCallbacks == nullptr)
+	FExternalComponentCallbacks& Callbacks = GetOrCreateExternalComponentCallbacks(CallbackData.ComponentId);
+
+	if (CallbackData.OpTypeIndex == BatchCallbackOpTypeIndex)
 	{
-		return false;
+		return Callbacks.BatchCallbacks.RemoveAll([CallbackId](const UserBatchCallbackData& Data)
+		{
+			return Data.Id == CallbackId;
+		}) > 0;
 	}
 
-	int32 CallbackIndex = ComponentCallbacks->IndexOfByPredicate([CallbackId](const UserOpCallbackData& Data)
+	return Callbacks.OpCallbacks[CallbackData.OpTypeIndex].RemoveAll([CallbackId](const UserOpCallbackData& Data)
 	{
 		return Data.Id == CallbackId;
-	});
-	if (CallbackIndex == INDEX_NONE)
+	}) > 0;
+}
+
+bool USpatialDispatcher::MarkCallbackRemoved(FCallbackId CallbackId, const CallbackIdData& CallbackData)
+{
+	FExternalComponentCallbacks& Callbacks = GetOrCreateExternalComponentCallbacks(CallbackData.ComponentId);
+
+	bool* bRemoved = nullptr;
+	if (CallbackData.OpTypeIndex == BatchCallbackOpTypeIndex)
+	{
+		UserBatchCallbackData* Data = Callbacks.BatchCallbacks.FindByPredicate([CallbackId](const UserBatchCallbackData& Candidate) { return Candidate.Id == CallbackId; });
+		bRemoved = Data != nullptr ? &Data->bRemoved : nullptr;
+	}
+	else
+	{
+		UserOpCallbackData* Data = Callbacks.OpCallbacks[CallbackData.OpTypeIndex].FindByPredicate([CallbackId](const UserOpCallbackData& Candidate) { return Candidate.Id == CallbackId; });
+		bRemoved = Data != nullptr ? &Data->bRemoved : nullptr;
+	}
+
+	if (bRemoved == nullptr)
 	{
 		return false;
 	}
 
-	// If removing the only callback for a component ID / op type, delete map entries as applicable
-	if (ComponentCallbacks->Num() == 1)
+	*bRemoved = true;
+	ComponentsWithRemovedCallbacks.AddUnique(CallbackData.ComponentId);
+	return true;
+}
+
+void USpatialDispatcher::FinishRunningCallbacks()
+{
+	check(CallbackDispatchDepth > 0);
+	if (--CallbackDispatchDepth > 0)
+	{
+		return;
+	}
+
+	for (Worker_ComponentId ComponentId : ComponentsWithRemovedCallbacks)
 	{
-		if (OpTypesToCallbacks->Num() == 1)
+		FExternalComponentCallbacks& Callbacks = GetOrCreateExternalComponentCallbacks(ComponentId);
+		for (TArray<UserOpCallbackData>& OpCallbacks : Callbacks.OpCallbacks)
 		{
-			ComponentOpTypeToCallbacksMap.Remove(CallbackData->ComponentId);
-			return true;
+			OpCallbacks.RemoveAll([](const UserOpCallbackData& Data) { return Data.bRemoved; });
 		}
-		OpTypesToCallbacks->Remove(CallbackData->OpType);
-		return true;
+		Callbacks.BatchCallbacks.RemoveAll([](const UserBatchCallbackData& Data) { return Data.bRemoved; });
 	}
+	ComponentsWithRemovedCallbacks.Reset();
 
-	ComponentCallbacks->RemoveAt(CallbackIndex);
-	return true;
+	for (FPendingCallback& Callback : PendingCallbacks)
+	{
+		AddCallback(MoveTemp(Callback));
+	}
+	PendingCallbacks.Reset();
 }
 
 void USpatialDispatcher::RunCallbacks(Worker_ComponentId ComponentId, const Worker_Op* Op)
 {
-	OpTypeToCallbacksMap* OpTypeCallbacks = ComponentOpTypeToCallbacksMap.Find(ComponentId);
-	if (OpTypeCallbacks == nullptr)
+	if (ExternalComponentCallbacks.Num() == 0)
 	{
 		return;
 	}
 
-	TArray<UserOpCallbackData>* ComponentCallbacks = OpTypeCallbacks->Find(static_cast<Worker_OpType>(Op->op_type));
-	if (ComponentCallbacks == nullptr)
+	FExternalComponentCallbacks& Callbacks = ExternalComponentCallbacks[ComponentId - SpatialConstants::MIN_EXTERNAL_SCHEMA_ID];
+
+	CallbackDispatchDepth++;
+	for (const UserOpCallbackData& CallbackData : Callbacks.OpCallbacks[GetCallbackOpTypeIndex(Op->op_type)])
+	{
+		if (!CallbackData.bRemoved)
+		{
+			CallbackData.Callback(Op);
+		}
+	}
+	FinishRunningCallbacks();
+
+	if (Callbacks.BatchCallbacks.Num() > 0)
+	{
+		if (Callbacks.BatchedOps.Num() == 0)
+		{
+			ComponentsWithBatchedOps.Add(ComponentId);
+		}
+		Callbacks.BatchedOps.Add(Op);
+	}
+}
+
+void USpatialDispatcher::RunBatchCallbacks()
+{
+	if (ComponentsWithBatchedOps.Num() == 0)
 	{
 		return;
 	}
 
-	for (UserOpCallbackData CallbackData : *ComponentCallbacks)
+	CallbackDispatchDepth++;
+	for (Worker_ComponentId ComponentId : ComponentsWithBatchedOps)
 	{
-		CallbackData.Callback(Op);
+		FExternalComponentCallbacks& Callbacks = ExternalComponentCallbacks[ComponentId - SpatialConstants::MIN_EXTERNAL_SCHEMA_ID];
+
+		for (const UserBatchCallbackData& CallbackData : Callbacks.BatchCallbacks)
+		{
+			if (!CallbackData.bRemoved)
+			{
+				CallbackData.Callback(Callbacks.BatchedOps);
+			}
+		}
+
+		Callbacks.BatchedOps.Reset();
 	}
+	FinishRunningCallbacks();
+
+	ComponentsWithBatchedOps.Reset();
 }
 
 void USpatialDispatcher::MarkOpToSkip(const Worker_Op* Op)
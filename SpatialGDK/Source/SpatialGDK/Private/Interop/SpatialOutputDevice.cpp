@@ -3,22 +3,42 @@
 #include "Interop/SpatialOutputDevice.h"
 
 #include "Interop/Connection/SpatialWorkerConnection.h"
+#include "SpatialGDKSettings.h"
+
+namespace
+{
+	// Batches are sent early once they reach this many characters, to keep individual log messages readable.
+	const int32 MaxBatchLength = 16 * 1024;
+
+	const double DroppedLinesReportInterval = 1.0;
+}
 
 FSpatialOutputDevice::FSpatialOutputDevice(USpatialWorkerConnection* InConnection, FName LoggerName, int32 InPIEIndex)
 	: FilterLevel(ELogVerbosity::Warning)
 	, Connection(InConnection)
 	, WorkerName(LoggerName)
 	, PIEIndex(InPIEIndex)
+	, LastDroppedLinesReportTime(0.0)
+	, RepeatedLineLevel(WORKER_LOG_LEVEL_INFO)
+	, RepeatCount(0)
+	, BatchLevel(WORKER_LOG_LEVEL_INFO)
 {
 	const TCHAR* CommandLine = FCommandLine::Get();
 	bLogToSpatial = !FParse::Param(CommandLine, TEXT("NoLogToSpatial"));
 
+	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
+	MaxLinesPerSecondPerCategory = SpatialGDKSettings->LogForwardingMaxLinesPerSecondPerCategory;
+	MaxBurstLinesPerCategory = FMath::Max(SpatialGDKSettings->LogForwardingMaxBurstLinesPerCategory, 1.0f);
+
 	FOutputDeviceRedirector::Get()->AddOutputDevice(this);
 }
 
 FSpatialOutputDevice::~FSpatialOutputDevice()
 {
 	FOutputDeviceRedirector::Get()->RemoveOutputDevice(this);
+
+	// Send the held back repeated line and any batched lines, so the last lines before shutdown aren't lost.
+	Flush();
 }
 
 void FSpatialOutputDevice::Serialize(const TCHAR* InData, ELogVerbosity::Type Verbosity, const class FName& Category)
@@ -28,7 +48,12 @@ void FSpatialOutputDevice::Serialize(const TCHAR* InData, ELogVerbosity::Type Ve
 		return;
 	}
 
-	if (bLogToSpatial && Connection->IsConnected())
+	if (CategoriesToRedirect.Num() > 0 && !CategoriesToRedirect.Contains(Category))
+	{
+		return;
+	}
+
+	if (bLogToSpatial && Connection.IsValid() && Connection->IsConnected())
 	{
 #if WITH_EDITOR
 		if (GPlayInEditorID != PIEIndex)
@@ -36,8 +61,133 @@ void FSpatialOutputDevice::Serialize(const TCHAR* InData, ELogVerbosity::Type Ve
 			return;
 		}
 #endif //WITH_EDITOR
-		Connection->SendLogMessage(ConvertLogLevelToSpatial(Verbosity), WorkerName, InData);
+		const Worker_LogLevel Level = ConvertLogLevelToSpatial(Verbosity);
+
+		if (RepeatCount > 0 && Level == RepeatedLineLevel && Category == RepeatedLineCategory && RepeatedLine.Equals(InData, ESearchCase::CaseSensitive))
+		{
+			RepeatCount++;
+			return;
+		}
+
+		BatchRepeatedLine();
+
+		if (Verbosity != ELogVerbosity::Fatal && !ConsumeRateLimitToken(Category))
+		{
+			return;
+		}
+
+		RepeatedLine = InData;
+		RepeatedLineCategory = Category;
+		RepeatedLineLevel = Level;
+		RepeatCount = 1;
+
+		if (Verbosity == ELogVerbosity::Fatal)
+		{
+			Flush();
+		}
+	}
+}
+
+void FSpatialOutputDevice::Flush()
+{
+	BatchRepeatedLine();
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastDroppedLinesReportTime >= DroppedLinesReportInterval)
+	{
+		LastDroppedLinesReportTime = Now;
+
+		for (TPair<FName, FCategoryRateLimit>& RateLimit : CategoryRateLimits)
+		{
+			if (RateLimit.Value.NumDropped > 0)
+			{
+				BatchLine(WORKER_LOG_LEVEL_WARN, RateLimit.Key, FString::Printf(TEXT("Dropped %d lines over the rate limit of %.1f lines per second."), RateLimit.Value.NumDropped, MaxLinesPerSecondPerCategory), 1);
+				RateLimit.Value.NumDropped = 0;
+			}
+		}
+	}
+
+	SendBatch();
+}
+
+bool FSpatialOutputDevice::ConsumeRateLimitToken(const FName& Category)
+{
+	if (MaxLinesPerSecondPerCategory <= 0.0f)
+	{
+		return true;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	FCategoryRateLimit* RateLimit = CategoryRateLimits.Find(Category);
+	if (RateLimit == nullptr)
+	{
+		RateLimit = &CategoryRateLimits.Add(Category, FCategoryRateLimit{ MaxBurstLinesPerCategory, Now, 0 });
+	}
+
+	RateLimit->Tokens = FMath::Min<double>(MaxBurstLinesPerCategory, RateLimit->Tokens + (Now - RateLimit->LastRefillTime) * MaxLinesPerSecondPerCategory);
+	RateLimit->LastRefillTime = Now;
+
+	if (RateLimit->Tokens < 1.0)
+	{
+		RateLimit->NumDropped++;
+		return false;
+	}
+
+	RateLimit->Tokens -= 1.0;
+	return true;
+}
+
+void FSpatialOutputDevice::BatchRepeatedLine()
+{
+	if (RepeatCount == 0)
+	{
+		return;
 	}
+
+	BatchLine(RepeatedLineLevel, RepeatedLineCategory, RepeatedLine, RepeatCount);
+
+	RepeatedLine.Reset();
+	RepeatCount = 0;
+}
+
+void FSpatialOutputDevice::BatchLine(Worker_LogLevel Level, const FName& Category, const FString& Line, int32 Count)
+{
+	if (Batch.Len() > 0 && (Level != BatchLevel || Batch.Len() >= MaxBatchLength))
+	{
+		SendBatch();
+	}
+
+	if (Batch.Len() > 0)
+	{
+		Batch += TEXT('\n');
+	}
+
+	BatchLevel = Level;
+
+	Category.AppendString(Batch);
+	Batch += TEXT(": ");
+	Batch += Line;
+
+	if (Count > 1)
+	{
+		Batch += FString::Printf(TEXT(" (repeated %d times)"), Count);
+	}
+}
+
+void FSpatialOutputDevice::SendBatch()
+{
+	if (Batch.Len() == 0)
+	{
+		return;
+	}
+
+	if (Connection.IsValid() && Connection->IsConnected())
+	{
+		Connection->SendLogMessage(BatchLevel, WorkerName, MoveTemp(Batch));
+	}
+
+	Batch.Reset();
 }
 
 void FSpatialOutputDevice::AddRedirectCategory(const FName& Category)
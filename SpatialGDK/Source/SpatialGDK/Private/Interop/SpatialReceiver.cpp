@@ -2,6 +2,7 @@
 
 #include "Interop/SpatialReceiver.h"
 
+#include "Algo/StableSort.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
@@ -12,6 +13,7 @@
 #include "EngineClasses/SpatialFastArrayNetSerialize.h"
 #include "EngineClasses/SpatialGameInstance.h"
 #include "EngineClasses/SpatialNetConnection.h"
+#include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
 #include "Interop/Connection/SpatialWorkerConnection.h"
 #include "Interop/GlobalStateManager.h"
@@ -24,13 +26,20 @@
 #include "Schema/SpawnData.h"
 #include "Schema/UnrealMetadata.h"
 #include "SpatialConstants.h"
+#include "SpatialGDKSettings.h"
 #include "Utils/ComponentReader.h"
 #include "Utils/ErrorCodeRemapping.h"
 #include "Utils/RepLayoutUtils.h"
+#include "Utils/SpatialActorPool.h"
 #include "Utils/SpatialMetrics.h"
+#include "Utils/SpatialTraceRecorder.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialReceiver);
 
+DECLARE_CYCLE_STAT(TEXT("Receiver LeaveCriticalSection"), STAT_ReceiverLeaveCriticalSection, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Receiver BeginPlay Batch Spawned Actors"), STAT_ReceiverPendingBeginPlayActors, STATGROUP_SpatialNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Actors Spawned"), STAT_ReceiverActorsSpawned, STATGROUP_SpatialNet);
+
 using namespace SpatialGDK;
 
 void USpatialReceiver::Init(USpatialNetDriver* InNetDriver, FTimerManager* InTimerManager)
@@ -42,6 +51,8 @@ void USpatialReceiver::Init(USpatialNetDriver* InNetDriver, FTimerManager* InTim
 	ClassInfoManager = InNetDriver->ClassInfoManager;
 	GlobalStateManager = InNetDriver->GlobalStateManager;
 	TimerManager = InTimerManager;
+
+	IncomingRPCs.Init();
 }
 
 void USpatialReceiver::OnCriticalSection(bool InCriticalSection)
@@ -65,9 +76,22 @@ void USpatialReceiver::EnterCriticalSection()
 
 void USpatialReceiver::LeaveCriticalSection()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ReceiverLeaveCriticalSection);
 	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Leaving critical section."));
 	check(bInCriticalSection);
 
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const uint32 NumActorsSpawnedBefore = NumActorsSpawned;
+	const bool bBatchActorSpawning = GetDefault<USpatialGDKSettings>()->bBatchActorSpawning;
+
+	if (bBatchActorSpawning && PendingAddEntities.Num() > 1)
+	{
+		SortPendingAddEntitiesByClass();
+
+		TMap<Worker_EntityId_Key, USpatialActorChannel*>& EntityToActorChannel = NetDriver->GetEntityToActorChannelMap();
+		EntityToActorChannel.Reserve(EntityToActorChannel.Num() + PendingAddEntities.Num());
+	}
+
 	for (Worker_EntityId& PendingAddEntity : PendingAddEntities)
 	{
 		ReceiveActor(PendingAddEntity);
@@ -82,9 +106,127 @@ void USpatialReceiver::LeaveCriticalSection()
 	bInCriticalSection = false;
 	PendingAddEntities.Empty();
 	PendingAddComponents.Empty();
+	PendingAddComponentIndices.Empty();
 	PendingAuthorityChanges.Empty();
 
 	ProcessQueuedResolvedObjects();
+
+	if (NumActorsSpawned != NumActorsSpawnedBefore)
+	{
+		RecordActorSpawnTime(StartCycles, NumActorsSpawned - NumActorsSpawnedBefore);
+	}
+
+	// Batch spawned actors start once all of them have their initial data and authority, as after PostNetInit.
+	if (bBatchActorSpawning)
+	{
+		ProcessPendingBeginPlayActors();
+	}
+}
+
+void USpatialReceiver::SortPendingAddEntitiesByClass()
+{
+	static const FString NoClassPath;
+
+	// Spawning actors of the same class together keeps their class data and default objects warm in the cache.
+	Algo::StableSortBy(PendingAddEntities, [this](Worker_EntityId EntityId) -> const FString&
+	{
+		UnrealMetadata* UnrealMetadataComp = StaticComponentView->GetComponentData<UnrealMetadata>(EntityId);
+		return UnrealMetadataComp != nullptr ? UnrealMetadataComp->ClassPath : NoClassPath;
+	});
+}
+
+void USpatialReceiver::DispatchActorBeginPlay(AActor* EntityActor)
+{
+	// Taken from PostNetInit
+	if (NetDriver->GetWorld()->HasBegunPlay() && !EntityActor->HasActorBegunPlay())
+	{
+		EntityActor->DispatchBeginPlay();
+	}
+
+	EntityActor->UpdateOverlaps();
+}
+
+void USpatialReceiver::ProcessPendingBeginPlayActors()
+{
+	if (NextPendingBeginPlayActor == PendingBeginPlayActors.Num())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ReceiverPendingBeginPlayActors);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const float BudgetMs = GetDefault<USpatialGDKSettings>()->ActorBeginPlayBudgetMs;
+	const uint64 BudgetCycles = BudgetMs > 0.0f ? static_cast<uint64>(BudgetMs / FPlatformTime::GetSecondsPerCycle64() / 1000.0) : 0;
+
+	while (NextPendingBeginPlayActor < PendingBeginPlayActors.Num())
+	{
+		// Always start at least one actor so the queue makes progress.
+		if (BudgetCycles > 0 && FPlatformTime::Cycles64() - StartCycles > BudgetCycles)
+		{
+			break;
+		}
+
+		// The actor may have been removed from view since it was spawned.
+		if (AActor* EntityActor = PendingBeginPlayActors[NextPendingBeginPlayActor++].Get())
+		{
+			DispatchActorBeginPlay(EntityActor);
+		}
+	}
+
+	if (NextPendingBeginPlayActor == PendingBeginPlayActors.Num())
+	{
+		PendingBeginPlayActors.Reset();
+		NextPendingBeginPlayActor = 0;
+	}
+	else
+	{
+		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Deferring BeginPlay for %d batch spawned actors to the next frame."), PendingBeginPlayActors.Num() - NextPendingBeginPlayActor);
+	}
+
+	RecordActorSpawnTime(StartCycles, 0);
+}
+
+void USpatialReceiver::RemovePendingBeginPlayActor(AActor* Actor)
+{
+	for (int32 Index = NextPendingBeginPlayActor; Index < PendingBeginPlayActors.Num(); Index++)
+	{
+		if (PendingBeginPlayActors[Index] == Actor)
+		{
+			PendingBeginPlayActors.RemoveAt(Index);
+			break;
+		}
+	}
+
+	if (NextPendingBeginPlayActor == PendingBeginPlayActors.Num())
+	{
+		PendingBeginPlayActors.Reset();
+		NextPendingBeginPlayActor = 0;
+	}
+}
+
+void USpatialReceiver::RecordActorSpawnTime(uint64 StartCycles, uint32 NumActorsSpawnedSinceStart)
+{
+	if (SpawnStatsFrameNumber != GFrameCounter)
+	{
+		SpawnStatsFrameNumber = GFrameCounter;
+		SpawnCyclesThisFrame = 0;
+		ActorsSpawnedThisFrame = 0;
+	}
+
+	SpawnCyclesThisFrame += FPlatformTime::Cycles64() - StartCycles;
+	ActorsSpawnedThisFrame += NumActorsSpawnedSinceStart;
+
+	LongestSpawnFrameCycles = FMath::Max(LongestSpawnFrameCycles, SpawnCyclesThisFrame);
+	MaxActorsSpawnedPerFrame = FMath::Max(MaxActorsSpawnedPerFrame, ActorsSpawnedThisFrame);
+}
+
+void USpatialReceiver::TakeActorSpawnStats(uint32& OutMaxActorsSpawnedPerFrame, double& OutLongestSpawnFrameSeconds)
+{
+	OutMaxActorsSpawnedPerFrame = MaxActorsSpawnedPerFrame;
+	OutLongestSpawnFrameSeconds = FPlatformTime::ToSeconds64(LongestSpawnFrameCycles);
+	MaxActorsSpawnedPerFrame = 0;
+	LongestSpawnFrameCycles = 0;
 }
 
 void USpatialReceiver::OnAddEntity(const Worker_AddEntityOp& Op)
@@ -142,6 +284,7 @@ void USpatialReceiver::OnAddComponent(const Worker_AddComponentOp& Op)
 
 	if (bInCriticalSection)
 	{
+		PendingAddComponentIndices.FindOrAdd(Op.entity_id).Add(PendingAddComponents.Num());
 		PendingAddComponents.Emplace(Op.entity_id, Op.data.component_id, MakeUnique<DynamicComponent>(Op.data));
 	}
 	else
@@ -423,11 +566,17 @@ void USpatialReceiver::HandleActorAuthority(const Worker_AuthorityChangeOp& Op)
 
 bool USpatialReceiver::IsReceivedEntityTornOff(Worker_EntityId EntityId)
 {
+	const TArray<int32>* ComponentIndices = PendingAddComponentIndices.Find(EntityId);
+	if (ComponentIndices == nullptr)
+	{
+		return false;
+	}
+
 	// Check the pending add components, to find the root component for the received entity.
-	for (PendingAddComponentWrapper& PendingAddComponent : PendingAddComponents)
+	for (int32 ComponentIndex : *ComponentIndices)
 	{
-		if (PendingAddComponent.EntityId != EntityId
-			|| ClassInfoManager->GetCategoryByComponentId(PendingAddComponent.ComponentId) != SCHEMA_Data)
+		PendingAddComponentWrapper& PendingAddComponent = PendingAddComponents[ComponentIndex];
+		if (ClassInfoManager->GetCategoryByComponentId(PendingAddComponent.ComponentId) != SCHEMA_Data)
 		{
 			continue;
 		}
@@ -551,15 +700,16 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 		// Apply initial replicated properties.
 		// This was moved to after FinishingSpawning because components existing only in blueprints aren't added until spawning is complete
 		// Potentially we could split out the initial actor state and the initial component state
-		for (PendingAddComponentWrapper& PendingAddComponent : PendingAddComponents)
+		if (const TArray<int32>* ComponentIndices = PendingAddComponentIndices.Find(EntityId))
 		{
-			if (ClassInfoManager->IsSublevelComponent(PendingAddComponent.ComponentId))
+			for (int32 ComponentIndex : *ComponentIndices)
 			{
-				continue;
-			}
+				PendingAddComponentWrapper& PendingAddComponent = PendingAddComponents[ComponentIndex];
+				if (ClassInfoManager->IsSublevelComponent(PendingAddComponent.ComponentId))
+				{
+					continue;
+				}
 
-			if (PendingAddComponent.EntityId == EntityId)
-			{
 				ApplyComponentDataOnActorCreation(EntityId, *PendingAddComponent.Data->ComponentData, Channel);
 			}
 		}
@@ -586,18 +736,22 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 
 		}
 
-		// Taken from PostNetInit
-		if (NetDriver->GetWorld()->HasBegunPlay() && !EntityActor->HasActorBegunPlay())
-		{
-			EntityActor->DispatchBeginPlay();
-		}
-
 		if (EntityActor->GetClass()->HasAnySpatialClassFlags(SPATIALCLASS_Singleton))
 		{
 			GlobalStateManager->RegisterSingletonChannel(EntityActor, Channel);
 		}
 
-		EntityActor->UpdateOverlaps();
+		NumActorsSpawned++;
+		INC_DWORD_STAT(STAT_ReceiverActorsSpawned);
+
+		if (GetDefault<USpatialGDKSettings>()->bBatchActorSpawning)
+		{
+			PendingBeginPlayActors.Add(EntityActor);
+		}
+		else
+		{
+			DispatchActorBeginPlay(EntityActor);
+		}
 	}
 }
 
@@ -698,9 +852,46 @@ void USpatialReceiver::RemoveActor(Worker_EntityId EntityId)
 		return;
 	}
 
+	if (NetDriver->ActorPool != nullptr && NetDriver->ActorPool->CanReturnActor(Actor))
+	{
+		ReturnActorToPool(Actor, EntityId);
+		return;
+	}
+
+	// A batch spawned actor can leave view before BeginPlay is called on it.
+	RemovePendingBeginPlayActor(Actor);
 	DestroyActor(Actor, EntityId);
 }
 
+void USpatialReceiver::ReturnActorToPool(AActor* Actor, Worker_EntityId EntityId)
+{
+	// Pooled actors aren't destroyed, so they would otherwise still be started while they are in the pool.
+	RemovePendingBeginPlayActor(Actor);
+
+	// The subobjects replication created on the actor are stripped by the pool, so take them before the channel clears them.
+	TArray<UObject*> ReplicatedSubobjects;
+
+	if (USpatialActorChannel* ActorChannel = NetDriver->GetActorChannelByEntityId(EntityId))
+	{
+		ReplicatedSubobjects = ActorChannel->CreateSubObjects;
+		ActorChannel->bKeepActorOnCleanUp = true;
+
+#if ENGINE_MINOR_VERSION <= 20
+		ActorChannel->ConditionalCleanUp();
+#else
+		ActorChannel->ConditionalCleanUp(false, EChannelCloseReason::Destroyed);
+#endif
+	}
+	else
+	{
+		CleanupDeletedEntity(EntityId);
+	}
+
+	NetDriver->ActorPool->ReturnActor(Actor, ReplicatedSubobjects);
+
+	check(PackageMap->GetObjectFromEntityId(EntityId) == nullptr);
+}
+
 void USpatialReceiver::QueryForStartupActor(AActor* Actor, Worker_EntityId EntityId)
 {
 	Worker_EntityIdConstraint StartupActorConstraintEntityId;
@@ -852,12 +1043,18 @@ AActor* USpatialReceiver::CreateActor(UnrealMetadata* UnrealMetadataComp, SpawnD
 
 	FVector SpawnLocation = FRepMovement::RebaseOntoLocalOrigin(SpawnDataComp->Location, NetDriver->GetWorld()->OriginLocation);
 
-	AActor* NewActor = NetDriver->GetWorld()->SpawnActorAbsolute(ActorClass, FTransform(SpawnDataComp->Rotation, SpawnLocation), SpawnInfo);
+	AActor* NewActor = NetDriver->ActorPool != nullptr ? NetDriver->ActorPool->TakeActor(ActorClass, FTransform(SpawnDataComp->Rotation, SpawnLocation)) : nullptr;
+	const bool bReusedPooledActor = NewActor != nullptr;
+	if (!bReusedPooledActor)
+	{
+		NewActor = NetDriver->GetWorld()->SpawnActorAbsolute(ActorClass, FTransform(SpawnDataComp->Rotation, SpawnLocation), SpawnInfo);
+	}
 	check(NewActor);
 
 	// Imitate the behavior in UPackageMapClient::SerializeNewActor.
+	// Pooled actors may still have the velocity of the entity that used them last.
 	const float Epsilon = 0.001f;
-	if (!SpawnDataComp->Velocity.Equals(FVector::ZeroVector, Epsilon))
+	if (bReusedPooledActor || !SpawnDataComp->Velocity.Equals(FVector::ZeroVector, Epsilon))
 	{
 		NewActor->PostNetReceiveVelocity(SpawnDataComp->Velocity);
 	}
@@ -1053,7 +1250,7 @@ void USpatialReceiver::ApplyComponentData(UObject* TargetObject, USpatialActorCh
 	}
 }
 
-void USpatialReceiver::OnComponentUpdate(const Worker_ComponentUpdateOp& Op)
+void USpatialReceiver::OnComponentUpdate(const Worker_ComponentUpdateOp& Op, const SpatialGDK::FPredecodedComponentUpdate* Predecoded /* = nullptr */)
 {
 	if (StaticComponentView->GetAuthority(Op.entity_id, Op.update.component_id) == WORKER_AUTHORITY_AUTHORITATIVE)
 	{
@@ -1146,7 +1343,7 @@ void USpatialReceiver::OnComponentUpdate(const Worker_ComponentUpdateOp& Op)
 
 	if (Category == ESchemaComponentType::SCHEMA_Data || Category == ESchemaComponentType::SCHEMA_OwnerOnly)
 	{
-		ApplyComponentUpdate(Op.update, TargetObject, Channel, /* bIsHandover */ false);
+		ApplyComponentUpdate(Op.update, TargetObject, Channel, /* bIsHandover */ false, Predecoded);
 	}
 	else if (Category == ESchemaComponentType::SCHEMA_Handover)
 	{
@@ -1225,17 +1422,17 @@ void USpatialReceiver::ProcessRPCEventField(Worker_EntityId EntityId, const Work
 			}
 		}
 
-		FPendingRPCParamsPtr Params = MakeUnique<FPendingRPCParams>(ObjectRef, MoveTemp(Payload));
+		FPendingRPCParams Params(ObjectRef, MoveTemp(Payload));
 		if (UObject* TargetObject = PackageMap->GetObjectFromUnrealObjectRef(ObjectRef).Get())
 		{
 			const FClassInfo& ClassInfo = ClassInfoManager->GetOrCreateClassInfoByObject(TargetObject);
-			UFunction* Function = ClassInfo.RPCs[Payload.Index];
-			const FRPCInfo& RPCInfo = ClassInfoManager->GetRPCInfo(TargetObject, Function);
+			const FRPCInfo& RPCInfo = ClassInfo.RPCInfos[Payload.Index];
 
 			if (!IncomingRPCs.ObjectHasRPCsQueuedOfType(ObjectRef.Entity, RPCInfo.Type))
 			{
 				// Apply if possible, queue otherwise
-				if (ApplyRPC(*Params))
+				TSet<FUnrealObjectRef> UnresolvedRefs;
+				if (ApplyRPC(Params, UnresolvedRefs))
 				{
 					continue;
 				}
@@ -1315,7 +1512,7 @@ void USpatialReceiver::OnCommandRequest(const Worker_CommandRequestOp& Op)
 
 	const FClassInfo& Info = ClassInfoManager->GetOrCreateClassInfoByObject(TargetObject);
 	UFunction* Function = Info.RPCs[Payload.Index];
-	const FRPCInfo& RPCInfo = ClassInfoManager->GetRPCInfo(TargetObject, Function);
+	const FRPCInfo& RPCInfo = Info.RPCInfos[Payload.Index];
 
 	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Received command request (entity: %lld, component: %d, function: %s)"),
 		Op.entity_id, Op.request.component_id, *Function->GetName());
@@ -1331,7 +1528,7 @@ void USpatialReceiver::OnCommandRequest(const Worker_CommandRequestOp& Op)
 
 	if (!bAppliedRPC)
 	{
-		QueueIncomingRPC(MakeUnique<FPendingRPCParams>(ObjectRef, MoveTemp(Payload)));
+		QueueIncomingRPC(FPendingRPCParams(ObjectRef, MoveTemp(Payload)));
 	}
 
 	Sender->SendEmptyCommandResponse(Op.request.component_id, CommandIndex, Op.request_id);
@@ -1411,14 +1608,14 @@ void USpatialReceiver::ReceiveCommandResponse(const Worker_CommandResponseOp& Op
 	}
 }
 
-void USpatialReceiver::ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* TargetObject, USpatialActorChannel* Channel, bool bIsHandover)
+void USpatialReceiver::ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* TargetObject, USpatialActorChannel* Channel, bool bIsHandover, const SpatialGDK::FPredecodedComponentUpdate* Predecoded /* = nullptr */)
 {
 	FChannelObjectPair ChannelObjectPair(Channel, TargetObject);
 
 	FObjectReferencesMap& ObjectReferencesMap = UnresolvedRefsMap.FindOrAdd(ChannelObjectPair);
 	TSet<FUnrealObjectRef> UnresolvedRefs;
 	ComponentReader Reader(NetDriver, ObjectReferencesMap, UnresolvedRefs);
-	Reader.ApplyComponentUpdate(ComponentUpdate, TargetObject, Channel, bIsHandover);
+	Reader.ApplyComponentUpdate(ComponentUpdate, TargetObject, Channel, bIsHandover, Predecoded);
 
 	// This is a temporary workaround, see UNR-841:
 	// If the update includes tearoff, close the channel and clean up the entity.
@@ -1441,8 +1638,10 @@ void USpatialReceiver::ApplyComponentUpdate(const Worker_ComponentUpdate& Compon
 	QueueIncomingRepUpdates(ChannelObjectPair, ObjectReferencesMap, UnresolvedRefs);
 }
 
-bool USpatialReceiver::ApplyRPC(UObject* TargetObject, UFunction* Function, const RPCPayload& Payload, const FString& SenderWorkerId, bool bApplyWithUnresolvedRefs /* = false */)
+bool USpatialReceiver::ApplyRPC(UObject* TargetObject, UFunction* Function, const RPCPayload& Payload, const FString& SenderWorkerId, bool bApplyWithUnresolvedRefs /* = false */, TSet<FUnrealObjectRef>* OutUnresolvedRefs /* = nullptr */)
 {
+	SPATIAL_TRACE_SCOPE_DETAIL(TEXT("ReceiveRPC"), TEXT("RPC"), FString::Printf(TEXT("%s on %s"), *Function->GetName(), *TargetObject->GetName()));
+
 	bool bApplied = false;
 
 	uint8* Parms = (uint8*)FMemory_Alloca(Function->ParmsSize);
@@ -1484,6 +1683,10 @@ bool USpatialReceiver::ApplyRPC(UObject* TargetObject, UFunction* Function, cons
 		TargetObject->ProcessEvent(Function, Parms);
 		bApplied = true;
 	}
+	else if (OutUnresolvedRefs != nullptr)
+	{
+		*OutUnresolvedRefs = MoveTemp(UnresolvedRefs);
+	}
 
 	// Destroy the parameters.
 	// warning: highly dependent on UObject::ProcessEvent freeing of parms!
@@ -1494,11 +1697,12 @@ bool USpatialReceiver::ApplyRPC(UObject* TargetObject, UFunction* Function, cons
 	return bApplied;
 }
 
-bool USpatialReceiver::ApplyRPC(const FPendingRPCParams& Params)
+bool USpatialReceiver::ApplyRPC(const FPendingRPCParams& Params, TSet<FUnrealObjectRef>& OutUnresolvedRefs)
 {
 	TWeakObjectPtr<UObject> TargetObjectWeakPtr = PackageMap->GetObjectFromUnrealObjectRef(Params.ObjectRef);
 	if (!TargetObjectWeakPtr.IsValid())
 	{
+		OutUnresolvedRefs.Add(Params.ObjectRef);
 		return false;
 	}
 
@@ -1510,14 +1714,14 @@ bool USpatialReceiver::ApplyRPC(const FPendingRPCParams& Params)
 	}
 
 	bool bApplyWithUnresolvedRefs = false;
-	const float TimeDiff = (FDateTime::Now() - Params.QueuedTimestamp).GetTotalSeconds();
+	const float TimeDiff = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Params.QueuedCycles);
 	if (GetDefault<USpatialGDKSettings>()->QueuedIncomingRPCWaitTime < TimeDiff)
 	{
 		UE_LOG(LogSpatialReceiver, Warning, TEXT("Executing RPC %s::%s with unresolved references after %f seconds of queueing"), *TargetObjectWeakPtr->GetName(), *Function->GetName(), TimeDiff);
 		bApplyWithUnresolvedRefs = true;
 	}
 
-	return ApplyRPC(TargetObjectWeakPtr.Get(), Function, Params.Payload, FString{}, bApplyWithUnresolvedRefs);
+	return ApplyRPC(TargetObjectWeakPtr.Get(), Function, Params.Payload, FString{}, bApplyWithUnresolvedRefs, &OutUnresolvedRefs);
 }
 
 void USpatialReceiver::OnReserveEntityIdsResponse(const Worker_ReserveEntityIdsResponseOp& Op)
@@ -1655,7 +1859,7 @@ void USpatialReceiver::ProcessQueuedActorRPCsOnEntityCreation(AActor* Actor, RPC
 	for (auto& RPC : QueuedRPCs.RPCs)
 	{
 		UFunction* Function = Info.RPCs[RPC.Index];
-		const FRPCInfo& RPCInfo = ClassInfoManager->GetRPCInfo(Actor, Function);
+		const FRPCInfo& RPCInfo = Info.RPCInfos[RPC.Index];
 		const FUnrealObjectRef ObjectRef = PackageMap->GetUnrealObjectRefFromObject(Actor);
 		check(ObjectRef != FUnrealObjectRef::UNRESOLVED_OBJECT_REF);
 
@@ -1667,7 +1871,7 @@ void USpatialReceiver::ProcessQueuedActorRPCsOnEntityCreation(AActor* Actor, RPC
 			}
 		}
 
-		QueueIncomingRPC(MakeUnique<FPendingRPCParams>(ObjectRef, MoveTemp(RPC)));
+		QueueIncomingRPC(FPendingRPCParams(ObjectRef, MoveTemp(RPC)));
 	}
 }
 
@@ -1705,9 +1909,9 @@ void USpatialReceiver::QueueIncomingRepUpdates(FChannelObjectPair ChannelObjectP
 	}
 }
 
-void USpatialReceiver::QueueIncomingRPC(FPendingRPCParamsPtr Params)
+void USpatialReceiver::QueueIncomingRPC(FPendingRPCParams&& Params)
 {
-	TWeakObjectPtr<UObject> TargetObjectWeakPtr = PackageMap->GetObjectFromUnrealObjectRef(Params->ObjectRef);
+	TWeakObjectPtr<UObject> TargetObjectWeakPtr = PackageMap->GetObjectFromUnrealObjectRef(Params.ObjectRef);
 	if (!TargetObjectWeakPtr.IsValid())
 	{
 		UE_LOG(LogSpatialReceiver, Verbose, TEXT("The object has been deleted, dropping the RPC"));
@@ -1716,8 +1920,7 @@ void USpatialReceiver::QueueIncomingRPC(FPendingRPCParamsPtr Params)
 
 	UObject* TargetObject = TargetObjectWeakPtr.Get();
 	const FClassInfo& ClassInfo = ClassInfoManager->GetOrCreateClassInfoByObject(TargetObject);
-	UFunction* Function = ClassInfo.RPCs[Params->Payload.Index];
-	const FRPCInfo& RPCInfo = ClassInfoManager->GetRPCInfo(TargetObject, Function);
+	const FRPCInfo& RPCInfo = ClassInfo.RPCInfos[Params.Payload.Index];
 	ESchemaComponentType Type = RPCInfo.Type;
 
 	IncomingRPCs.QueueRPC(MoveTemp(Params), Type);
@@ -1730,8 +1933,7 @@ void USpatialReceiver::ResolvePendingOperations_Internal(UObject* Object, const
 	Sender->ResolveOutgoingOperations(Object, /* bIsHandover */ false);
 	Sender->ResolveOutgoingOperations(Object, /* bIsHandover */ true);
 	ResolveIncomingOperations(Object, ObjectRef);
-	// TODO: UNR-1650 We're trying to resolve all queues, which introduces more overhead.
-	ResolveIncomingRPCs();
+	ResolveIncomingRPCs(ObjectRef);
 }
 
 void USpatialReceiver::ResolveIncomingOperations(UObject* Object, const FUnrealObjectRef& ObjectRef)
@@ -1790,11 +1992,25 @@ void USpatialReceiver::ResolveIncomingOperations(UObject* Object, const FUnrealO
 	IncomingRefsMap.Remove(ObjectRef);
 }
 
-void USpatialReceiver::ResolveIncomingRPCs()
+void USpatialReceiver::ResolveIncomingRPCs(const FUnrealObjectRef& ObjectRef)
 {
-	FProcessRPCDelegate Delegate;
+	FProcessRPCWithDependenciesDelegate Delegate;
+	Delegate.BindUObject(this, &USpatialReceiver::ApplyRPC);
+	IncomingRPCs.ProcessRPCsWaitingForEntity(ObjectRef.Entity, Delegate);
+}
+
+void USpatialReceiver::ProcessTimedOutIncomingRPCs()
+{
+	const uint64 WaitCycles = static_cast<uint64>(GetDefault<USpatialGDKSettings>()->QueuedIncomingRPCWaitTime / FPlatformTime::GetSecondsPerCycle64());
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+	if (NowCycles <= WaitCycles)
+	{
+		return;
+	}
+
+	FProcessRPCWithDependenciesDelegate Delegate;
 	Delegate.BindUObject(this, &USpatialReceiver::ApplyRPC);
-	IncomingRPCs.ProcessRPCs(Delegate);
+	IncomingRPCs.ProcessRPCsQueuedBefore(NowCycles - WaitCycles, Delegate);
 }
 
 void USpatialReceiver::ResolveObjectReferences(FRepLayout& RepLayout, UObject* ReplicatedObject, FObjectReferencesMap& ObjectReferencesMap, uint8* RESTRICT StoredData, uint8* RESTRICT Data, int32 MaxAbsOffset, TArray<UProperty*>& RepNotifies, bool& bOutSomeObjectsWereMapped, bool& bOutStillHasUnresolved)
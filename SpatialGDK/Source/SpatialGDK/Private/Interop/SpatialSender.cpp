@@ -30,6 +30,7 @@
 #include "Utils/RepLayoutUtils.h"
 #include "Utils/SpatialActorUtils.h"
 #include "Utils/SpatialMetrics.h"
+#include "Utils/SpatialTraceRecorder.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialSender);
 
@@ -68,6 +69,8 @@ void USpatialSender::Init(USpatialNetDriver* InNetDriver, FTimerManager* InTimer
 	ClassInfoManager = InNetDriver->ClassInfoManager;
 	ActorGroupManager = InNetDriver->ActorGroupManager;
 	TimerManager = InTimerManager;
+
+	OutgoingRPCs.Init();
 }
 
 Worker_RequestId USpatialSender::CreateEntity(USpatialActorChannel* Channel)
@@ -765,7 +768,9 @@ bool USpatialSender::SendRPC(const FPendingRPCParams& Params)
 	const FClassInfo& ClassInfo = ClassInfoManager->GetOrCreateClassInfoByObject(TargetObject);
 	UFunction* Function = ClassInfo.RPCs[Params.Payload.Index];
 
-	const FRPCInfo& RPCInfo = ClassInfoManager->GetRPCInfo(TargetObject, Function);
+	SPATIAL_TRACE_SCOPE_DETAIL(TEXT("SendRPC"), TEXT("RPC"), FString::Printf(TEXT("%s on %s"), *Function->GetName(), *TargetObject->GetName()));
+
+	const FRPCInfo& RPCInfo = ClassInfo.RPCInfos[Params.Payload.Index];
 
 	if (Channel->bCreatingNewEntity)
 	{
@@ -1121,9 +1126,9 @@ void USpatialSender::QueueOutgoingUpdate(USpatialActorChannel* DependentChannel,
 	}
 }
 
-void USpatialSender::QueueOutgoingRPC(FPendingRPCParamsPtr Params)
+void USpatialSender::QueueOutgoingRPC(FPendingRPCParams&& Params)
 {
-	TWeakObjectPtr<UObject> TargetObjectWeakPtr = PackageMap->GetObjectFromUnrealObjectRef(Params->ObjectRef);
+	TWeakObjectPtr<UObject> TargetObjectWeakPtr = PackageMap->GetObjectFromUnrealObjectRef(Params.ObjectRef);
 	if (!TargetObjectWeakPtr.IsValid())
 	{
 		// Target object was destroyed before the RPC could be (re)sent
@@ -1132,9 +1137,7 @@ void USpatialSender::QueueOutgoingRPC(FPendingRPCParamsPtr Params)
 	UObject* TargetObject = TargetObjectWeakPtr.Get();
 
 	const FClassInfo& ClassInfo = ClassInfoManager->GetOrCreateClassInfoByObject(TargetObject);
-	UFunction* Function = ClassInfo.RPCs[Params->Payload.Index];
-
-	const FRPCInfo& RPCInfo = ClassInfoManager->GetRPCInfo(TargetObject, Function);
+	const FRPCInfo& RPCInfo = ClassInfo.RPCInfos[Params.Payload.Index];
 
 	const FUnrealObjectRef& TargetObjectRef = PackageMap->GetUnrealObjectRefFromObject(TargetObject);
 	OutgoingRPCs.QueueRPC(MoveTemp(Params), RPCInfo.Type);
@@ -1399,22 +1402,21 @@ void USpatialSender::UpdateInterestComponent(AActor* Actor)
 	Connection->SendComponentUpdate(EntityId, &Update);
 }
 
-void USpatialSender::ProcessRPC(FPendingRPCParamsPtr Params)
+void USpatialSender::ProcessRPC(FPendingRPCParams&& Params)
 {
-	TWeakObjectPtr<UObject> TargetObject = PackageMap->GetObjectFromUnrealObjectRef(Params->ObjectRef);
+	TWeakObjectPtr<UObject> TargetObject = PackageMap->GetObjectFromUnrealObjectRef(Params.ObjectRef);
 	if (!TargetObject.IsValid())
 	{
 		// Target object was destroyed before the RPC could be (re)sent
 		return;
 	}
 	const FClassInfo& ClassInfo = ClassInfoManager->GetOrCreateClassInfoByObject(TargetObject.Get());
-	UFunction* Function = ClassInfo.RPCs[Params->Payload.Index];
-	const FRPCInfo& RPCInfo = ClassInfoManager->GetRPCInfo(TargetObject.Get(), Function);
+	const FRPCInfo& RPCInfo = ClassInfo.RPCInfos[Params.Payload.Index];
 
 	bool bRPCProcessed = false;
-	if (!OutgoingRPCs.ObjectHasRPCsQueuedOfType(Params->ObjectRef.Entity, RPCInfo.Type))
+	if (!OutgoingRPCs.ObjectHasRPCsQueuedOfType(Params.ObjectRef.Entity, RPCInfo.Type))
 	{
-		if (SendRPC(*Params))
+		if (SendRPC(Params))
 		{
 			bRPCProcessed = true;
 		}
@@ -13,11 +13,25 @@
 
 Worker_Authority USpatialStaticComponentView::GetAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
 {
-	if (TMap<Worker_ComponentId, Worker_Authority>* ComponentAuthorityMap = EntityComponentAuthorityMap.Find(EntityId))
+	if (FEntityRecord* Record = FindEntityRecord(EntityId))
 	{
-		if (Worker_Authority* Authority = ComponentAuthorityMap->Find(ComponentId))
+		const int32 WellKnownIndex = GetWellKnownComponentIndex(ComponentId);
+		if (WellKnownIndex != INDEX_NONE)
 		{
-			return *Authority;
+			const uint32 Bit = 1u << WellKnownIndex;
+			if (Record->AuthorityBits & Bit)
+			{
+				return WORKER_AUTHORITY_AUTHORITATIVE;
+			}
+			return (Record->AuthorityLossImminentBits & Bit) ? WORKER_AUTHORITY_AUTHORITY_LOSS_IMMINENT : WORKER_AUTHORITY_NOT_AUTHORITATIVE;
+		}
+
+		for (const TPair<Worker_ComponentId, Worker_Authority>& Authority : Record->OtherAuthority)
+		{
+			if (Authority.Key == ComponentId)
+			{
+				return Authority.Value;
+			}
 		}
 	}
 
@@ -32,9 +46,15 @@ bool USpatialStaticComponentView::HasAuthority(Worker_EntityId EntityId, Worker_
 
 bool USpatialStaticComponentView::HasComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
 {
-	if (auto* EntityComponentStorage = EntityComponentMap.Find(EntityId))
+	if (FEntityRecord* Record = FindEntityRecord(EntityId))
 	{
-		return EntityComponentStorage->Contains(ComponentId);
+		const int32 WellKnownIndex = GetWellKnownComponentIndex(ComponentId);
+		if (WellKnownIndex != INDEX_NONE)
+		{
+			return (Record->ComponentBits & (1u << WellKnownIndex)) != 0;
+		}
+
+		return Record->OtherComponents.Contains(ComponentId);
 	}
 
 	return false;
@@ -42,6 +62,22 @@ bool USpatialStaticComponentView::HasComponent(Worker_EntityId EntityId, Worker_
 
 void USpatialStaticComponentView::OnAddComponent(const Worker_AddComponentOp& Op)
 {
+	FEntityRecord& Record = FindOrAddEntityRecord(Op.entity_id);
+
+	const int32 WellKnownIndex = GetWellKnownComponentIndex(Op.data.component_id);
+	if (WellKnownIndex == INDEX_NONE)
+	{
+		// Component is not hand written, but we still want to know the existence of it on this entity.
+		Record.OtherComponents.AddUnique(Op.data.component_id);
+		return;
+	}
+
+	Record.ComponentBits |= 1u << WellKnownIndex;
+	if (WellKnownIndex >= NumWellKnownComponentsWithData)
+	{
+		return;
+	}
+
 	TUniquePtr<SpatialGDK::ComponentStorageBase> Data;
 	switch (Op.data.component_id)
 	{
@@ -81,30 +117,59 @@ void USpatialStaticComponentView::OnAddComponent(const Worker_AddComponentOp& Op
 	case SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID:
 		Data = MakeUnique<SpatialGDK::ComponentStorage<SpatialGDK::ServerRPCEndpoint>>(Op.data);
 		break;
-	default:
-		// Component is not hand written, but we still want to know the existence of it on this entity.
-		Data = nullptr;
 	}
-	EntityComponentMap.FindOrAdd(Op.entity_id).FindOrAdd(Op.data.component_id) = std::move(Data);
+	Record.Data[WellKnownIndex] = MoveTemp(Data);
 }
 
 void USpatialStaticComponentView::OnRemoveComponent(const Worker_RemoveComponentOp& Op)
 {
-	if (auto* ComponentMap = EntityComponentMap.Find(Op.entity_id))
+	FEntityRecord* Record = FindEntityRecord(Op.entity_id);
+	if (Record == nullptr)
 	{
-		ComponentMap->Remove(Op.component_id);
+		return;
 	}
 
-	if (auto* AuthorityMap = EntityComponentAuthorityMap.Find(Op.entity_id))
+	const int32 WellKnownIndex = GetWellKnownComponentIndex(Op.component_id);
+	if (WellKnownIndex != INDEX_NONE)
 	{
-		AuthorityMap->Remove(Op.component_id);
+		const uint32 Mask = ~(1u << WellKnownIndex);
+		Record->ComponentBits &= Mask;
+		Record->AuthorityBits &= Mask;
+		Record->AuthorityLossImminentBits &= Mask;
+		if (WellKnownIndex < NumWellKnownComponentsWithData)
+		{
+			Record->Data[WellKnownIndex].Reset();
+		}
+		return;
 	}
+
+	Record->OtherComponents.RemoveSingleSwap(Op.component_id);
+	Record->OtherAuthority.RemoveAllSwap([&Op](const TPair<Worker_ComponentId, Worker_Authority>& Authority)
+	{
+		return Authority.Key == Op.component_id;
+	});
 }
 
 void USpatialStaticComponentView::OnRemoveEntity(Worker_EntityId EntityId)
 {
-	EntityComponentMap.Remove(EntityId);
-	EntityComponentAuthorityMap.Remove(EntityId);
+	int32 RecordIndex = INDEX_NONE;
+	if (!EntityRecordIndices.RemoveAndCopyValue(EntityId, RecordIndex))
+	{
+		return;
+	}
+
+	FEntityRecord& Record = EntityRecords[RecordIndex];
+	Record.ComponentBits = 0;
+	Record.AuthorityBits = 0;
+	Record.AuthorityLossImminentBits = 0;
+	for (TUniquePtr<SpatialGDK::ComponentStorageBase>& Data : Record.Data)
+	{
+		Data.Reset();
+	}
+	Record.OtherComponents.Reset();
+	Record.OtherAuthority.Reset();
+
+	FreeEntityRecords.Add(RecordIndex);
 }
 
 void USpatialStaticComponentView::OnComponentUpdate(const Worker_ComponentUpdateOp& Op)
@@ -136,5 +201,45 @@ void USpatialStaticComponentView::OnComponentUpdate(const Worker_ComponentUpdate
 
 void USpatialStaticComponentView::OnAuthorityChange(const Worker_AuthorityChangeOp& Op)
 {
-	EntityComponentAuthorityMap.FindOrAdd(Op.entity_id).FindOrAdd(Op.component_id) = (Worker_Authority)Op.authority;
+	FEntityRecord& Record = FindOrAddEntityRecord(Op.entity_id);
+
+	const int32 WellKnownIndex = GetWellKnownComponentIndex(Op.component_id);
+	if (WellKnownIndex != INDEX_NONE)
+	{
+		const uint32 Bit = 1u << WellKnownIndex;
+		Record.AuthorityBits &= ~Bit;
+		Record.AuthorityLossImminentBits &= ~Bit;
+		if (Op.authority == WORKER_AUTHORITY_AUTHORITATIVE)
+		{
+			Record.AuthorityBits |= Bit;
+		}
+		else if (Op.authority == WORKER_AUTHORITY_AUTHORITY_LOSS_IMMINENT)
+		{
+			Record.AuthorityLossImminentBits |= Bit;
+		}
+		return;
+	}
+
+	for (TPair<Worker_ComponentId, Worker_Authority>& Authority : Record.OtherAuthority)
+	{
+		if (Authority.Key == Op.component_id)
+		{
+			Authority.Value = (Worker_Authority)Op.authority;
+			return;
+		}
+	}
+
+	Record.OtherAuthority.Emplace(Op.component_id, (Worker_Authority)Op.authority);
+}
+
+USpatialStaticComponentView::FEntityRecord& USpatialStaticComponentView::FindOrAddEntityRecord(Worker_EntityId EntityId)
+{
+	if (int32* RecordIndex = EntityRecordIndices.Find(EntityId))
+	{
+		return EntityRecords[*RecordIndex];
+	}
+
+	const int32 RecordIndex = FreeEntityRecords.Num() > 0 ? FreeEntityRecords.Pop(/*bAllowShrinking =*/ false) : EntityRecords.AddDefaulted();
+	EntityRecordIndices.Add(EntityId, RecordIndex);
+	return EntityRecords[RecordIndex];
 }
@@ -20,9 +20,19 @@ USpatialGDKSettings::USpatialGDKSettings(const FObjectInitializer& ObjectInitial
 	, ActorReplicationRateLimit(0)
 	, EntityCreationRateLimit(0)
 	, OpsUpdateRate(1000.0f)
+	, bEventDrivenOpsUpdate(false)
+	, EventDrivenOpsUpdateMaxIdleTime(0.05f)
+	, EventDrivenOpListTimeoutMs(1)
+	, OpsProcessingBudgetMs(0.0f)
+	, bPredecodeComponentUpdates(false)
+	, bFoldReceivedComponentUpdates(false)
+	, LogForwardingMaxLinesPerSecondPerCategory(0.0f)
+	, LogForwardingMaxBurstLinesPerCategory(100.0f)
 	, bEnableHandover(true)
 	, MaxNetCullDistanceSquared(900000000.0f) // Set to twice the default Actor NetCullDistanceSquared (300m)
 	, QueuedIncomingRPCWaitTime(1.0f)
+	, bBatchActorSpawning(false)
+	, ActorBeginPlayBudgetMs(0.0f)
 	, bUsingQBI(true)
 	, PositionUpdateFrequency(1.0f)
 	, PositionDistanceThreshold(100.0f) // 1m (100cm)
@@ -35,6 +45,7 @@ USpatialGDKSettings::USpatialGDKSettings(const FObjectInitializer& ObjectInitial
 	, MaxDynamicallyAttachedSubobjectsPerClass(3)
 	, bEnableServerQBI(bUsingQBI)
 	, bPackRPCs(true)
+	, bCoalesceOutgoingComponentUpdates(false)
 	, bUseDevelopmentAuthenticationFlow(false)
 	, DefaultWorkerType(FWorkerType(SpatialConstants::DefaultServerWorkerType))
 	, bEnableOffloading(false)
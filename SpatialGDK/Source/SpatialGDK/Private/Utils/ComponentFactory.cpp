@@ -16,6 +16,86 @@
 #include "Utils/RepLayoutUtils.h"
 #include "Utils/InterestFactory.h"
 
+namespace
+{
+	static_assert(sizeof(bool) == sizeof(uint8), "Arrays of bools are written as schema bool lists directly.");
+
+	template <typename SchemaType, typename ElementType>
+	void WidenListElements(const uint8* Elements, int32 Count, TArray<SchemaType, TInlineAllocator<64>>& OutValues)
+	{
+		OutValues.SetNumUninitialized(Count);
+		const ElementType* TypedElements = reinterpret_cast<const ElementType*>(Elements);
+		for (int32 i = 0; i < Count; i++)
+		{
+			OutValues[i] = (SchemaType)TypedElements[i];
+		}
+	}
+
+	// Writes a non-empty array of primitive elements with a single list call. Elements that are narrower than their schema
+	// type are widened into a temporary buffer first. Returns false if the elements have to be written one by one.
+	bool AddPrimitiveList(Schema_Object* Object, Schema_FieldId FieldId, SpatialGDK::ESchemaPropertyOp Op, const uint8* Elements, int32 Count)
+	{
+		using SpatialGDK::ESchemaPropertyOp;
+
+		switch (Op)
+		{
+		case ESchemaPropertyOp::Bool:
+			Schema_AddBoolList(Object, FieldId, Elements, Count);
+			return true;
+		case ESchemaPropertyOp::Float:
+			Schema_AddFloatList(Object, FieldId, reinterpret_cast<const float*>(Elements), Count);
+			return true;
+		case ESchemaPropertyOp::Double:
+			Schema_AddDoubleList(Object, FieldId, reinterpret_cast<const double*>(Elements), Count);
+			return true;
+		case ESchemaPropertyOp::Int32:
+			Schema_AddInt32List(Object, FieldId, reinterpret_cast<const int32*>(Elements), Count);
+			return true;
+		case ESchemaPropertyOp::Int64:
+			Schema_AddInt64List(Object, FieldId, reinterpret_cast<const int64*>(Elements), Count);
+			return true;
+		case ESchemaPropertyOp::UInt32:
+			Schema_AddUint32List(Object, FieldId, reinterpret_cast<const uint32*>(Elements), Count);
+			return true;
+		case ESchemaPropertyOp::UInt64:
+			Schema_AddUint64List(Object, FieldId, reinterpret_cast<const uint64*>(Elements), Count);
+			return true;
+		case ESchemaPropertyOp::Int8:
+		case ESchemaPropertyOp::Int16:
+		{
+			TArray<int32, TInlineAllocator<64>> Values;
+			if (Op == ESchemaPropertyOp::Int8)
+			{
+				WidenListElements<int32, int8>(Elements, Count, Values);
+			}
+			else
+			{
+				WidenListElements<int32, int16>(Elements, Count, Values);
+			}
+			Schema_AddInt32List(Object, FieldId, Values.GetData(), Count);
+			return true;
+		}
+		case ESchemaPropertyOp::Byte:
+		case ESchemaPropertyOp::UInt16:
+		{
+			TArray<uint32, TInlineAllocator<64>> Values;
+			if (Op == ESchemaPropertyOp::Byte)
+			{
+				WidenListElements<uint32, uint8>(Elements, Count, Values);
+			}
+			else
+			{
+				WidenListElements<uint32, uint16>(Elements, Count, Values);
+			}
+			Schema_AddUint32List(Object, FieldId, Values.GetData(), Count);
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+}
+
 namespace SpatialGDK
 {
 
@@ -28,13 +108,15 @@ ComponentFactory::ComponentFactory(FUnresolvedObjectsMap& RepUnresolvedObjectsMa
 	, bInterestHasChanged(bInterestDirty)
 { }
 
-bool ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds /*= nullptr*/)
+bool ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FClassInfo& Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds /*= nullptr*/)
 {
 	bool bWroteSomething = false;
 
 	// Populate the replicated data component updates from the replicated property changelist.
 	if (Changes.RepChanged.Num() > 0)
 	{
+		check(Info.RepWritePlan.Num() == Changes.RepLayout.Cmds.Num());
+
 		FChangelistIterator ChangelistIterator(Changes.RepChanged, 0);
 		FRepHandleIterator HandleIterator(ChangelistIterator, Changes.RepLayout.Cmds, Changes.RepLayout.BaseHandleToCmdIndex, 0, 1, 0, Changes.RepLayout.Cmds.Num() - 1);
 		while (HandleIterator.NextHandle())
@@ -69,7 +151,7 @@ bool ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject*
 
 				if (!bProcessedFastArrayProperty)
 				{
-					AddProperty(ComponentObject, HandleIterator.Handle, Cmd.Property, Data, UnresolvedObjects, ClearedIds);
+					AddProperty(ComponentObject, HandleIterator.Handle, Info.RepWritePlan[HandleIterator.CmdIndex], Data, UnresolvedObjects, ClearedIds);
 				}
 
 				if (UnresolvedObjects.Num() == 0)
@@ -114,7 +196,7 @@ bool ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject,
 		const uint8* Data = (uint8*)Object + PropertyInfo.Offset;
 		FUnresolvedObjectsSet UnresolvedObjects;
 
-		AddProperty(ComponentObject, ChangedHandle, PropertyInfo.Property, Data, UnresolvedObjects, ClearedIds);
+		AddProperty(ComponentObject, ChangedHandle, PropertyInfo.SchemaInfo, Data, UnresolvedObjects, ClearedIds);
 
 		if (UnresolvedObjects.Num() == 0)
 		{
@@ -136,15 +218,43 @@ bool ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject,
 	return bWroteSomething;
 }
 
-void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data, TSet<TWeakObjectPtr<const UObject>>& UnresolvedObjects, TArray<Schema_FieldId>* ClearedIds)
+void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId, const FSchemaPropertyInfo& SchemaInfo, const uint8* Data, FUnresolvedObjectsSet& UnresolvedObjects, TArray<Schema_FieldId>* ClearedIds)
+{
+	if (SchemaInfo.Op == ESchemaPropertyOp::Array)
+	{
+		FScriptArrayHelper ArrayHelper(static_cast<UArrayProperty*>(SchemaInfo.Property), Data);
+		if (ArrayHelper.Num() == 0 || !AddPrimitiveList(Object, FieldId, SchemaInfo.InnerOp, ArrayHelper.GetRawPtr(0), ArrayHelper.Num()))
+		{
+			for (int i = 0; i < ArrayHelper.Num(); i++)
+			{
+				AddValue(Object, FieldId, SchemaInfo.InnerOp, SchemaInfo.InnerProperty, ArrayHelper.GetRawPtr(i), UnresolvedObjects);
+			}
+		}
+
+		if (ArrayHelper.Num() == 0 && ClearedIds)
+		{
+			ClearedIds->Add(FieldId);
+		}
+	}
+	else
+	{
+		AddValue(Object, FieldId, SchemaInfo.Op, SchemaInfo.Property, Data, UnresolvedObjects);
+	}
+}
+
+void ComponentFactory::AddValue(Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op, UProperty* Property, const uint8* Data, FUnresolvedObjectsSet& UnresolvedObjects)
 {
-	if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+	// The ops were resolved from the property classes when the class info was created, so the casts here are static.
+	switch (Op)
 	{
-		UScriptStruct* Struct = StructProperty->Struct;
+	case ESchemaPropertyOp::NetSerializeStruct:
+	case ESchemaPropertyOp::RepLayoutStruct:
+	{
+		UScriptStruct* Struct = static_cast<UStructProperty*>(Property)->Struct;
 		FSpatialNetBitWriter ValueDataWriter(PackageMap, UnresolvedObjects);
 		bool bHasUnmapped = false;
 
-		if (Struct->StructFlags & STRUCT_NetSerializeNative)
+		if (Op == ESchemaPropertyOp::NetSerializeStruct)
 		{
 			UScriptStruct::ICppStructOps* CppStructOps = Struct->GetCppStructOps();
 			check(CppStructOps); // else should not have STRUCT_NetSerializeNative
@@ -169,53 +279,48 @@ void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId
 		}
 
 		AddBytesToSchema(Object, FieldId, ValueDataWriter);
-	}
-	else if (UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property))
-	{
-		Schema_AddBool(Object, FieldId, (uint8)BoolProperty->GetPropertyValue(Data));
-	}
-	else if (UFloatProperty* FloatProperty = Cast<UFloatProperty>(Property))
-	{
-		Schema_AddFloat(Object, FieldId, FloatProperty->GetPropertyValue(Data));
-	}
-	else if (UDoubleProperty* DoubleProperty = Cast<UDoubleProperty>(Property))
-	{
-		Schema_AddDouble(Object, FieldId, DoubleProperty->GetPropertyValue(Data));
-	}
-	else if (UInt8Property* Int8Property = Cast<UInt8Property>(Property))
-	{
-		Schema_AddInt32(Object, FieldId, (int32)Int8Property->GetPropertyValue(Data));
-	}
-	else if (UInt16Property* Int16Property = Cast<UInt16Property>(Property))
-	{
-		Schema_AddInt32(Object, FieldId, (int32)Int16Property->GetPropertyValue(Data));
-	}
-	else if (UIntProperty* IntProperty = Cast<UIntProperty>(Property))
-	{
-		Schema_AddInt32(Object, FieldId, IntProperty->GetPropertyValue(Data));
-	}
-	else if (UInt64Property* Int64Property = Cast<UInt64Property>(Property))
-	{
-		Schema_AddInt64(Object, FieldId, Int64Property->GetPropertyValue(Data));
-	}
-	else if (UByteProperty* ByteProperty = Cast<UByteProperty>(Property))
-	{
-		Schema_AddUint32(Object, FieldId, (uint32)ByteProperty->GetPropertyValue(Data));
-	}
-	else if (UUInt16Property* UInt16Property = Cast<UUInt16Property>(Property))
-	{
-		Schema_AddUint32(Object, FieldId, (uint32)UInt16Property->GetPropertyValue(Data));
-	}
-	else if (UUInt32Property* UInt32Property = Cast<UUInt32Property>(Property))
-	{
-		Schema_AddUint32(Object, FieldId, UInt32Property->GetPropertyValue(Data));
-	}
-	else if (UUInt64Property* UInt64Property = Cast<UUInt64Property>(Property))
-	{
-		Schema_AddUint64(Object, FieldId, UInt64Property->GetPropertyValue(Data));
-	}
-	else if (UObjectPropertyBase* ObjectProperty = Cast<UObjectPropertyBase>(Property))
-	{
+		break;
+	}
+	case ESchemaPropertyOp::Bool:
+		Schema_AddBool(Object, FieldId, (uint8)static_cast<UBoolProperty*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Float:
+		Schema_AddFloat(Object, FieldId, static_cast<UFloatProperty*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Double:
+		Schema_AddDouble(Object, FieldId, static_cast<UDoubleProperty*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Int8:
+		Schema_AddInt32(Object, FieldId, (int32)static_cast<UInt8Property*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Int16:
+		Schema_AddInt32(Object, FieldId, (int32)static_cast<UInt16Property*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Int32:
+		Schema_AddInt32(Object, FieldId, static_cast<UIntProperty*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Int64:
+		Schema_AddInt64(Object, FieldId, static_cast<UInt64Property*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Byte:
+		Schema_AddUint32(Object, FieldId, (uint32)static_cast<UByteProperty*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::UInt16:
+		Schema_AddUint32(Object, FieldId, (uint32)static_cast<UUInt16Property*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::UInt32:
+		Schema_AddUint32(Object, FieldId, static_cast<UUInt32Property*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::UInt64:
+		Schema_AddUint64(Object, FieldId, static_cast<UUInt64Property*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::SmallEnum:
+		// Property is the enum's underlying property.
+		Schema_AddUint32(Object, FieldId, (uint32)static_cast<UNumericProperty*>(Property)->GetUnsignedIntPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Object:
+	{
+		UObjectPropertyBase* ObjectProperty = static_cast<UObjectPropertyBase*>(Property);
 		FUnrealObjectRef ObjectRef = FUnrealObjectRef::NULL_OBJECT_REF;
 
 		UObject* ObjectValue = ObjectProperty->GetObjectPropertyValue(Data);
@@ -273,50 +378,23 @@ void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId
 		}
 
 		AddObjectRefToSchema(Object, FieldId, ObjectRef);
-	}
-	else if (UNameProperty* NameProperty = Cast<UNameProperty>(Property))
-	{
-		AddStringToSchema(Object, FieldId, NameProperty->GetPropertyValue(Data).ToString());
-	}
-	else if (UStrProperty* StrProperty = Cast<UStrProperty>(Property))
-	{
-		AddStringToSchema(Object, FieldId, StrProperty->GetPropertyValue(Data));
-	}
-	else if (UTextProperty* TextProperty = Cast<UTextProperty>(Property))
-	{
-		AddStringToSchema(Object, FieldId, TextProperty->GetPropertyValue(Data).ToString());
-	}
-	else if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property))
-	{
-		FScriptArrayHelper ArrayHelper(ArrayProperty, Data);
-		for (int i = 0; i < ArrayHelper.Num(); i++)
-		{
-			AddProperty(Object, FieldId, ArrayProperty->Inner, ArrayHelper.GetRawPtr(i), UnresolvedObjects, ClearedIds);
-		}
-
-		if (ArrayHelper.Num() == 0 && ClearedIds)
-		{
-			ClearedIds->Add(FieldId);
-		}
-	}
-	else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
-	{
-		if (EnumProperty->ElementSize < 4)
-		{
-			Schema_AddUint32(Object, FieldId, (uint32)EnumProperty->GetUnderlyingProperty()->GetUnsignedIntPropertyValue(Data));
-		}
-		else
-		{
-			AddProperty(Object, FieldId, EnumProperty->GetUnderlyingProperty(), Data, UnresolvedObjects, ClearedIds);
-		}
-	}
-	else if (Property->IsA<UDelegateProperty>() || Property->IsA<UMulticastDelegateProperty>() || Property->IsA<UInterfaceProperty>())
-	{
+		break;
+	}
+	case ESchemaPropertyOp::Name:
+		AddNameToSchema(Object, FieldId, static_cast<UNameProperty*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Str:
+		AddStringToSchema(Object, FieldId, static_cast<UStrProperty*>(Property)->GetPropertyValue(Data));
+		break;
+	case ESchemaPropertyOp::Text:
+		AddStringToSchema(Object, FieldId, static_cast<UTextProperty*>(Property)->GetPropertyValue(Data).ToString());
+		break;
+	case ESchemaPropertyOp::Ignored:
 		// These properties can be set to replicate, but won't serialize across the network.
-	}
-	else
-	{
+		break;
+	default:
 		checkf(false, TEXT("Tried to add unknown property in field %d"), FieldId);
+		break;
 	}
 }
 
@@ -326,12 +404,12 @@ TArray<Worker_ComponentData> ComponentFactory::CreateComponentDatas(UObject* Obj
 
 	if (Info.SchemaComponents[SCHEMA_Data] != SpatialConstants::INVALID_COMPONENT_ID)
 	{
-		ComponentDatas.Add(CreateComponentData(Info.SchemaComponents[SCHEMA_Data], Object, RepChangeState, SCHEMA_Data));
+		ComponentDatas.Add(CreateComponentData(Info.SchemaComponents[SCHEMA_Data], Object, Info, RepChangeState, SCHEMA_Data));
 	}
 
 	if (Info.SchemaComponents[SCHEMA_OwnerOnly] != SpatialConstants::INVALID_COMPONENT_ID)
 	{
-		ComponentDatas.Add(CreateComponentData(Info.SchemaComponents[SCHEMA_OwnerOnly], Object, RepChangeState, SCHEMA_OwnerOnly));
+		ComponentDatas.Add(CreateComponentData(Info.SchemaComponents[SCHEMA_OwnerOnly], Object, Info, RepChangeState, SCHEMA_OwnerOnly));
 	}
 
 	if (Info.SchemaComponents[SCHEMA_Handover] != SpatialConstants::INVALID_COMPONENT_ID)
@@ -342,7 +420,7 @@ TArray<Worker_ComponentData> ComponentFactory::CreateComponentDatas(UObject* Obj
 	return ComponentDatas;
 }
 
-Worker_ComponentData ComponentFactory::CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup)
+Worker_ComponentData ComponentFactory::CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FClassInfo& Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup)
 {
 	Worker_ComponentData ComponentData = {};
 	ComponentData.component_id = ComponentId;
@@ -351,7 +429,7 @@ Worker_ComponentData ComponentFactory::CreateComponentData(Worker_ComponentId Co
 
 	// We're currently ignoring ClearedId fields, which is problematic if the initial replicated state
 	// is different to what the default state is (the client will have the incorrect data). UNR:959
-	FillSchemaObject(ComponentObject, Object, Changes, PropertyGroup, true);
+	FillSchemaObject(ComponentObject, Object, Info, Changes, PropertyGroup, true);
 
 	return ComponentData;
 }
@@ -384,7 +462,7 @@ TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 		if (Info.SchemaComponents[SCHEMA_Data] != SpatialConstants::INVALID_COMPONENT_ID)
 		{
 			bool bWroteSomething = false;
-			Worker_ComponentUpdate MultiClientUpdate = CreateComponentUpdate(Info.SchemaComponents[SCHEMA_Data], Object, *RepChangeState, SCHEMA_Data, bWroteSomething);
+			Worker_ComponentUpdate MultiClientUpdate = CreateComponentUpdate(Info.SchemaComponents[SCHEMA_Data], Object, Info, *RepChangeState, SCHEMA_Data, bWroteSomething);
 			if (bWroteSomething)
 			{
 				ComponentUpdates.Add(MultiClientUpdate);
@@ -394,7 +472,7 @@ TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 		if (Info.SchemaComponents[SCHEMA_OwnerOnly] != SpatialConstants::INVALID_COMPONENT_ID)
 		{
 			bool bWroteSomething = false;
-			Worker_ComponentUpdate SingleClientUpdate = CreateComponentUpdate(Info.SchemaComponents[SCHEMA_OwnerOnly], Object, *RepChangeState, SCHEMA_OwnerOnly, bWroteSomething);
+			Worker_ComponentUpdate SingleClientUpdate = CreateComponentUpdate(Info.SchemaComponents[SCHEMA_OwnerOnly], Object, Info, *RepChangeState, SCHEMA_OwnerOnly, bWroteSomething);
 			if (bWroteSomething)
 			{
 				ComponentUpdates.Add(SingleClientUpdate);
@@ -425,7 +503,7 @@ TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 	return ComponentUpdates;
 }
 
-Worker_ComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool& bWroteSomething)
+Worker_ComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FClassInfo& Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool& bWroteSomething)
 {
 	Worker_ComponentUpdate ComponentUpdate = {};
 
@@ -435,7 +513,7 @@ Worker_ComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentI
 
 	TArray<Schema_FieldId> ClearedIds;
 
-	bWroteSomething = FillSchemaObject(ComponentObject, Object, Changes, PropertyGroup, false, &ClearedIds);
+	bWroteSomething = FillSchemaObject(ComponentObject, Object, Info, Changes, PropertyGroup, false, &ClearedIds);
 
 	for (Schema_FieldId Id : ClearedIds)
 	{
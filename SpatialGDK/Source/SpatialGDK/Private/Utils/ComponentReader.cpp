@@ -9,6 +9,7 @@
 
 #include "EngineClasses/SpatialFastArrayNetSerialize.h"
 #include "EngineClasses/SpatialNetBitReader.h"
+#include "Interop/Connection/SpatialWorkerConnection.h"
 #include "Interop/SpatialConditionMapFilter.h"
 #include "SpatialConstants.h"
 #include "Utils/SchemaUtils.h"
@@ -16,6 +17,188 @@
 
 DEFINE_LOG_CATEGORY(LogSpatialComponentReader);
 
+namespace
+{
+	// Most components have few enough updated fields to collect their IDs without allocating.
+	using FFieldIdArray = TArray<Schema_FieldId, TInlineAllocator<32>>;
+
+	// The schema types ComponentFactory writes each primitive op as.
+	SpatialGDK::EPredecodedFieldType GetPredecodedFieldType(SpatialGDK::ESchemaPropertyOp Op)
+	{
+		using SpatialGDK::EPredecodedFieldType;
+		using SpatialGDK::ESchemaPropertyOp;
+
+		switch (Op)
+		{
+		case ESchemaPropertyOp::Bool:
+			return EPredecodedFieldType::Bool;
+		case ESchemaPropertyOp::Float:
+			return EPredecodedFieldType::Float;
+		case ESchemaPropertyOp::Double:
+			return EPredecodedFieldType::Double;
+		case ESchemaPropertyOp::Int8:
+		case ESchemaPropertyOp::Int16:
+		case ESchemaPropertyOp::Int32:
+			return EPredecodedFieldType::Int32;
+		case ESchemaPropertyOp::Int64:
+			return EPredecodedFieldType::Int64;
+		case ESchemaPropertyOp::Byte:
+		case ESchemaPropertyOp::UInt16:
+		case ESchemaPropertyOp::UInt32:
+		case ESchemaPropertyOp::SmallEnum:
+			return EPredecodedFieldType::Uint32;
+		case ESchemaPropertyOp::UInt64:
+			return EPredecodedFieldType::Uint64;
+		default:
+			return EPredecodedFieldType::None;
+		}
+	}
+
+	SpatialGDK::FComponentDecodePlan CreateDecodePlan(const SpatialGDK::FRepLayoutReadPlan& ReadPlan)
+	{
+		SpatialGDK::FComponentDecodePlan Plan;
+
+		// Both are indexed by field ID.
+		Plan.SetNum(ReadPlan.Num());
+		for (int32 FieldId = 1; FieldId < ReadPlan.Num(); FieldId++)
+		{
+			const SpatialGDK::FSchemaPropertyInfo& SchemaInfo = ReadPlan[FieldId].SchemaInfo;
+			if (SchemaInfo.Op == SpatialGDK::ESchemaPropertyOp::Array)
+			{
+				// FFastArraySerializer arrays hold structs, so their inner op is never a primitive.
+				Plan[FieldId].Type = GetPredecodedFieldType(SchemaInfo.InnerOp);
+				Plan[FieldId].bIsList = true;
+			}
+			else
+			{
+				Plan[FieldId].Type = GetPredecodedFieldType(SchemaInfo.Op);
+			}
+		}
+
+		return Plan;
+	}
+
+	// Property is the property the op was resolved for, which for enums is the underlying property.
+	void ApplyPredecodedValue(SpatialGDK::ESchemaPropertyOp Op, UProperty* Property, uint8* Data, const SpatialGDK::FPredecodedValue& Value)
+	{
+		using SpatialGDK::ESchemaPropertyOp;
+
+		switch (Op)
+		{
+		case ESchemaPropertyOp::Bool:
+			static_cast<UBoolProperty*>(Property)->SetPropertyValue(Data, Value.UInt != 0);
+			break;
+		case ESchemaPropertyOp::Float:
+		case ESchemaPropertyOp::Double:
+			static_cast<UNumericProperty*>(Property)->SetFloatingPointPropertyValue(Data, Value.Double);
+			break;
+		case ESchemaPropertyOp::Int8:
+		case ESchemaPropertyOp::Int16:
+		case ESchemaPropertyOp::Int32:
+		case ESchemaPropertyOp::Int64:
+			static_cast<UNumericProperty*>(Property)->SetIntPropertyValue(Data, Value.Int);
+			break;
+		default:
+			static_cast<UNumericProperty*>(Property)->SetIntPropertyValue(Data, Value.UInt);
+			break;
+		}
+	}
+
+	template <typename ElementType, typename SchemaType>
+	void NarrowListElements(const TArray<SchemaType, TInlineAllocator<64>>& Values, uint8* Elements)
+	{
+		ElementType* TypedElements = reinterpret_cast<ElementType*>(Elements);
+		for (int32 i = 0; i < Values.Num(); i++)
+		{
+			TypedElements[i] = (ElementType)Values[i];
+		}
+	}
+
+	// Reads an array of primitive elements with a single list call, mirroring AddPrimitiveList in ComponentFactory.
+	// Returns false if the elements have to be read one by one.
+	bool ApplyPrimitiveList(const Schema_Object* Object, Schema_FieldId FieldId, SpatialGDK::ESchemaPropertyOp Op, FScriptArrayHelper& ArrayHelper)
+	{
+		using SpatialGDK::ESchemaPropertyOp;
+
+		switch (Op)
+		{
+		case ESchemaPropertyOp::Bool:
+		{
+			// Read through a buffer, since anything but 0 or 1 isn't a valid bool.
+			TArray<uint8, TInlineAllocator<64>> Values;
+			Values.SetNumUninitialized(Schema_GetBoolCount(Object, FieldId));
+			Schema_GetBoolList(Object, FieldId, Values.GetData());
+			ArrayHelper.Resize(Values.Num());
+			for (int32 i = 0; i < Values.Num(); i++)
+			{
+				*reinterpret_cast<bool*>(ArrayHelper.GetRawPtr(i)) = Values[i] != 0;
+			}
+			return true;
+		}
+		case ESchemaPropertyOp::Float:
+			ArrayHelper.Resize(Schema_GetFloatCount(Object, FieldId));
+			Schema_GetFloatList(Object, FieldId, reinterpret_cast<float*>(ArrayHelper.GetRawPtr(0)));
+			return true;
+		case ESchemaPropertyOp::Double:
+			ArrayHelper.Resize(Schema_GetDoubleCount(Object, FieldId));
+			Schema_GetDoubleList(Object, FieldId, reinterpret_cast<double*>(ArrayHelper.GetRawPtr(0)));
+			return true;
+		case ESchemaPropertyOp::Int32:
+			ArrayHelper.Resize(Schema_GetInt32Count(Object, FieldId));
+			Schema_GetInt32List(Object, FieldId, reinterpret_cast<int32*>(ArrayHelper.GetRawPtr(0)));
+			return true;
+		case ESchemaPropertyOp::Int64:
+			ArrayHelper.Resize(Schema_GetInt64Count(Object, FieldId));
+			Schema_GetInt64List(Object, FieldId, reinterpret_cast<int64*>(ArrayHelper.GetRawPtr(0)));
+			return true;
+		case ESchemaPropertyOp::UInt32:
+			ArrayHelper.Resize(Schema_GetUint32Count(Object, FieldId));
+			Schema_GetUint32List(Object, FieldId, reinterpret_cast<uint32*>(ArrayHelper.GetRawPtr(0)));
+			return true;
+		case ESchemaPropertyOp::UInt64:
+			ArrayHelper.Resize(Schema_GetUint64Count(Object, FieldId));
+			Schema_GetUint64List(Object, FieldId, reinterpret_cast<uint64*>(ArrayHelper.GetRawPtr(0)));
+			return true;
+		case ESchemaPropertyOp::Int8:
+		case ESchemaPropertyOp::Int16:
+		{
+			TArray<int32, TInlineAllocator<64>> Values;
+			Values.SetNumUninitialized(Schema_GetInt32Count(Object, FieldId));
+			Schema_GetInt32List(Object, FieldId, Values.GetData());
+			ArrayHelper.Resize(Values.Num());
+			if (Op == ESchemaPropertyOp::Int8)
+			{
+				NarrowListElements<int8>(Values, ArrayHelper.GetRawPtr(0));
+			}
+			else
+			{
+				NarrowListElements<int16>(Values, ArrayHelper.GetRawPtr(0));
+			}
+			return true;
+		}
+		case ESchemaPropertyOp::Byte:
+		case ESchemaPropertyOp::UInt16:
+		{
+			TArray<uint32, TInlineAllocator<64>> Values;
+			Values.SetNumUninitialized(Schema_GetUint32Count(Object, FieldId));
+			Schema_GetUint32List(Object, FieldId, Values.GetData());
+			ArrayHelper.Resize(Values.Num());
+			if (Op == ESchemaPropertyOp::Byte)
+			{
+				NarrowListElements<uint8>(Values, ArrayHelper.GetRawPtr(0));
+			}
+			else
+			{
+				NarrowListElements<uint16>(Values, ArrayHelper.GetRawPtr(0));
+			}
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+}
+
 namespace SpatialGDK
 {
 
@@ -37,7 +220,7 @@ void ComponentReader::ApplyComponentData(const Worker_ComponentData& ComponentDa
 
 	Schema_Object* ComponentObject = Schema_GetComponentDataFields(ComponentData.schema_type);
 
-	TArray<uint32> UpdatedIds;
+	FFieldIdArray UpdatedIds;
 	UpdatedIds.SetNumUninitialized(Schema_GetUniqueFieldIdCount(ComponentObject));
 	Schema_GetUniqueFieldIds(ComponentObject, UpdatedIds.GetData());
 
@@ -47,11 +230,11 @@ void ComponentReader::ApplyComponentData(const Worker_ComponentData& ComponentDa
 	}
 	else
 	{
-		ApplySchemaObject(ComponentObject, Object, Channel, true, UpdatedIds);
+		ApplySchemaObject(ComponentObject, ComponentData.component_id, Object, Channel, true, UpdatedIds, nullptr);
 	}
 }
 
-void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover)
+void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover, const FPredecodedComponentUpdate* Predecoded /* = nullptr */)
 {
 	if (Object->IsPendingKill())
 	{
@@ -60,18 +243,25 @@ void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& Compone
 
 	Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(ComponentUpdate.schema_type);
 
-	// Retrieve all the fields that have been updated in this component update
-	TArray<uint32> UpdatedIds;
-	UpdatedIds.SetNumUninitialized(Schema_GetUniqueFieldIdCount(ComponentObject));
-	Schema_GetUniqueFieldIds(ComponentObject, UpdatedIds.GetData());
+	if (Predecoded != nullptr)
+	{
+		check(!bIsHandover);
+		if (Predecoded->FieldIds.Num() > 0)
+		{
+			ApplySchemaObject(ComponentObject, ComponentUpdate.component_id, Object, Channel, false, Predecoded->FieldIds, Predecoded);
+		}
+		return;
+	}
 
-	// Retrieve all the fields that have been cleared (eg. list with no entries)
-	TArray<Schema_FieldId> ClearedIds;
-	ClearedIds.SetNumUninitialized(Schema_GetComponentUpdateClearedFieldCount(ComponentUpdate.schema_type));
-	Schema_GetComponentUpdateClearedFieldList(ComponentUpdate.schema_type, ClearedIds.GetData());
+	// Retrieve all the fields that have been updated in this component update, followed by all the fields that have been
+	// cleared (eg. list with no entries) to ensure they will be processed (Schema_FieldId == uint32)
+	const uint32 NumUpdatedIds = Schema_GetUniqueFieldIdCount(ComponentObject);
+	const uint32 NumClearedIds = Schema_GetComponentUpdateClearedFieldCount(ComponentUpdate.schema_type);
 
-	// Merge cleared fields into updated fields to ensure they will be processed (Schema_FieldId == uint32)
-	UpdatedIds.Append(ClearedIds);
+	FFieldIdArray UpdatedIds;
+	UpdatedIds.SetNumUninitialized(NumUpdatedIds + NumClearedIds);
+	Schema_GetUniqueFieldIds(ComponentObject, UpdatedIds.GetData());
+	Schema_GetComponentUpdateClearedFieldList(ComponentUpdate.schema_type, UpdatedIds.GetData() + NumUpdatedIds);
 
 	if (UpdatedIds.Num() > 0)
 	{
@@ -81,12 +271,12 @@ void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& Compone
 		}
 		else
 		{
-			ApplySchemaObject(ComponentObject, Object, Channel, false, UpdatedIds);
+			ApplySchemaObject(ComponentObject, ComponentUpdate.component_id, Object, Channel, false, UpdatedIds, nullptr);
 		}
 	}
 }
 
-void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds)
+void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, Worker_ComponentId ComponentId, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArrayView<const Schema_FieldId> UpdatedIds, const FPredecodedComponentUpdate* Predecoded)
 {
 	FObjectReplicator& Replicator = Channel->PreReceiveSpatialUpdate(Object);
 
@@ -95,110 +285,128 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 #else
 	TUniquePtr<FRepState>& RepState = Replicator.RepState;
 #endif
-	TArray<FRepLayoutCmd>& Cmds = Replicator.RepLayout->Cmds;
-	TArray<FHandleToCmdIndex>& BaseHandleToCmdIndex = Replicator.RepLayout->BaseHandleToCmdIndex;
-	TArray<FRepParentCmd>& Parents = Replicator.RepLayout->Parents;
 
+	const FRepLayoutReadPlan& ReadPlan = ClassInfoManager->GetOrCreateClassInfoByClass(Object->GetClass()).RepReadPlan;
+	check(ReadPlan.Num() == Replicator.RepLayout->BaseHandleToCmdIndex.Num() + 1);
+
+	// Let the ops processing thread decode later updates to this component, now that the property types are known.
+	FComponentUpdatePredecoder* Predecoder = NetDriver->Connection->GetComponentUpdatePredecoder();
+	if (Predecoder != nullptr && !Predecoder->HasDecodePlan(ComponentId))
+	{
+		Predecoder->SetDecodePlan(ComponentId, CreateDecodePlan(ReadPlan));
+	}
+
+	bool bIsServer = NetDriver->IsServer();
 	bool bIsAuthServer = Channel->IsAuthoritativeServer();
 	bool bAutonomousProxy = Channel->IsClientAutonomousProxy();
 	bool bIsClient = NetDriver->GetNetMode() == NM_Client;
 
-	FSpatialConditionMapFilter ConditionMap(Channel, bIsClient);
+	// Rep conditions are only checked on clients.
+	TOptional<FSpatialConditionMapFilter> ConditionMap;
+	if (!bIsServer)
+	{
+		ConditionMap.Emplace(Channel, bIsClient);
+	}
 
 	TArray<UProperty*> RepNotifies;
 
-	for (uint32 FieldId : UpdatedIds)
+	for (Schema_FieldId FieldId : UpdatedIds)
 	{
 		// FieldId is the same as rep handle
-		check(FieldId > 0 && (int)FieldId - 1 < BaseHandleToCmdIndex.Num());
-		int32 CmdIndex = BaseHandleToCmdIndex[FieldId - 1].CmdIndex;
-		const FRepLayoutCmd& Cmd = Cmds[CmdIndex];
-		const FRepParentCmd& Parent = Parents[Cmd.ParentIndex];
-#if ENGINE_MINOR_VERSION <= 20
-		int32 ShadowOffset = 0;
-#else 
-		int32 ShadowOffset = Cmd.ShadowOffset;
-#endif
-		if (NetDriver->IsServer() || ConditionMap.IsRelevant(Parent.Condition))
+		check(FieldId > 0 && (int)FieldId < ReadPlan.Num());
+		const FRepFieldReadInfo& ReadInfo = ReadPlan[FieldId];
+
+		if (!bIsServer && !ConditionMap->IsRelevant(ReadInfo.Condition))
 		{
-			// This swaps Role/RemoteRole as we write it
-			const FRepLayoutCmd& SwappedCmd = (!bIsAuthServer && Parent.RoleSwapIndex != -1) ? Cmds[Parents[Parent.RoleSwapIndex].CmdStart] : Cmd;
+			continue;
+		}
+
+		// This swaps Role/RemoteRole as we write it
+		const int32 Offset = bIsAuthServer ? ReadInfo.Offset : ReadInfo.SwappedOffset;
+		uint8* Data = (uint8*)Object + Offset;
+
+		const FPredecodedField* PredecodedField = Predecoded != nullptr ? Predecoded->FindField(FieldId) : nullptr;
 
-			uint8* Data = (uint8*)Object + SwappedCmd.Offset;
+		if (ReadInfo.SchemaInfo.Op == ESchemaPropertyOp::Array)
+		{
+			UArrayProperty* ArrayProperty = static_cast<UArrayProperty*>(ReadInfo.Property);
 
-			if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
+			// Check if this is a FastArraySerializer array and if so, call our custom delta serialization
+			if (ReadInfo.NetDeltaStruct != nullptr)
 			{
-				UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Cmd.Property);
+				TArray<uint8> ValueData = GetBytesFromSchema(ComponentObject, FieldId);
+				int64 CountBits = ValueData.Num() * 8;
+				TSet<FUnrealObjectRef> NewUnresolvedRefs;
+				FSpatialNetBitReader ValueDataReader(PackageMap, ValueData.GetData(), CountBits, NewUnresolvedRefs);
+
+				if (ValueData.Num() > 0)
+				{
+					FSpatialNetDeltaSerializeInfo::DeltaSerializeRead(NetDriver, ValueDataReader, Object, ReadInfo.ParentArrayIndex, ReadInfo.ParentProperty, ReadInfo.NetDeltaStruct);
+				}
 
-				// Check if this is a FastArraySerializer array and if so, call our custom delta serialization
-				if (UScriptStruct* NetDeltaStruct = GetFastArraySerializerProperty(ArrayProperty))
+				if (NewUnresolvedRefs.Num() > 0)
 				{
-					TArray<uint8> ValueData = GetBytesFromSchema(ComponentObject, FieldId);
-					int64 CountBits = ValueData.Num() * 8;
-					TSet<FUnrealObjectRef> NewUnresolvedRefs;
-					FSpatialNetBitReader ValueDataReader(PackageMap, ValueData.GetData(), CountBits, NewUnresolvedRefs);
-
-					if (ValueData.Num() > 0)
-					{
-						FSpatialNetDeltaSerializeInfo::DeltaSerializeRead(NetDriver, ValueDataReader, Object, Parent.ArrayIndex, Parent.Property, NetDeltaStruct);
-					}
-
-					if (NewUnresolvedRefs.Num() > 0)
-					{
-						RootObjectReferencesMap.Add(SwappedCmd.Offset, FObjectReferences(ValueData, CountBits, NewUnresolvedRefs, ShadowOffset, Cmd.ParentIndex, ArrayProperty, /* bFastArrayProp */ true));
-						UnresolvedRefs.Append(NewUnresolvedRefs);
-					}
-					else if (RootObjectReferencesMap.Find(FieldId))
-					{
-						RootObjectReferencesMap.Remove(FieldId);
-					}
+					RootObjectReferencesMap.Add(Offset, FObjectReferences(ValueData, CountBits, NewUnresolvedRefs, ReadInfo.ShadowOffset, ReadInfo.ParentIndex, ArrayProperty, /* bFastArrayProp */ true));
+					UnresolvedRefs.Append(NewUnresolvedRefs);
 				}
-				else
+				else if (RootObjectReferencesMap.Find(FieldId))
 				{
-					ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, SwappedCmd.Offset, ShadowOffset, Cmd.ParentIndex);
+					RootObjectReferencesMap.Remove(FieldId);
+				}
+			}
+			else if (PredecodedField != nullptr)
+			{
+				FScriptArrayHelper ArrayHelper(ArrayProperty, Data);
+				ArrayHelper.Resize(PredecodedField->NumValues);
+				for (uint32 i = 0; i < PredecodedField->NumValues; i++)
+				{
+					ApplyPredecodedValue(ReadInfo.SchemaInfo.InnerOp, ReadInfo.SchemaInfo.InnerProperty, ArrayHelper.GetRawPtr(i), Predecoded->Values[PredecodedField->FirstValue + i]);
 				}
 			}
 			else
 			{
-				ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, Cmd.Property, Data, SwappedCmd.Offset, ShadowOffset, Cmd.ParentIndex);
+				ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ReadInfo.SchemaInfo, Data, Offset, ReadInfo.ShadowOffset, ReadInfo.ParentIndex);
 			}
+		}
+		else if (PredecodedField != nullptr)
+		{
+			ApplyPredecodedValue(ReadInfo.SchemaInfo.Op, ReadInfo.SchemaInfo.Property, Data, Predecoded->Values[PredecodedField->FirstValue]);
+		}
+		else
+		{
+			ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, ReadInfo.SchemaInfo.Op, ReadInfo.SchemaInfo.Property, Data, Offset, ReadInfo.ShadowOffset, ReadInfo.ParentIndex);
+		}
 
-			if (Cmd.Property->GetFName() == NAME_RemoteRole)
+		if (ReadInfo.bIsRemoteRole)
+		{
+			// Downgrade role from AutonomousProxy to SimulatedProxy if we aren't authoritative over
+			// the client RPCs component.
+			UByteProperty* ByteProperty = static_cast<UByteProperty*>(ReadInfo.Property);
+			if (!bIsAuthServer && !bAutonomousProxy && ByteProperty->GetPropertyValue(Data) == ROLE_AutonomousProxy)
 			{
-				// Downgrade role from AutonomousProxy to SimulatedProxy if we aren't authoritative over
-				// the client RPCs component.
-				UByteProperty* ByteProperty = Cast<UByteProperty>(Cmd.Property);
-				if (!bIsAuthServer && !bAutonomousProxy && ByteProperty->GetPropertyValue(Data) == ROLE_AutonomousProxy)
-				{
-					ByteProperty->SetPropertyValue(Data, ROLE_SimulatedProxy);
-				}
+				ByteProperty->SetPropertyValue(Data, ROLE_SimulatedProxy);
 			}
+		}
 
-			// Parent.Property is the "root" replicated property, e.g. if a struct property was flattened
-			if (Parent.Property->HasAnyPropertyFlags(CPF_RepNotify))
-			{
-#if ENGINE_MINOR_VERSION <= 20
-				bool bIsIdentical = Cmd.Property->Identical(RepState->StaticBuffer.GetData() + SwappedCmd.Offset, Data);
-#else
-				bool bIsIdentical = Cmd.Property->Identical(RepState->StaticBuffer.GetData() + SwappedCmd.ShadowOffset, Data);
-#endif
+		if (ReadInfo.RepNotifyProperty != nullptr)
+		{
+			const int32 StaticBufferOffset = bIsAuthServer ? ReadInfo.StaticBufferOffset : ReadInfo.SwappedStaticBufferOffset;
+			bool bIsIdentical = ReadInfo.Property->Identical(RepState->StaticBuffer.GetData() + StaticBufferOffset, Data);
 
-				// Only call RepNotify for REPNOTIFY_Always if we are not applying initial data.
-				if (bIsInitialData)
+			// Only call RepNotify for REPNOTIFY_Always if we are not applying initial data.
+			if (bIsInitialData)
+			{
+				if (!bIsIdentical)
 				{
-					if (!bIsIdentical)
-					{
-						RepNotifies.AddUnique(Parent.Property);
-					}
+					RepNotifies.AddUnique(ReadInfo.RepNotifyProperty);
 				}
-				else
+			}
+			else
+			{
+				if (ReadInfo.RepNotifyCondition == REPNOTIFY_Always || !bIsIdentical)
 				{
-					if (Parent.RepNotifyCondition == REPNOTIFY_Always || !bIsIdentical)
-					{
-						RepNotifies.AddUnique(Parent.Property);
-					}
+					RepNotifies.AddUnique(ReadInfo.RepNotifyProperty);
 				}
-
 			}
 		}
 	}
@@ -208,13 +416,13 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 	Channel->PostReceiveSpatialUpdate(Object, RepNotifies);
 }
 
-void ComponentReader::ApplyHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds)
+void ComponentReader::ApplyHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArrayView<const Schema_FieldId> UpdatedIds)
 {
 	const FClassInfo& ClassInfo = ClassInfoManager->GetOrCreateClassInfoByClass(Object->GetClass());
 
 	Channel->PreReceiveSpatialUpdate(Object);
 
-	for (uint32 FieldId : UpdatedIds)
+	for (Schema_FieldId FieldId : UpdatedIds)
 	{
 		// FieldId is the same as handover handle
 		check(FieldId > 0 && (int)FieldId - 1 < ClassInfo.HandoverProperties.Num());
@@ -222,22 +430,26 @@ void ComponentReader::ApplyHandoverSchemaObject(Schema_Object* ComponentObject,
 
 		uint8* Data = (uint8*)Object + PropertyInfo.Offset;
 
-		if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(PropertyInfo.Property))
+		if (PropertyInfo.SchemaInfo.Op == ESchemaPropertyOp::Array)
 		{
-			ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, PropertyInfo.Offset, -1, -1);
+			ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, PropertyInfo.SchemaInfo, Data, PropertyInfo.Offset, -1, -1);
 		}
 		else
 		{
-			ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, PropertyInfo.Property, Data, PropertyInfo.Offset, -1, -1);
+			ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, PropertyInfo.SchemaInfo.Op, PropertyInfo.SchemaInfo.Property, Data, PropertyInfo.Offset, -1, -1);
 		}
 	}
 
 	Channel->PostReceiveSpatialUpdate(Object, TArray<UProperty*>());
 }
 
-void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, UProperty* Property, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex)
+void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, ESchemaPropertyOp Op, UProperty* Property, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex)
 {
-	if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+	// The ops were resolved from the property classes when the class info was created, so the casts here are static.
+	switch (Op)
+	{
+	case ESchemaPropertyOp::NetSerializeStruct:
+	case ESchemaPropertyOp::RepLayoutStruct:
 	{
 		TArray<uint8> ValueData = IndexBytesFromSchema(Object, FieldId, Index);
 		// A bit hacky, we should probably include the number of bits with the data instead.
@@ -246,7 +458,7 @@ void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldI
 		FSpatialNetBitReader ValueDataReader(PackageMap, ValueData.GetData(), CountBits, NewUnresolvedRefs);
 		bool bHasUnmapped = false;
 
-		ReadStructProperty(ValueDataReader, StructProperty, NetDriver, Data, bHasUnmapped);
+		ReadStructProperty(ValueDataReader, static_cast<UStructProperty*>(Property), NetDriver, Data, bHasUnmapped);
 
 		if (bHasUnmapped)
 		{
@@ -257,53 +469,48 @@ void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldI
 		{
 			InObjectReferencesMap.Remove(Offset);
 		}
-	}
-	else if (UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property))
-	{
-		BoolProperty->SetPropertyValue(Data, Schema_IndexBool(Object, FieldId, Index) != 0);
-	}
-	else if (UFloatProperty* FloatProperty = Cast<UFloatProperty>(Property))
-	{
-		FloatProperty->SetPropertyValue(Data, Schema_IndexFloat(Object, FieldId, Index));
-	}
-	else if (UDoubleProperty* DoubleProperty = Cast<UDoubleProperty>(Property))
-	{
-		DoubleProperty->SetPropertyValue(Data, Schema_IndexDouble(Object, FieldId, Index));
-	}
-	else if (UInt8Property* Int8Property = Cast<UInt8Property>(Property))
-	{
-		Int8Property->SetPropertyValue(Data, (int8)Schema_IndexInt32(Object, FieldId, Index));
-	}
-	else if (UInt16Property* Int16Property = Cast<UInt16Property>(Property))
-	{
-		Int16Property->SetPropertyValue(Data, (int16)Schema_IndexInt32(Object, FieldId, Index));
-	}
-	else if (UIntProperty* IntProperty = Cast<UIntProperty>(Property))
-	{
-		IntProperty->SetPropertyValue(Data, Schema_IndexInt32(Object, FieldId, Index));
-	}
-	else if (UInt64Property* Int64Property = Cast<UInt64Property>(Property))
-	{
-		Int64Property->SetPropertyValue(Data, Schema_IndexInt64(Object, FieldId, Index));
-	}
-	else if (UByteProperty* ByteProperty = Cast<UByteProperty>(Property))
-	{
-		ByteProperty->SetPropertyValue(Data, (uint8)Schema_IndexUint32(Object, FieldId, Index));
-	}
-	else if (UUInt16Property* UInt16Property = Cast<UUInt16Property>(Property))
-	{
-		UInt16Property->SetPropertyValue(Data, (uint16)Schema_IndexUint32(Object, FieldId, Index));
-	}
-	else if (UUInt32Property* UInt32Property = Cast<UUInt32Property>(Property))
-	{
-		UInt32Property->SetPropertyValue(Data, Schema_IndexUint32(Object, FieldId, Index));
-	}
-	else if (UUInt64Property* UInt64Property = Cast<UUInt64Property>(Property))
-	{
-		UInt64Property->SetPropertyValue(Data, Schema_IndexUint64(Object, FieldId, Index));
-	}
-	else if (UObjectPropertyBase* ObjectProperty = Cast<UObjectPropertyBase>(Property))
-	{
+		break;
+	}
+	case ESchemaPropertyOp::Bool:
+		static_cast<UBoolProperty*>(Property)->SetPropertyValue(Data, Schema_IndexBool(Object, FieldId, Index) != 0);
+		break;
+	case ESchemaPropertyOp::Float:
+		static_cast<UFloatProperty*>(Property)->SetPropertyValue(Data, Schema_IndexFloat(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::Double:
+		static_cast<UDoubleProperty*>(Property)->SetPropertyValue(Data, Schema_IndexDouble(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::Int8:
+		static_cast<UInt8Property*>(Property)->SetPropertyValue(Data, (int8)Schema_IndexInt32(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::Int16:
+		static_cast<UInt16Property*>(Property)->SetPropertyValue(Data, (int16)Schema_IndexInt32(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::Int32:
+		static_cast<UIntProperty*>(Property)->SetPropertyValue(Data, Schema_IndexInt32(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::Int64:
+		static_cast<UInt64Property*>(Property)->SetPropertyValue(Data, Schema_IndexInt64(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::Byte:
+		static_cast<UByteProperty*>(Property)->SetPropertyValue(Data, (uint8)Schema_IndexUint32(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::UInt16:
+		static_cast<UUInt16Property*>(Property)->SetPropertyValue(Data, (uint16)Schema_IndexUint32(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::UInt32:
+		static_cast<UUInt32Property*>(Property)->SetPropertyValue(Data, Schema_IndexUint32(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::UInt64:
+		static_cast<UUInt64Property*>(Property)->SetPropertyValue(Data, Schema_IndexUint64(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::SmallEnum:
+		// Property is the enum's underlying property.
+		static_cast<UNumericProperty*>(Property)->SetIntPropertyValue(Data, (uint64)Schema_IndexUint32(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::Object:
+	{
+		UObjectPropertyBase* ObjectProperty = static_cast<UObjectPropertyBase*>(Property);
 		FUnrealObjectRef ObjectRef = IndexObjectRefFromSchema(Object, FieldId, Index);
 		check(ObjectRef != FUnrealObjectRef::UNRESOLVED_OBJECT_REF);
 		bool bUnresolved = false;
@@ -347,38 +554,34 @@ void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldI
 		{
 			InObjectReferencesMap.Remove(Offset);
 		}
-	}
-	else if (UNameProperty* NameProperty = Cast<UNameProperty>(Property))
-	{
-		NameProperty->SetPropertyValue(Data, FName(*IndexStringFromSchema(Object, FieldId, Index)));
-	}
-	else if (UStrProperty* StrProperty = Cast<UStrProperty>(Property))
-	{
-		StrProperty->SetPropertyValue(Data, IndexStringFromSchema(Object, FieldId, Index));
-	}
-	else if (UTextProperty* TextProperty = Cast<UTextProperty>(Property))
-	{
-		TextProperty->SetPropertyValue(Data, FText::FromString(IndexStringFromSchema(Object, FieldId, Index)));
-	}
-	else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
-	{
-		if (EnumProperty->ElementSize < 4)
-		{
-			EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Data, (uint64)Schema_IndexUint32(Object, FieldId, Index));
-		}
-		else
-		{
-			ApplyProperty(Object, FieldId, InObjectReferencesMap, Index, EnumProperty->GetUnderlyingProperty(), Data, Offset, ShadowOffset, ParentIndex);
-		}
-	}
-	else
-	{
+		break;
+	}
+	case ESchemaPropertyOp::Name:
+		static_cast<UNameProperty*>(Property)->SetPropertyValue(Data, IndexNameFromSchema(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::Str:
+		static_cast<UStrProperty*>(Property)->SetPropertyValue(Data, IndexStringFromSchema(Object, FieldId, Index));
+		break;
+	case ESchemaPropertyOp::Text:
+		static_cast<UTextProperty*>(Property)->SetPropertyValue(Data, FText::FromString(IndexStringFromSchema(Object, FieldId, Index)));
+		break;
+	default:
 		checkf(false, TEXT("Tried to read unknown property in field %d"), FieldId);
+		break;
 	}
 }
 
-void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex)
+void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, const FSchemaPropertyInfo& SchemaInfo, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex)
 {
+	UArrayProperty* Property = static_cast<UArrayProperty*>(SchemaInfo.Property);
+
+	// Arrays of primitive elements can't hold object references, so there is nothing to track for them.
+	FScriptArrayHelper ArrayHelper(Property, Data);
+	if (ApplyPrimitiveList(Object, FieldId, SchemaInfo.InnerOp, ArrayHelper))
+	{
+		return;
+	}
+
 	FObjectReferencesMap* ArrayObjectReferences;
 	bool bNewArrayMap = false;
 	if (FObjectReferences* ExistingEntry = InObjectReferencesMap.Find(Offset))
@@ -393,15 +596,13 @@ void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId,
 		ArrayObjectReferences = new FObjectReferencesMap();
 	}
 
-	FScriptArrayHelper ArrayHelper(Property, Data);
-
-	int Count = GetPropertyCount(Object, FieldId, Property->Inner);
+	int Count = GetPropertyCount(Object, FieldId, SchemaInfo.InnerOp);
 	ArrayHelper.Resize(Count);
 
 	for (int i = 0; i < Count; i++)
 	{
 		int32 ElementOffset = i * Property->Inner->ElementSize;
-		ApplyProperty(Object, FieldId, *ArrayObjectReferences, i, Property->Inner, ArrayHelper.GetRawPtr(i), ElementOffset, ElementOffset, ParentIndex);
+		ApplyProperty(Object, FieldId, *ArrayObjectReferences, i, SchemaInfo.InnerOp, SchemaInfo.InnerProperty, ArrayHelper.GetRawPtr(i), ElementOffset, ElementOffset, ParentIndex);
 	}
 
 	if (ArrayObjectReferences->Num() > 0)
@@ -425,89 +626,38 @@ void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId,
 	}
 }
 
-uint32 ComponentReader::GetPropertyCount(const Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property)
+uint32 ComponentReader::GetPropertyCount(const Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op)
 {
-	if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+	switch (Op)
 	{
+	case ESchemaPropertyOp::NetSerializeStruct:
+	case ESchemaPropertyOp::RepLayoutStruct:
+	case ESchemaPropertyOp::Name:
+	case ESchemaPropertyOp::Str:
+	case ESchemaPropertyOp::Text:
 		return Schema_GetBytesCount(Object, FieldId);
-	}
-	else if (UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property))
-	{
+	case ESchemaPropertyOp::Bool:
 		return Schema_GetBoolCount(Object, FieldId);
-	}
-	else if (UFloatProperty* FloatProperty = Cast<UFloatProperty>(Property))
-	{
+	case ESchemaPropertyOp::Float:
 		return Schema_GetFloatCount(Object, FieldId);
-	}
-	else if (UDoubleProperty* DoubleProperty = Cast<UDoubleProperty>(Property))
-	{
+	case ESchemaPropertyOp::Double:
 		return Schema_GetDoubleCount(Object, FieldId);
-	}
-	else if (UInt8Property* Int8Property = Cast<UInt8Property>(Property))
-	{
-		return Schema_GetInt32Count(Object, FieldId);
-	}
-	else if (UInt16Property* Int16Property = Cast<UInt16Property>(Property))
-	{
+	case ESchemaPropertyOp::Int8:
+	case ESchemaPropertyOp::Int16:
+	case ESchemaPropertyOp::Int32:
 		return Schema_GetInt32Count(Object, FieldId);
-	}
-	else if (UIntProperty* IntProperty = Cast<UIntProperty>(Property))
-	{
-		return Schema_GetInt32Count(Object, FieldId);
-	}
-	else if (UInt64Property* Int64Property = Cast<UInt64Property>(Property))
-	{
+	case ESchemaPropertyOp::Int64:
 		return Schema_GetInt64Count(Object, FieldId);
-	}
-	else if (UByteProperty* ByteProperty = Cast<UByteProperty>(Property))
-	{
-		return Schema_GetUint32Count(Object, FieldId);
-	}
-	else if (UUInt16Property* UInt16Property = Cast<UUInt16Property>(Property))
-	{
-		return Schema_GetUint32Count(Object, FieldId);
-	}
-	else if (UUInt32Property* UInt32Property = Cast<UUInt32Property>(Property))
-	{
+	case ESchemaPropertyOp::Byte:
+	case ESchemaPropertyOp::UInt16:
+	case ESchemaPropertyOp::UInt32:
+	case ESchemaPropertyOp::SmallEnum:
 		return Schema_GetUint32Count(Object, FieldId);
-	}
-	else if (UUInt64Property* UInt64Property = Cast<UUInt64Property>(Property))
-	{
+	case ESchemaPropertyOp::UInt64:
 		return Schema_GetUint64Count(Object, FieldId);
-	}
-	else if (UObjectPropertyBase* ObjectProperty = Cast<UObjectPropertyBase>(Property))
-	{
+	case ESchemaPropertyOp::Object:
 		return Schema_GetObjectCount(Object, FieldId);
-	}
-	else if (UNameProperty* NameProperty = Cast<UNameProperty>(Property))
-	{
-		return Schema_GetBytesCount(Object, FieldId);
-	}
-	else if (UStrProperty* StrProperty = Cast<UStrProperty>(Property))
-	{
-		return Schema_GetBytesCount(Object, FieldId);
-	}
-	else if (UTextProperty* TextProperty = Cast<UTextProperty>(Property))
-	{
-		return Schema_GetBytesCount(Object, FieldId);
-	}
-	else if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property))
-	{
-		return GetPropertyCount(Object, FieldId, ArrayProperty->Inner);
-	}
-	else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
-	{
-		if (EnumProperty->ElementSize < 4)
-		{
-			return Schema_GetUint32Count(Object, FieldId);
-		}
-		else
-		{
-			return GetPropertyCount(Object, FieldId, EnumProperty->GetUnderlyingProperty());
-		}
-	}
-	else
-	{
+	default:
 		checkf(false, TEXT("Tried to get count of unknown property in field %d"), FieldId);
 		return 0;
 	}
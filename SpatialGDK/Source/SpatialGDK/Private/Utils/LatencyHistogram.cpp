@@ -0,0 +1,108 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/LatencyHistogram.h"
+
+#include <cmath>
+#include <limits>
+
+namespace SpatialGDK
+{
+
+FLatencyHistogramSnapshot::FLatencyHistogramSnapshot()
+	: BaseUpperBound(1.0)
+	, Count(0)
+	, Sum(0.0)
+{
+	FMemory::Memzero(Buckets);
+}
+
+double FLatencyHistogramSnapshot::GetBucketUpperBound(int32 BucketIndex) const
+{
+	check(BucketIndex >= 0 && BucketIndex < NumBuckets);
+
+	if (BucketIndex == NumBuckets - 1)
+	{
+		return std::numeric_limits<double>::infinity();
+	}
+
+	return std::ldexp(BaseUpperBound, BucketIndex);
+}
+
+double FLatencyHistogramSnapshot::GetPercentile(double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const uint32 Target = FMath::Max(1u, static_cast<uint32>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 1.0) * Count)));
+
+	uint32 Cumulative = 0;
+	for (int32 i = 0; i < NumBuckets - 1; i++)
+	{
+		Cumulative += Buckets[i];
+		if (Cumulative >= Target)
+		{
+			return GetBucketUpperBound(i);
+		}
+	}
+
+	// The unbounded bucket is reported at its lower bound.
+	return GetBucketUpperBound(NumBuckets - 2);
+}
+
+FLatencyHistogram::FLatencyHistogram(double InBaseUpperBound)
+	: BaseUpperBound(InBaseUpperBound)
+	, Sum(0.0)
+{
+	check(BaseUpperBound > 0.0);
+
+	for (std::atomic<uint32>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+int32 FLatencyHistogram::GetBucketIndex(double Value) const
+{
+	const double Ratio = Value / BaseUpperBound;
+	if (!(Ratio > 1.0))
+	{
+		return 0;
+	}
+
+	// Ratio = Mantissa * 2^Exponent with Mantissa in [0.5, 1), so the smallest i with Ratio <= 2^i is Exponent,
+	// unless Ratio is an exact power of two.
+	int Exponent;
+	const double Mantissa = std::frexp(Ratio, &Exponent);
+	const int32 BucketIndex = Mantissa == 0.5 ? Exponent - 1 : Exponent;
+
+	return FMath::Min(BucketIndex, NumBuckets - 1);
+}
+
+void FLatencyHistogram::Record(double Value)
+{
+	Buckets[GetBucketIndex(Value)].fetch_add(1, std::memory_order_relaxed);
+
+	double OldSum = Sum.load(std::memory_order_relaxed);
+	while (!Sum.compare_exchange_weak(OldSum, OldSum + Value, std::memory_order_relaxed))
+	{
+	}
+}
+
+FLatencyHistogramSnapshot FLatencyHistogram::TakeSnapshot()
+{
+	FLatencyHistogramSnapshot Snapshot;
+	Snapshot.BaseUpperBound = BaseUpperBound;
+
+	for (int32 i = 0; i < NumBuckets; i++)
+	{
+		Snapshot.Buckets[i] = Buckets[i].exchange(0, std::memory_order_relaxed);
+		Snapshot.Count += Snapshot.Buckets[i];
+	}
+	Snapshot.Sum = Sum.exchange(0.0, std::memory_order_relaxed);
+
+	return Snapshot;
+}
+
+} // namespace SpatialGDK
@@ -2,73 +2,363 @@
 
 #include "Utils/RPCContainer.h"
 
+#include "EngineClasses/SpatialNetDriver.h"
+#include "HAL/PlatformTime.h"
 #include "Schema/UnrealObjectRef.h"
 
+DEFINE_LOG_CATEGORY_STATIC(LogRPCContainer, Log, All);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dropped Queued RPCs"), STAT_RPCContainerDroppedRPCs, STATGROUP_SpatialNet);
+
 using namespace SpatialGDK;
 
+namespace
+{
+	// Keys of USpatialGDKSettings::RPCQueuePolicies.
+	FName GetRPCQueuePolicyName(ESchemaComponentType Type)
+	{
+		switch (Type)
+		{
+		case SCHEMA_ClientReliableRPC:
+			return TEXT("ClientReliable");
+		case SCHEMA_ClientUnreliableRPC:
+			return TEXT("ClientUnreliable");
+		case SCHEMA_ServerReliableRPC:
+			return TEXT("ServerReliable");
+		case SCHEMA_ServerUnreliableRPC:
+			return TEXT("ServerUnreliable");
+		case SCHEMA_NetMulticastRPC:
+			return TEXT("NetMulticast");
+		case SCHEMA_CrossServerRPC:
+			return TEXT("CrossServer");
+		default:
+			checkNoEntry();
+			return NAME_None;
+		}
+	}
+
+	int32 GetRPCTypeIndex(ESchemaComponentType Type)
+	{
+		check(Type >= SCHEMA_ClientReliableRPC && Type <= SCHEMA_CrossServerRPC);
+		return Type - SCHEMA_ClientReliableRPC;
+	}
+}
+
 FPendingRPCParams::FPendingRPCParams(const FUnrealObjectRef& InTargetObjectRef, SpatialGDK::RPCPayload&& InPayload, int InReliableRPCIndex /* = 0 */)
 	: ReliableRPCIndex(InReliableRPCIndex)
 	, ObjectRef(InTargetObjectRef)
 	, Payload(MoveTemp(InPayload))
-	, QueuedTimestamp(FDateTime::Now())
+	, QueuedCycles(FPlatformTime::Cycles64())
 {
 }
 
-void FRPCContainer::QueueRPC(FPendingRPCParamsPtr Params, ESchemaComponentType Type)
+void FRPCContainer::FRPCQueue::PushFront(FPendingRPCParams&& Params)
 {
-	FArrayOfParams& ArrayOfParams = QueuedRPCs.FindOrAdd(Type).FindOrAdd(Params->ObjectRef.Entity);
-	ArrayOfParams.Push(MoveTemp(Params));
+	if (Head > 0)
+	{
+		Head--;
+		RPCs[Head] = MoveTemp(Params);
+	}
+	else
+	{
+		RPCs.Insert(MoveTemp(Params), 0);
+	}
 }
 
-void FRPCContainer::ProcessRPCs(const FProcessRPCDelegate& FunctionToApply, FArrayOfParams& RPCList)
+void FRPCContainer::FRPCQueue::PopFront(int32 Count)
 {
-	// TODO: UNR-1651 Find a way to drop queued RPCs
-	int NumProcessedParams = 0;
-	for (auto& Params : RPCList)
+	Head += Count;
+	if (Head == RPCs.Num())
+	{
+		RPCs.Reset();
+		Head = 0;
+	}
+	else if (Head > RPCs.Num() / 2)
 	{
-		if (ApplyFunction(FunctionToApply, *Params))
+		RPCs.RemoveAt(0, Head, /* bAllowShrinking = */ false);
+		Head = 0;
+	}
+}
+
+void FRPCContainer::Init()
+{
+	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
+
+	for (int32 TypeIndex = 0; TypeIndex < NumRPCTypes; TypeIndex++)
+	{
+		const FRPCQueuePolicy* Policy = SpatialGDKSettings->RPCQueuePolicies.Find(GetRPCQueuePolicyName(ESchemaComponentType(SCHEMA_ClientReliableRPC + TypeIndex)));
+		Policies[TypeIndex] = Policy != nullptr ? *Policy : FRPCQueuePolicy();
+		MaxAgeCycles[TypeIndex] = Policies[TypeIndex].MaxAgeSeconds > 0.0f ? static_cast<uint64>(Policies[TypeIndex].MaxAgeSeconds / FPlatformTime::GetSecondsPerCycle64()) : 0;
+	}
+}
+
+void FRPCContainer::QueueRPC(FPendingRPCParams&& Params, ESchemaComponentType Type)
+{
+	const int32 TypeIndex = GetRPCTypeIndex(Type);
+	const FQueueKey Queue(Type, Params.ObjectRef.Entity);
+	FRPCQueue& RPCQueue = QueuedRPCs[TypeIndex].FindOrAdd(Params.ObjectRef.Entity);
+
+	const FRPCQueuePolicy& Policy = Policies[TypeIndex];
+	if (Policy.MaxQueueLength > 0 && RPCQueue.Num() >= Policy.MaxQueueLength)
+	{
+		UE_LOG(LogRPCContainer, Verbose, TEXT("Queue of %s RPCs for entity %lld is full, dropping the %s RPC."),
+			*RPCSchemaTypeToString(Type), Params.ObjectRef.Entity, Policy.OverflowPolicy == ERPCQueueOverflowPolicy::DropOldest ? TEXT("oldest") : TEXT("newest"));
+
+		NumDroppedRPCs++;
+		INC_DWORD_STAT(STAT_RPCContainerDroppedRPCs);
+
+		if (Policy.OverflowPolicy == ERPCQueueOverflowPolicy::DropNewest)
 		{
-			NumProcessedParams++;
+			return;
 		}
-		else
+
+		// The new first RPC may be waiting for something else.
+		RPCQueue.PopFront(1);
+		NumQueuedRPCs--;
+		RemoveDependencies(Queue);
+		QueuesWithUnknownDependencies.Add(Queue);
+	}
+
+	if (NumQueuedRPCs == 0 || Params.QueuedCycles < OldestQueuedCycles)
+	{
+		OldestQueuedCycles = Params.QueuedCycles;
+	}
+
+	if (RPCQueue.Num() == 0)
+	{
+		QueuesWithUnknownDependencies.Add(Queue);
+	}
+	RPCQueue.RPCs.Add(MoveTemp(Params));
+	NumQueuedRPCs++;
+}
+
+void FRPCContainer::DropExpiredRPCs(const FQueueKey& Queue, FRPCQueue& RPCQueue)
+{
+	const uint64 MaxAge = MaxAgeCycles[GetRPCTypeIndex(Queue.Key)];
+	if (MaxAge == 0)
+	{
+		return;
+	}
+
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+	int32 NumExpired = 0;
+	while (NumExpired < RPCQueue.Num() && NowCycles - RPCQueue.RPCs[RPCQueue.Head + NumExpired].QueuedCycles > MaxAge)
+	{
+		NumExpired++;
+	}
+
+	if (NumExpired > 0)
+	{
+		UE_LOG(LogRPCContainer, Verbose, TEXT("Dropping %d expired %s RPCs for entity %lld."), NumExpired, *RPCSchemaTypeToString(Queue.Key), Queue.Value);
+
+		RPCQueue.PopFront(NumExpired);
+		NumQueuedRPCs -= NumExpired;
+		NumDroppedRPCs += NumExpired;
+		INC_DWORD_STAT_BY(STAT_RPCContainerDroppedRPCs, NumExpired);
+	}
+}
+
+void FRPCContainer::ProcessRPCs(const FQueueKey& Queue, const FProcessRPCWithDependenciesDelegate& FunctionToApply)
+{
+	RemoveDependencies(Queue);
+
+	FRPCMap& MapOfQueues = QueuedRPCs[GetRPCTypeIndex(Queue.Key)];
+	FRPCQueue* RPCQueue = MapOfQueues.Find(Queue.Value);
+	if (RPCQueue == nullptr)
+	{
+		return;
+	}
+
+	DropExpiredRPCs(Queue, *RPCQueue);
+
+	// FunctionToApply can queue more RPCs, which may reallocate this queue's array or the map holding it,
+	// so each RPC is moved out before it's applied and the queue is looked up again afterwards.
+	while (RPCQueue != nullptr && RPCQueue->Num() > 0)
+	{
+		FPendingRPCParams Params = MoveTemp(RPCQueue->First());
+		RPCQueue->PopFront(1);
+		NumQueuedRPCs--;
+
+		TSet<FUnrealObjectRef> UnresolvedRefs;
+		const bool bApplied = FunctionToApply.Execute(Params, UnresolvedRefs);
+
+		RPCQueue = MapOfQueues.Find(Queue.Value);
+		if (!bApplied)
 		{
+			if (RPCQueue == nullptr)
+			{
+				RPCQueue = &MapOfQueues.Add(Queue.Value);
+			}
+			RPCQueue->PushFront(MoveTemp(Params));
+			NumQueuedRPCs++;
+			AddDependencies(Queue, UnresolvedRefs);
 			break;
 		}
 	}
-	RPCList.RemoveAt(0, NumProcessedParams);
+
+	if (RPCQueue != nullptr && RPCQueue->Num() == 0)
+	{
+		MapOfQueues.Remove(Queue.Value);
+	}
 }
 
 void FRPCContainer::ProcessRPCs(const FProcessRPCDelegate& FunctionToApply)
 {
-	for (auto& RPCs : QueuedRPCs)
+	ProcessRPCs(FProcessRPCWithDependenciesDelegate::CreateLambda([&FunctionToApply](const FPendingRPCParams& Params, TSet<FUnrealObjectRef>& OutUnresolvedRefs)
 	{
-		FRPCMap& MapOfQueues = RPCs.Value;
-		for(auto It = MapOfQueues.CreateIterator(); It; ++It)
+		return FunctionToApply.Execute(Params);
+	}));
+}
+
+void FRPCContainer::ProcessRPCs(const FProcessRPCWithDependenciesDelegate& FunctionToApply)
+{
+	// Collected up front, as applying an RPC can add queues to the maps.
+	TArray<FQueueKey> Queues;
+	for (int32 TypeIndex = 0; TypeIndex < NumRPCTypes; TypeIndex++)
+	{
+		for (const auto& RPCQueue : QueuedRPCs[TypeIndex])
 		{
-			FArrayOfParams& RPCList = It.Value();
-			ProcessRPCs(FunctionToApply, RPCList);
-			if (RPCList.Num() == 0)
+			Queues.Add(FQueueKey(ESchemaComponentType(SCHEMA_ClientReliableRPC + TypeIndex), RPCQueue.Key));
+		}
+	}
+
+	ProcessQueues(Queues, FunctionToApply);
+}
+
+void FRPCContainer::ProcessRPCsWaitingForEntity(Worker_EntityId EntityId, const FProcessRPCWithDependenciesDelegate& FunctionToApply)
+{
+	TArray<FQueueKey> Queues = QueuesWithUnknownDependencies.Array();
+	if (const TSet<FQueueKey>* WaitingQueues = QueuesWaitingForEntity.Find(EntityId))
+	{
+		Queues.Append(WaitingQueues->Array());
+	}
+
+	ProcessQueues(Queues, FunctionToApply);
+}
+
+void FRPCContainer::ProcessRPCsQueuedBefore(uint64 CutoffCycles, const FProcessRPCWithDependenciesDelegate& FunctionToApply)
+{
+	if (NumQueuedRPCs == 0 || OldestQueuedCycles >= CutoffCycles)
+	{
+		return;
+	}
+
+	TArray<FQueueKey> Queues;
+	for (int32 TypeIndex = 0; TypeIndex < NumRPCTypes; TypeIndex++)
+	{
+		for (const auto& RPCQueue : QueuedRPCs[TypeIndex])
+		{
+			if (RPCQueue.Value.Num() > 0 && RPCQueue.Value.First().QueuedCycles < CutoffCycles)
+			{
+				Queues.Add(FQueueKey(ESchemaComponentType(SCHEMA_ClientReliableRPC + TypeIndex), RPCQueue.Key));
+			}
+		}
+	}
+
+	ProcessQueues(Queues, FunctionToApply);
+
+	OldestQueuedCycles = MAX_uint64;
+	for (int32 TypeIndex = 0; TypeIndex < NumRPCTypes; TypeIndex++)
+	{
+		for (const auto& RPCQueue : QueuedRPCs[TypeIndex])
+		{
+			if (RPCQueue.Value.Num() > 0)
 			{
-				It.RemoveCurrent();
+				OldestQueuedCycles = FMath::Min(OldestQueuedCycles, RPCQueue.Value.First().QueuedCycles);
 			}
 		}
 	}
 }
 
-bool FRPCContainer::ObjectHasRPCsQueuedOfType(const Worker_EntityId& EntityId, ESchemaComponentType Type) const
+void FRPCContainer::ProcessQueues(const TArray<FQueueKey>& Queues, const FProcessRPCWithDependenciesDelegate& FunctionToApply)
+{
+	for (const FQueueKey& Queue : Queues)
+	{
+		ProcessRPCs(Queue, FunctionToApply);
+	}
+}
+
+void FRPCContainer::AddDependencies(const FQueueKey& Queue, const TSet<FUnrealObjectRef>& UnresolvedRefs)
 {
-	if(const FRPCMap* MapOfQueues = QueuedRPCs.Find(Type))
+	TArray<Worker_EntityId> Entities;
+	for (const FUnrealObjectRef& ObjectRef : UnresolvedRefs)
 	{
-		if(const FArrayOfParams* RPCList = MapOfQueues->Find(EntityId))
+		// Objects referred to by path are resolved through their outer, so don't try to work out what to wait for.
+		if (ObjectRef.Entity == SpatialConstants::INVALID_ENTITY_ID)
 		{
-			return (RPCList->Num() > 0);
+			Entities.Reset();
+			break;
 		}
+		Entities.AddUnique(ObjectRef.Entity);
+	}
+
+	if (Entities.Num() == 0)
+	{
+		QueuesWithUnknownDependencies.Add(Queue);
+		return;
+	}
+
+	for (Worker_EntityId EntityId : Entities)
+	{
+		QueuesWaitingForEntity.FindOrAdd(EntityId).Add(Queue);
+	}
+	QueueDependencies.Add(Queue, MoveTemp(Entities));
+}
+
+void FRPCContainer::RemoveDependencies(const FQueueKey& Queue)
+{
+	QueuesWithUnknownDependencies.Remove(Queue);
+
+	TArray<Worker_EntityId> Entities;
+	if (!QueueDependencies.RemoveAndCopyValue(Queue, Entities))
+	{
+		return;
+	}
+
+	for (Worker_EntityId EntityId : Entities)
+	{
+		if (TSet<FQueueKey>* WaitingQueues = QueuesWaitingForEntity.Find(EntityId))
+		{
+			WaitingQueues->Remove(Queue);
+			if (WaitingQueues->Num() == 0)
+			{
+				QueuesWaitingForEntity.Remove(EntityId);
+			}
+		}
+	}
+}
+
+bool FRPCContainer::ObjectHasRPCsQueuedOfType(const Worker_EntityId& EntityId, ESchemaComponentType Type) const
+{
+	if (const FRPCQueue* RPCQueue = QueuedRPCs[GetRPCTypeIndex(Type)].Find(EntityId))
+	{
+		return (RPCQueue->Num() > 0);
 	}
 
 	return false;
 }
 
-bool FRPCContainer::ApplyFunction(const FProcessRPCDelegate& FunctionToApply, const FPendingRPCParams& Params)
+double FRPCContainer::GetOldestQueuedRPCAgeSeconds() const
+{
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+
+	uint64 OldestAgeCycles = 0;
+	for (int32 TypeIndex = 0; TypeIndex < NumRPCTypes; TypeIndex++)
+	{
+		for (const auto& RPCQueue : QueuedRPCs[TypeIndex])
+		{
+			if (RPCQueue.Value.Num() > 0)
+			{
+				OldestAgeCycles = FMath::Max(OldestAgeCycles, NowCycles - RPCQueue.Value.First().QueuedCycles);
+			}
+		}
+	}
+	return FPlatformTime::ToSeconds64(OldestAgeCycles);
+}
+
+uint32 FRPCContainer::TakeNumDroppedRPCs()
 {
-	return FunctionToApply.Execute(Params);
+	const uint32 Result = NumDroppedRPCs;
+	NumDroppedRPCs = 0;
+	return Result;
 }
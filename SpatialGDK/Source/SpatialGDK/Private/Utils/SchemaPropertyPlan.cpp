@@ -0,0 +1,192 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/SchemaPropertyPlan.h"
+
+#include "Runtime/Launch/Resources/Version.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+#include "Utils/RepLayoutUtils.h"
+
+namespace
+{
+	// Some property classes derive from others, so the order of the checks matters.
+	void ResolveSchemaOp(UProperty* Property, SpatialGDK::ESchemaPropertyOp& OutOp, UProperty*& OutProperty)
+	{
+		using SpatialGDK::ESchemaPropertyOp;
+
+		OutProperty = Property;
+
+		if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+		{
+			OutOp = (StructProperty->Struct->StructFlags & STRUCT_NetSerializeNative) ? ESchemaPropertyOp::NetSerializeStruct : ESchemaPropertyOp::RepLayoutStruct;
+		}
+		else if (Property->IsA<UBoolProperty>())
+		{
+			OutOp = ESchemaPropertyOp::Bool;
+		}
+		else if (Property->IsA<UFloatProperty>())
+		{
+			OutOp = ESchemaPropertyOp::Float;
+		}
+		else if (Property->IsA<UDoubleProperty>())
+		{
+			OutOp = ESchemaPropertyOp::Double;
+		}
+		else if (Property->IsA<UInt8Property>())
+		{
+			OutOp = ESchemaPropertyOp::Int8;
+		}
+		else if (Property->IsA<UInt16Property>())
+		{
+			OutOp = ESchemaPropertyOp::Int16;
+		}
+		else if (Property->IsA<UIntProperty>())
+		{
+			OutOp = ESchemaPropertyOp::Int32;
+		}
+		else if (Property->IsA<UInt64Property>())
+		{
+			OutOp = ESchemaPropertyOp::Int64;
+		}
+		else if (Property->IsA<UByteProperty>())
+		{
+			OutOp = ESchemaPropertyOp::Byte;
+		}
+		else if (Property->IsA<UUInt16Property>())
+		{
+			OutOp = ESchemaPropertyOp::UInt16;
+		}
+		else if (Property->IsA<UUInt32Property>())
+		{
+			OutOp = ESchemaPropertyOp::UInt32;
+		}
+		else if (Property->IsA<UUInt64Property>())
+		{
+			OutOp = ESchemaPropertyOp::UInt64;
+		}
+		else if (Property->IsA<UObjectPropertyBase>())
+		{
+			OutOp = ESchemaPropertyOp::Object;
+		}
+		else if (Property->IsA<UNameProperty>())
+		{
+			OutOp = ESchemaPropertyOp::Name;
+		}
+		else if (Property->IsA<UStrProperty>())
+		{
+			OutOp = ESchemaPropertyOp::Str;
+		}
+		else if (Property->IsA<UTextProperty>())
+		{
+			OutOp = ESchemaPropertyOp::Text;
+		}
+		else if (Property->IsA<UArrayProperty>())
+		{
+			OutOp = ESchemaPropertyOp::Array;
+		}
+		else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
+		{
+			if (EnumProperty->ElementSize < 4)
+			{
+				OutOp = ESchemaPropertyOp::SmallEnum;
+				OutProperty = EnumProperty->GetUnderlyingProperty();
+			}
+			else
+			{
+				ResolveSchemaOp(EnumProperty->GetUnderlyingProperty(), OutOp, OutProperty);
+			}
+		}
+		else if (Property->IsA<UDelegateProperty>() || Property->IsA<UMulticastDelegateProperty>() || Property->IsA<UInterfaceProperty>())
+		{
+			// These properties can be set to replicate, but won't serialize across the network.
+			OutOp = ESchemaPropertyOp::Ignored;
+		}
+		else
+		{
+			OutOp = ESchemaPropertyOp::Unsupported;
+		}
+	}
+}
+
+namespace SpatialGDK
+{
+
+FSchemaPropertyInfo CreateSchemaPropertyInfo(UProperty* Property)
+{
+	FSchemaPropertyInfo SchemaInfo;
+	ResolveSchemaOp(Property, SchemaInfo.Op, SchemaInfo.Property);
+
+	if (SchemaInfo.Op == ESchemaPropertyOp::Array)
+	{
+		// Arrays of arrays can't be replicated, so the inner property never needs its own inner op.
+		ResolveSchemaOp(Cast<UArrayProperty>(SchemaInfo.Property)->Inner, SchemaInfo.InnerOp, SchemaInfo.InnerProperty);
+	}
+
+	return SchemaInfo;
+}
+
+FRepLayoutWritePlan CreateRepLayoutWritePlan(const FRepLayout& RepLayout)
+{
+	FRepLayoutWritePlan Plan;
+	Plan.Reserve(RepLayout.Cmds.Num());
+
+	for (const FRepLayoutCmd& Cmd : RepLayout.Cmds)
+	{
+		// Return commands mark the end of dynamic arrays and have no property.
+		Plan.Add(Cmd.Property != nullptr ? CreateSchemaPropertyInfo(Cmd.Property) : FSchemaPropertyInfo());
+	}
+
+	return Plan;
+}
+
+FRepLayoutReadPlan CreateRepLayoutReadPlan(const FRepLayout& RepLayout)
+{
+	FRepLayoutReadPlan Plan;
+	Plan.SetNum(RepLayout.BaseHandleToCmdIndex.Num() + 1);
+
+	for (int32 Handle = 1; Handle < Plan.Num(); Handle++)
+	{
+		const FRepLayoutCmd& Cmd = RepLayout.Cmds[RepLayout.BaseHandleToCmdIndex[Handle - 1].CmdIndex];
+		const FRepParentCmd& Parent = RepLayout.Parents[Cmd.ParentIndex];
+		const FRepLayoutCmd& SwappedCmd = Parent.RoleSwapIndex != -1 ? RepLayout.Cmds[RepLayout.Parents[Parent.RoleSwapIndex].CmdStart] : Cmd;
+
+		FRepFieldReadInfo& ReadInfo = Plan[Handle];
+		ReadInfo.SchemaInfo = CreateSchemaPropertyInfo(Cmd.Property);
+		ReadInfo.Property = Cmd.Property;
+		ReadInfo.ParentIndex = Cmd.ParentIndex;
+		ReadInfo.Condition = Parent.Condition;
+
+		ReadInfo.Offset = Cmd.Offset;
+		ReadInfo.SwappedOffset = SwappedCmd.Offset;
+#if ENGINE_MINOR_VERSION <= 20
+		ReadInfo.StaticBufferOffset = Cmd.Offset;
+		ReadInfo.SwappedStaticBufferOffset = SwappedCmd.Offset;
+		ReadInfo.ShadowOffset = 0;
+#else
+		ReadInfo.StaticBufferOffset = Cmd.ShadowOffset;
+		ReadInfo.SwappedStaticBufferOffset = SwappedCmd.ShadowOffset;
+		ReadInfo.ShadowOffset = Cmd.ShadowOffset;
+#endif
+
+		if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
+		{
+			ReadInfo.NetDeltaStruct = GetFastArraySerializerProperty(Cast<UArrayProperty>(Cmd.Property));
+		}
+		ReadInfo.ParentProperty = Parent.Property;
+		ReadInfo.ParentArrayIndex = Parent.ArrayIndex;
+
+		// Parent.Property is the "root" replicated property, e.g. if a struct property was flattened
+		if (Parent.Property->HasAnyPropertyFlags(CPF_RepNotify))
+		{
+			ReadInfo.RepNotifyProperty = Parent.Property;
+			ReadInfo.RepNotifyCondition = Parent.RepNotifyCondition;
+		}
+
+		ReadInfo.bIsRemoteRole = Cmd.Property->GetFName() == NAME_RemoteRole;
+	}
+
+	return Plan;
+}
+
+} // namespace SpatialGDK
@@ -0,0 +1,129 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/SpatialActorPool.h"
+
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "SpatialGDKSettings.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialActorPool);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Actors Taken From Pool"), STAT_SpatialActorPoolTaken, STATGROUP_SpatialNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Actors Returned To Pool"), STAT_SpatialActorPoolReturned, STATGROUP_SpatialNet);
+
+void USpatialActorPool::Init(USpatialNetDriver* InNetDriver)
+{
+	NetDriver = InNetDriver;
+}
+
+int32 USpatialActorPool::GetMaxPoolSize(UClass* ActorClass)
+{
+	if (const int32* MaxPoolSize = MaxPoolSizes.Find(ActorClass))
+	{
+		return *MaxPoolSize;
+	}
+
+	const int32* ConfiguredPoolSize = GetDefault<USpatialGDKSettings>()->ClientActorPoolSizes.Find(TSoftClassPtr<AActor>(ActorClass));
+	return MaxPoolSizes.Add(ActorClass, ConfiguredPoolSize != nullptr ? *ConfiguredPoolSize : 0);
+}
+
+AActor* USpatialActorPool::TakeActor(UClass* ActorClass, const FTransform& Transform)
+{
+	TArray<TWeakObjectPtr<AActor>>* Actors = PooledActors.Find(ActorClass);
+	if (Actors == nullptr)
+	{
+		return nullptr;
+	}
+
+	while (Actors->Num() > 0)
+	{
+		AActor* Actor = Actors->Pop(/* bAllowShrinking = */ false).Get();
+
+		// The actor may have been destroyed by game code while it was pooled.
+		if (Actor == nullptr || Actor->IsPendingKillPending())
+		{
+			continue;
+		}
+
+		UE_LOG(LogSpatialActorPool, Verbose, TEXT("Reusing pooled actor %s."), *Actor->GetName());
+
+		const AActor* DefaultActor = ActorClass->GetDefaultObject<AActor>();
+		Actor->SetActorTransform(Transform, /* bSweep = */ false, nullptr, ETeleportType::ResetPhysics);
+		Actor->SetActorHiddenInGame(DefaultActor->bHidden);
+		Actor->SetActorEnableCollision(DefaultActor->GetActorEnableCollision());
+		Actor->SetActorTickEnabled(DefaultActor->PrimaryActorTick.bStartWithTickEnabled);
+
+		if (Actor->GetClass()->ImplementsInterface(USpatialPooledActor::StaticClass()))
+		{
+			ISpatialPooledActor::Execute_OnTakenFromPool(Actor);
+		}
+
+		INC_DWORD_STAT(STAT_SpatialActorPoolTaken);
+		return Actor;
+	}
+
+	return nullptr;
+}
+
+bool USpatialActorPool::CanReturnActor(AActor* Actor)
+{
+	UClass* ActorClass = Actor->GetClass();
+
+	// Player controllers and singletons have bookkeeping outside of their actor channel, so they are never pooled.
+	if (ActorClass->IsChildOf<APlayerController>() || ActorClass->HasAnySpatialClassFlags(SPATIALCLASS_Singleton))
+	{
+		return false;
+	}
+
+	if (Actor->GetTearOff() || Actor->IsPendingKillPending())
+	{
+		return false;
+	}
+
+	const int32 MaxPoolSize = GetMaxPoolSize(ActorClass);
+	if (MaxPoolSize <= 0)
+	{
+		return false;
+	}
+
+	const TArray<TWeakObjectPtr<AActor>>* Actors = PooledActors.Find(ActorClass);
+	return Actors == nullptr || Actors->Num() < MaxPoolSize;
+}
+
+void USpatialActorPool::ResetForPool(AActor* Actor, const TArray<UObject*>& ReplicatedSubobjects)
+{
+	for (UObject* Subobject : ReplicatedSubobjects)
+	{
+		if (Subobject == nullptr || Subobject->IsPendingKill())
+		{
+			continue;
+		}
+
+		Actor->OnSubobjectDestroyFromReplication(Subobject);
+
+		Subobject->PreDestroyFromReplication();
+		Subobject->MarkPendingKill();
+	}
+}
+
+void USpatialActorPool::ReturnActor(AActor* Actor, const TArray<UObject*>& ReplicatedSubobjects)
+{
+	UE_LOG(LogSpatialActorPool, Verbose, TEXT("Returning actor %s to the pool."), *Actor->GetName());
+
+	ResetForPool(Actor, ReplicatedSubobjects);
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	Actor->SetOwner(nullptr);
+
+	if (Actor->GetClass()->ImplementsInterface(USpatialPooledActor::StaticClass()))
+	{
+		ISpatialPooledActor::Execute_OnReturnedToPool(Actor);
+	}
+
+	PooledActors.FindOrAdd(Actor->GetClass()).Add(Actor);
+	INC_DWORD_STAT(STAT_SpatialActorPoolReturned);
+}
@@ -0,0 +1,1043 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/SpatialBenchmarks.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Async/Async.h"
+#include "Containers/Queue.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/Parse.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+#include "Interop/Connection/OutgoingMessageQueue.h"
+#include "Interop/Connection/OutgoingMessages.h"
+#include "Interop/SpatialStaticComponentView.h"
+#include "Schema/Component.h"
+#include "Schema/StandardLibrary.h"
+#include "Schema/UnrealObjectRef.h"
+#include "Utils/ComponentFactory.h"
+#include "Utils/SchemaOption.h"
+#include "Utils/SchemaPropertyPlan.h"
+
+#include <atomic>
+
+namespace
+{
+	using namespace SpatialGDK;
+
+	// Results of the benchmarked work are folded into this, so that the compiler can't optimize the work away.
+	volatile uint64 BenchmarkSink = 0;
+
+	void AddToSink(uint64 Value)
+	{
+		BenchmarkSink = BenchmarkSink + Value;
+	}
+
+	double SecondsSince(uint64 StartCycles)
+	{
+		return FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+	}
+
+	void LogTimings(FOutputDevice& Ar, const TCHAR* Label, int64 NumOps, double BaselineSeconds, double CurrentSeconds)
+	{
+		Ar.Logf(TEXT("  %s: baseline %.1f ns/op, current %.1f ns/op, %.2fx"), Label,
+			BaselineSeconds * 1e9 / NumOps, CurrentSeconds * 1e9 / NumOps, BaselineSeconds / FMath::Max(CurrentSeconds, 1e-9));
+	}
+
+	int32 ParseCount(const TCHAR* Cmd, int32 Default)
+	{
+		const int32 Count = FCString::Atoi(*FParse::Token(Cmd, false));
+		return Count > 0 ? Count : Default;
+	}
+
+	// Outgoing messages: FOutgoingMessageQueue against the TQueue of heap allocated messages it replaced.
+
+	using FBaselineOutgoingQueue = TQueue<TUniquePtr<FOutgoingMessage>, EQueueMode::Spsc>;
+
+	const int32 OutgoingMessagesPerFrame = 1000;
+
+	void EnqueueUpdate(FBaselineOutgoingQueue& Queue, Worker_EntityId EntityId, const Worker_ComponentUpdate& Update)
+	{
+		Queue.Enqueue(MakeUnique<FComponentUpdate>(EntityId, Update));
+	}
+
+	void EnqueueUpdate(FOutgoingMessageQueue& Queue, Worker_EntityId EntityId, const Worker_ComponentUpdate& Update)
+	{
+		Queue.Enqueue<FComponentUpdate>(EntityId, Update);
+	}
+
+	bool DequeueUpdate(FBaselineOutgoingQueue& Queue, uint64& Checksum)
+	{
+		TUniquePtr<FOutgoingMessage> Message;
+		if (!Queue.Dequeue(Message))
+		{
+			return false;
+		}
+
+		Checksum += static_cast<FComponentUpdate*>(Message.Get())->EntityId;
+		return true;
+	}
+
+	bool DequeueUpdate(FOutgoingMessageQueue& Queue, uint64& Checksum)
+	{
+		FOutgoingMessage* Message = Queue.Peek();
+		if (Message == nullptr)
+		{
+			return false;
+		}
+
+		Checksum += static_cast<FComponentUpdate*>(Message)->EntityId;
+		Queue.Pop();
+		return true;
+	}
+
+	// Queues and drains the messages in bursts on the calling thread, the way a frame's worth of updates is sent.
+	template <typename QueueType>
+	double TimeOutgoingQueueBursts(int32 NumMessages)
+	{
+		QueueType Queue;
+		const Worker_ComponentUpdate Update = {};
+		uint64 Checksum = 0;
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 BurstStart = 0; BurstStart < NumMessages; BurstStart += OutgoingMessagesPerFrame)
+		{
+			const int32 BurstEnd = FMath::Min(BurstStart + OutgoingMessagesPerFrame, NumMessages);
+			for (int32 i = BurstStart; i < BurstEnd; i++)
+			{
+				EnqueueUpdate(Queue, i, Update);
+			}
+
+			while (DequeueUpdate(Queue, Checksum))
+			{
+			}
+		}
+		const double Seconds = SecondsSince(StartCycles);
+
+		AddToSink(Checksum);
+		return Seconds;
+	}
+
+	// Queues the messages on the calling thread while a background thread drains them, as the ops processing thread does.
+	template <typename QueueType>
+	double TimeOutgoingQueueAcrossThreads(int32 NumMessages)
+	{
+		QueueType Queue;
+		const Worker_ComponentUpdate Update = {};
+		std::atomic<bool> bDrained(false);
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [&Queue, &bDrained, NumMessages]
+		{
+			uint64 Checksum = 0;
+			int32 NumDequeued = 0;
+			while (NumDequeued < NumMessages)
+			{
+				if (DequeueUpdate(Queue, Checksum))
+				{
+					NumDequeued++;
+				}
+				else
+				{
+					FPlatformProcess::Yield();
+				}
+			}
+
+			AddToSink(Checksum);
+			bDrained.store(true, std::memory_order_release);
+		});
+
+		for (int32 i = 0; i < NumMessages; i++)
+		{
+			EnqueueUpdate(Queue, i, Update);
+		}
+
+		while (!bDrained.load(std::memory_order_acquire))
+		{
+			FPlatformProcess::Yield();
+		}
+
+		return SecondsSince(StartCycles);
+	}
+
+	void RunOutgoingQueueBenchmark(const TCHAR* Cmd, FOutputDevice& Ar)
+	{
+		const int32 NumMessages = ParseCount(Cmd, 1000000);
+
+		Ar.Logf(TEXT("OutgoingQueue: %d component updates, TQueue of heap allocated messages against FOutgoingMessageQueue"), NumMessages);
+		LogTimings(Ar, TEXT("Bursts of 1000 on one thread"), NumMessages,
+			TimeOutgoingQueueBursts<FBaselineOutgoingQueue>(NumMessages), TimeOutgoingQueueBursts<FOutgoingMessageQueue>(NumMessages));
+		LogTimings(Ar, TEXT("Game thread to background thread"), NumMessages,
+			TimeOutgoingQueueAcrossThreads<FBaselineOutgoingQueue>(NumMessages), TimeOutgoingQueueAcrossThreads<FOutgoingMessageQueue>(NumMessages));
+	}
+
+	// Static component view: the dense entity records against the nested maps of authority and component data they replaced.
+
+	// Stands in for a generated component, which is stored outside the well-known component bitsets.
+	const Worker_ComponentId BenchmarkGeneratedComponentId = 10000;
+
+	const int32 EntityStoreLookups = 1000000;
+
+	struct FBaselineComponentView
+	{
+		Worker_Authority GetAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+		{
+			if (TMap<Worker_ComponentId, Worker_Authority>* ComponentAuthorityMap = EntityComponentAuthorityMap.Find(EntityId))
+			{
+				if (Worker_Authority* Authority = ComponentAuthorityMap->Find(ComponentId))
+				{
+					return *Authority;
+				}
+			}
+
+			return WORKER_AUTHORITY_NOT_AUTHORITATIVE;
+		}
+
+		bool HasAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+		{
+			return GetAuthority(EntityId, ComponentId) == WORKER_AUTHORITY_AUTHORITATIVE;
+		}
+
+		bool HasComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+		{
+			if (TMap<Worker_ComponentId, TUniquePtr<ComponentStorageBase>>* ComponentStorageMap = EntityComponentMap.Find(EntityId))
+			{
+				return ComponentStorageMap->Contains(ComponentId);
+			}
+
+			return false;
+		}
+
+		template <typename T>
+		T* GetComponentData(Worker_EntityId EntityId)
+		{
+			if (TMap<Worker_ComponentId, TUniquePtr<ComponentStorageBase>>* ComponentStorageMap = EntityComponentMap.Find(EntityId))
+			{
+				if (TUniquePtr<ComponentStorageBase>* Component = ComponentStorageMap->Find(T::ComponentId))
+				{
+					return &(static_cast<ComponentStorage<T>*>(Component->Get())->Get());
+				}
+			}
+
+			return nullptr;
+		}
+
+		TMap<Worker_EntityId_Key, TMap<Worker_ComponentId, Worker_Authority>> EntityComponentAuthorityMap;
+		TMap<Worker_EntityId_Key, TMap<Worker_ComponentId, TUniquePtr<ComponentStorageBase>>> EntityComponentMap;
+	};
+
+	// Each entity has an authoritative Position, with data, and a generated component it isn't authoritative over.
+	void AddBenchmarkEntity(FBaselineComponentView& View, Worker_EntityId EntityId, const Worker_ComponentData& PositionData)
+	{
+		TMap<Worker_ComponentId, TUniquePtr<ComponentStorageBase>>& Components = View.EntityComponentMap.Add(EntityId);
+		Components.Add(SpatialConstants::POSITION_COMPONENT_ID, MakeUnique<ComponentStorage<Position>>(Position(PositionData)));
+		Components.Add(BenchmarkGeneratedComponentId, nullptr);
+
+		TMap<Worker_ComponentId, Worker_Authority>& Authority = View.EntityComponentAuthorityMap.Add(EntityId);
+		Authority.Add(SpatialConstants::POSITION_COMPONENT_ID, WORKER_AUTHORITY_AUTHORITATIVE);
+		Authority.Add(BenchmarkGeneratedComponentId, WORKER_AUTHORITY_NOT_AUTHORITATIVE);
+	}
+
+	void AddBenchmarkEntity(USpatialStaticComponentView& View, Worker_EntityId EntityId, const Worker_ComponentData& PositionData)
+	{
+		Worker_AddComponentOp AddComponentOp = {};
+		AddComponentOp.entity_id = EntityId;
+		AddComponentOp.data = PositionData;
+		View.OnAddComponent(AddComponentOp);
+
+		AddComponentOp.data = ComponentFactory::CreateEmptyComponentData(BenchmarkGeneratedComponentId);
+		View.OnAddComponent(AddComponentOp);
+		Schema_DestroyComponentData(AddComponentOp.data.schema_type);
+
+		Worker_AuthorityChangeOp AuthorityChangeOp = {};
+		AuthorityChangeOp.entity_id = EntityId;
+		AuthorityChangeOp.component_id = SpatialConstants::POSITION_COMPONENT_ID;
+		AuthorityChangeOp.authority = WORKER_AUTHORITY_AUTHORITATIVE;
+		View.OnAuthorityChange(AuthorityChangeOp);
+
+		AuthorityChangeOp.component_id = BenchmarkGeneratedComponentId;
+		AuthorityChangeOp.authority = WORKER_AUTHORITY_NOT_AUTHORITATIVE;
+		View.OnAuthorityChange(AuthorityChangeOp);
+	}
+
+	// Does the lookups made for an entity when one of its RPCs is sent or an update to it is applied.
+	template <typename ViewType>
+	double TimeEntityStoreLookups(ViewType& View, const TArray<Worker_EntityId>& EntityIds)
+	{
+		uint64 Checksum = 0;
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (Worker_EntityId EntityId : EntityIds)
+		{
+			Checksum += View.HasAuthority(EntityId, SpatialConstants::POSITION_COMPONENT_ID) ? 1 : 0;
+			Checksum += View.HasComponent(EntityId, BenchmarkGeneratedComponentId) ? 1 : 0;
+			if (Position* EntityPosition = View.template GetComponentData<Position>(EntityId))
+			{
+				Checksum += static_cast<uint64>(EntityPosition->Coords.X);
+			}
+		}
+		const double Seconds = SecondsSince(StartCycles);
+
+		AddToSink(Checksum);
+		return Seconds;
+	}
+
+	void RunEntityStoreBenchmark(const TCHAR* Cmd, FOutputDevice& Ar)
+	{
+		TArray<int32> EntityCounts;
+		for (FString Token = FParse::Token(Cmd, false); !Token.IsEmpty(); Token = FParse::Token(Cmd, false))
+		{
+			const int32 EntityCount = FCString::Atoi(*Token);
+			if (EntityCount > 0)
+			{
+				EntityCounts.Add(EntityCount);
+			}
+		}
+
+		if (EntityCounts.Num() == 0)
+		{
+			EntityCounts = { 10000, 100000, 500000 };
+		}
+
+		Worker_ComponentData PositionData = Position(Coordinates{ 1.0, 2.0, 3.0 }).CreatePositionData();
+
+		Ar.Logf(TEXT("EntityStore: %d random lookups of Position authority, a generated component and Position data, nested maps against USpatialStaticComponentView"), EntityStoreLookups);
+		for (int32 EntityCount : EntityCounts)
+		{
+			FBaselineComponentView BaselineView;
+			USpatialStaticComponentView* CurrentView = NewObject<USpatialStaticComponentView>();
+			for (int32 i = 1; i <= EntityCount; i++)
+			{
+				AddBenchmarkEntity(BaselineView, i, PositionData);
+				AddBenchmarkEntity(*CurrentView, i, PositionData);
+			}
+
+			FRandomStream Random(EntityCount);
+			TArray<Worker_EntityId> EntityIds;
+			EntityIds.SetNumUninitialized(EntityStoreLookups);
+			for (Worker_EntityId& EntityId : EntityIds)
+			{
+				EntityId = Random.RandRange(1, EntityCount);
+			}
+
+			LogTimings(Ar, *FString::Printf(TEXT("%d entities"), EntityCount), EntityStoreLookups,
+				TimeEntityStoreLookups(BaselineView, EntityIds), TimeEntityStoreLookups(*CurrentView, EntityIds));
+
+			// The records would otherwise be kept until the view is garbage collected.
+			for (int32 i = 1; i <= EntityCount; i++)
+			{
+				CurrentView->OnRemoveEntity(i);
+			}
+		}
+
+		Schema_DestroyComponentData(PositionData.schema_type);
+	}
+
+	// Property writes: per-class write plans against the chain of casts ComponentFactory::AddProperty used before them.
+
+	const int32 SyntheticActorCount = 10000;
+
+	struct FBenchmarkField
+	{
+		Schema_FieldId FieldId;
+		UProperty* Property;
+		FSchemaPropertyInfo SchemaInfo;
+	};
+
+	// Other property types need a package map or a net driver to be written, so they are left out.
+	bool IsBenchmarkedWriteOp(ESchemaPropertyOp Op)
+	{
+		switch (Op)
+		{
+		case ESchemaPropertyOp::Bool:
+		case ESchemaPropertyOp::Float:
+		case ESchemaPropertyOp::Double:
+		case ESchemaPropertyOp::Int8:
+		case ESchemaPropertyOp::Int16:
+		case ESchemaPropertyOp::Int32:
+		case ESchemaPropertyOp::Int64:
+		case ESchemaPropertyOp::Byte:
+		case ESchemaPropertyOp::UInt16:
+		case ESchemaPropertyOp::UInt32:
+		case ESchemaPropertyOp::UInt64:
+		case ESchemaPropertyOp::SmallEnum:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// The old AddProperty, down to enums. The struct, object, string and array checks come first, so they are kept.
+	void AddValueWithCasts(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data)
+	{
+		if (Cast<UStructProperty>(Property))
+		{
+			// Not benchmarked.
+		}
+		else if (UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property))
+		{
+			Schema_AddBool(Object, FieldId, (uint8)BoolProperty->GetPropertyValue(Data));
+		}
+		else if (UFloatProperty* FloatProperty = Cast<UFloatProperty>(Property))
+		{
+			Schema_AddFloat(Object, FieldId, FloatProperty->GetPropertyValue(Data));
+		}
+		else if (UDoubleProperty* DoubleProperty = Cast<UDoubleProperty>(Property))
+		{
+			Schema_AddDouble(Object, FieldId, DoubleProperty->GetPropertyValue(Data));
+		}
+		else if (UInt8Property* Int8Property = Cast<UInt8Property>(Property))
+		{
+			Schema_AddInt32(Object, FieldId, (int32)Int8Property->GetPropertyValue(Data));
+		}
+		else if (UInt16Property* Int16Property = Cast<UInt16Property>(Property))
+		{
+			Schema_AddInt32(Object, FieldId, (int32)Int16Property->GetPropertyValue(Data));
+		}
+		else if (UIntProperty* IntProperty = Cast<UIntProperty>(Property))
+		{
+			Schema_AddInt32(Object, FieldId, IntProperty->GetPropertyValue(Data));
+		}
+		else if (UInt64Property* Int64Property = Cast<UInt64Property>(Property))
+		{
+			Schema_AddInt64(Object, FieldId, Int64Property->GetPropertyValue(Data));
+		}
+		else if (UByteProperty* ByteProperty = Cast<UByteProperty>(Property))
+		{
+			Schema_AddUint32(Object, FieldId, (uint32)ByteProperty->GetPropertyValue(Data));
+		}
+		else if (UUInt16Property* UInt16Property = Cast<UUInt16Property>(Property))
+		{
+			Schema_AddUint32(Object, FieldId, (uint32)UInt16Property->GetPropertyValue(Data));
+		}
+		else if (UUInt32Property* UInt32Property = Cast<UUInt32Property>(Property))
+		{
+			Schema_AddUint32(Object, FieldId, UInt32Property->GetPropertyValue(Data));
+		}
+		else if (UUInt64Property* UInt64Property = Cast<UUInt64Property>(Property))
+		{
+			Schema_AddUint64(Object, FieldId, UInt64Property->GetPropertyValue(Data));
+		}
+		else if (Cast<UObjectPropertyBase>(Property) || Cast<UNameProperty>(Property) || Cast<UStrProperty>(Property) || Cast<UTextProperty>(Property) || Cast<UArrayProperty>(Property))
+		{
+			// Not benchmarked.
+		}
+		else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
+		{
+			if (EnumProperty->ElementSize < 4)
+			{
+				Schema_AddUint32(Object, FieldId, (uint32)EnumProperty->GetUnderlyingProperty()->GetUnsignedIntPropertyValue(Data));
+			}
+			else
+			{
+				AddValueWithCasts(Object, FieldId, EnumProperty->GetUnderlyingProperty(), Data);
+			}
+		}
+	}
+
+	// The cases of ComponentFactory::AddValue for the benchmarked ops.
+	void AddValueWithPlan(Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op, UProperty* Property, const uint8* Data)
+	{
+		switch (Op)
+		{
+		case ESchemaPropertyOp::Bool:
+			Schema_AddBool(Object, FieldId, (uint8)static_cast<UBoolProperty*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::Float:
+			Schema_AddFloat(Object, FieldId, static_cast<UFloatProperty*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::Double:
+			Schema_AddDouble(Object, FieldId, static_cast<UDoubleProperty*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::Int8:
+			Schema_AddInt32(Object, FieldId, (int32)static_cast<UInt8Property*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::Int16:
+			Schema_AddInt32(Object, FieldId, (int32)static_cast<UInt16Property*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::Int32:
+			Schema_AddInt32(Object, FieldId, static_cast<UIntProperty*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::Int64:
+			Schema_AddInt64(Object, FieldId, static_cast<UInt64Property*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::Byte:
+			Schema_AddUint32(Object, FieldId, (uint32)static_cast<UByteProperty*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::UInt16:
+			Schema_AddUint32(Object, FieldId, (uint32)static_cast<UUInt16Property*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::UInt32:
+			Schema_AddUint32(Object, FieldId, static_cast<UUInt32Property*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::UInt64:
+			Schema_AddUint64(Object, FieldId, static_cast<UUInt64Property*>(Property)->GetPropertyValue(Data));
+			break;
+		case ESchemaPropertyOp::SmallEnum:
+			Schema_AddUint32(Object, FieldId, (uint32)static_cast<UNumericProperty*>(Property)->GetUnsignedIntPropertyValue(Data));
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Writes every field of every actor into its own component data, as a component update is built per actor.
+	template <typename WriteFieldType>
+	double TimePropertyWrites(const TArray<FBenchmarkField>& Fields, const TArray<uint8>& ActorData, int32 ActorSize, WriteFieldType WriteField)
+	{
+		uint64 Checksum = 0;
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 ActorIndex = 0; ActorIndex < SyntheticActorCount; ActorIndex++)
+		{
+			const uint8* Actor = ActorData.GetData() + ActorIndex * ActorSize;
+			Schema_ComponentData* ComponentData = Schema_CreateComponentData(BenchmarkGeneratedComponentId);
+			Schema_Object* Object = Schema_GetComponentDataFields(ComponentData);
+
+			for (const FBenchmarkField& Field : Fields)
+			{
+				WriteField(Object, Field, Field.Property->ContainerPtrToValuePtr<uint8>(Actor));
+			}
+
+			Checksum += Schema_GetWriteBufferLength(Object);
+			Schema_DestroyComponentData(ComponentData);
+		}
+		const double Seconds = SecondsSince(StartCycles);
+
+		AddToSink(Checksum);
+		return Seconds;
+	}
+
+	void RunPropertyWriteBenchmark(const TCHAR* Cmd, FOutputDevice& Ar)
+	{
+		FString ClassName = FParse::Token(Cmd, false);
+		if (ClassName.IsEmpty())
+		{
+			ClassName = TEXT("CharacterMovementComponent");
+		}
+
+		UClass* Class = FindObject<UClass>(ANY_PACKAGE, *ClassName);
+		if (Class == nullptr)
+		{
+			Ar.Logf(TEXT("PropertyWrite: couldn't find class %s"), *ClassName);
+			return;
+		}
+
+		// All of the class's properties are used, not just replicated ones, to get enough of a mix from engine classes.
+		TArray<FBenchmarkField> Fields;
+		for (TFieldIterator<UProperty> It(Class); It; ++It)
+		{
+			const FSchemaPropertyInfo SchemaInfo = CreateSchemaPropertyInfo(*It);
+			if (It->ArrayDim == 1 && IsBenchmarkedWriteOp(SchemaInfo.Op))
+			{
+				Fields.Add(FBenchmarkField{ static_cast<Schema_FieldId>(Fields.Num() + 1), *It, SchemaInfo });
+			}
+		}
+
+		if (Fields.Num() == 0)
+		{
+			Ar.Logf(TEXT("PropertyWrite: %s has no bool, numeric or enum properties"), *ClassName);
+			return;
+		}
+
+		// Property values are only read, so random bytes stand in for the state of each actor.
+		const int32 ActorSize = Align(Class->GetPropertiesSize(), Class->GetMinAlignment());
+		TArray<uint8> ActorData;
+		ActorData.SetNumUninitialized(ActorSize * SyntheticActorCount);
+		FRandomStream Random(ActorSize);
+		for (uint8& Byte : ActorData)
+		{
+			Byte = static_cast<uint8>(Random.RandHelper(256));
+		}
+
+		const double CastSeconds = TimePropertyWrites(Fields, ActorData, ActorSize, [](Schema_Object* Object, const FBenchmarkField& Field, const uint8* Data)
+		{
+			AddValueWithCasts(Object, Field.FieldId, Field.Property, Data);
+		});
+		const double PlanSeconds = TimePropertyWrites(Fields, ActorData, ActorSize, [](Schema_Object* Object, const FBenchmarkField& Field, const uint8* Data)
+		{
+			AddValueWithPlan(Object, Field.FieldId, Field.SchemaInfo.Op, Field.SchemaInfo.Property, Data);
+		});
+
+		Ar.Logf(TEXT("PropertyWrite: %d synthetic %s actors with %d bool, numeric and enum properties each, cast chain against write plan"),
+			SyntheticActorCount, *ClassName, Fields.Num());
+		LogTimings(Ar, TEXT("Per property"), static_cast<int64>(SyntheticActorCount) * Fields.Num(), CastSeconds, PlanSeconds);
+	}
+
+	// Primitive arrays: whole schema lists against one schema call per element. Before lists were used, each element also
+	// went through the AddProperty cast chain, which PropertyWrite measures, so only the schema calls are compared here.
+
+	struct FBenchmarkArray
+	{
+		ESchemaPropertyOp Op;
+		int32 Num;
+	};
+
+	// An inventory is a list of item IDs with a stack count for each. Stats are a list of values with a flag for each.
+	const FBenchmarkArray InventoryArrays[] = { { ESchemaPropertyOp::Int32, 256 }, { ESchemaPropertyOp::Byte, 256 } };
+	const FBenchmarkArray StatArrays[] = { { ESchemaPropertyOp::Float, 64 }, { ESchemaPropertyOp::Bool, 64 } };
+
+	using FAddElementsFunction = void (*)(Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op, const uint8* Elements, int32 Num);
+	using FGetElementsFunction = void (*)(const Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op, TArray<uint8>& OutElements);
+
+	int32 GetBenchmarkElementSize(ESchemaPropertyOp Op)
+	{
+		return (Op == ESchemaPropertyOp::Int32 || Op == ESchemaPropertyOp::Float) ? 4 : 1;
+	}
+
+	void AddElementsOneByOne(Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op, const uint8* Elements, int32 Num)
+	{
+		for (int32 i = 0; i < Num; i++)
+		{
+			switch (Op)
+			{
+			case ESchemaPropertyOp::Bool:
+				Schema_AddBool(Object, FieldId, Elements[i]);
+				break;
+			case ESchemaPropertyOp::Byte:
+				Schema_AddUint32(Object, FieldId, (uint32)Elements[i]);
+				break;
+			case ESchemaPropertyOp::Int32:
+				Schema_AddInt32(Object, FieldId, reinterpret_cast<const int32*>(Elements)[i]);
+				break;
+			case ESchemaPropertyOp::Float:
+				Schema_AddFloat(Object, FieldId, reinterpret_cast<const float*>(Elements)[i]);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	// As AddPrimitiveList in ComponentFactory, for the benchmarked ops.
+	void AddElementsAsList(Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op, const uint8* Elements, int32 Num)
+	{
+		switch (Op)
+		{
+		case ESchemaPropertyOp::Bool:
+			Schema_AddBoolList(Object, FieldId, Elements, Num);
+			break;
+		case ESchemaPropertyOp::Byte:
+		{
+			TArray<uint32, TInlineAllocator<64>> Values;
+			Values.SetNumUninitialized(Num);
+			for (int32 i = 0; i < Num; i++)
+			{
+				Values[i] = (uint32)Elements[i];
+			}
+			Schema_AddUint32List(Object, FieldId, Values.GetData(), Num);
+			break;
+		}
+		case ESchemaPropertyOp::Int32:
+			Schema_AddInt32List(Object, FieldId, reinterpret_cast<const int32*>(Elements), Num);
+			break;
+		case ESchemaPropertyOp::Float:
+			Schema_AddFloatList(Object, FieldId, reinterpret_cast<const float*>(Elements), Num);
+			break;
+		default:
+			break;
+		}
+	}
+
+	void GetElementsOneByOne(const Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op, TArray<uint8>& OutElements)
+	{
+		switch (Op)
+		{
+		case ESchemaPropertyOp::Bool:
+		{
+			const uint32 Num = Schema_GetBoolCount(Object, FieldId);
+			OutElements.SetNumUninitialized(Num);
+			for (uint32 i = 0; i < Num; i++)
+			{
+				OutElements[i] = Schema_IndexBool(Object, FieldId, i) != 0;
+			}
+			break;
+		}
+		case ESchemaPropertyOp::Byte:
+		{
+			const uint32 Num = Schema_GetUint32Count(Object, FieldId);
+			OutElements.SetNumUninitialized(Num);
+			for (uint32 i = 0; i < Num; i++)
+			{
+				OutElements[i] = (uint8)Schema_IndexUint32(Object, FieldId, i);
+			}
+			break;
+		}
+		case ESchemaPropertyOp::Int32:
+		{
+			const uint32 Num = Schema_GetInt32Count(Object, FieldId);
+			OutElements.SetNumUninitialized(Num * sizeof(int32));
+			for (uint32 i = 0; i < Num; i++)
+			{
+				reinterpret_cast<int32*>(OutElements.GetData())[i] = Schema_IndexInt32(Object, FieldId, i);
+			}
+			break;
+		}
+		case ESchemaPropertyOp::Float:
+		{
+			const uint32 Num = Schema_GetFloatCount(Object, FieldId);
+			OutElements.SetNumUninitialized(Num * sizeof(float));
+			for (uint32 i = 0; i < Num; i++)
+			{
+				reinterpret_cast<float*>(OutElements.GetData())[i] = Schema_IndexFloat(Object, FieldId, i);
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// As ApplyPrimitiveList in ComponentReader, for the benchmarked ops.
+	void GetElementsAsList(const Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op, TArray<uint8>& OutElements)
+	{
+		switch (Op)
+		{
+		case ESchemaPropertyOp::Bool:
+			OutElements.SetNumUninitialized(Schema_GetBoolCount(Object, FieldId));
+			Schema_GetBoolList(Object, FieldId, OutElements.GetData());
+			for (uint8& Element : OutElements)
+			{
+				Element = Element != 0;
+			}
+			break;
+		case ESchemaPropertyOp::Byte:
+		{
+			TArray<uint32, TInlineAllocator<64>> Values;
+			Values.SetNumUninitialized(Schema_GetUint32Count(Object, FieldId));
+			Schema_GetUint32List(Object, FieldId, Values.GetData());
+			OutElements.SetNumUninitialized(Values.Num());
+			for (int32 i = 0; i < Values.Num(); i++)
+			{
+				OutElements[i] = (uint8)Values[i];
+			}
+			break;
+		}
+		case ESchemaPropertyOp::Int32:
+			OutElements.SetNumUninitialized(Schema_GetInt32Count(Object, FieldId) * sizeof(int32));
+			Schema_GetInt32List(Object, FieldId, reinterpret_cast<int32*>(OutElements.GetData()));
+			break;
+		case ESchemaPropertyOp::Float:
+			OutElements.SetNumUninitialized(Schema_GetFloatCount(Object, FieldId) * sizeof(float));
+			Schema_GetFloatList(Object, FieldId, reinterpret_cast<float*>(OutElements.GetData()));
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Writes the arrays of every actor into its own component data, then reads them all back.
+	void TimeArrayWritesAndReads(const FBenchmarkArray* Arrays, int32 NumArrays, const TArray<TArray<uint8>>& Elements,
+		FAddElementsFunction AddElements, FGetElementsFunction GetElements, double& OutWriteSeconds, double& OutReadSeconds)
+	{
+		TArray<Schema_ComponentData*> ComponentDatas;
+		ComponentDatas.SetNumUninitialized(SyntheticActorCount);
+
+		const uint64 WriteStartCycles = FPlatformTime::Cycles64();
+		for (Schema_ComponentData*& ComponentData : ComponentDatas)
+		{
+			ComponentData = Schema_CreateComponentData(BenchmarkGeneratedComponentId);
+			Schema_Object* Object = Schema_GetComponentDataFields(ComponentData);
+			for (int32 i = 0; i < NumArrays; i++)
+			{
+				AddElements(Object, i + 1, Arrays[i].Op, Elements[i].GetData(), Arrays[i].Num);
+			}
+		}
+		OutWriteSeconds = SecondsSince(WriteStartCycles);
+
+		TArray<uint8> ReadElements;
+		uint64 Checksum = 0;
+
+		const uint64 ReadStartCycles = FPlatformTime::Cycles64();
+		for (Schema_ComponentData* ComponentData : ComponentDatas)
+		{
+			const Schema_Object* Object = Schema_GetComponentDataFields(ComponentData);
+			for (int32 i = 0; i < NumArrays; i++)
+			{
+				GetElements(Object, i + 1, Arrays[i].Op, ReadElements);
+				Checksum += ReadElements.Num();
+			}
+		}
+		OutReadSeconds = SecondsSince(ReadStartCycles);
+
+		for (Schema_ComponentData* ComponentData : ComponentDatas)
+		{
+			Schema_DestroyComponentData(ComponentData);
+		}
+
+		AddToSink(Checksum);
+	}
+
+	void TimeArrayProfile(FOutputDevice& Ar, const TCHAR* ProfileName, const FBenchmarkArray* Arrays, int32 NumArrays)
+	{
+		// Every actor has the same values, since they don't affect the cost of writing or reading them.
+		TArray<TArray<uint8>> Elements;
+		Elements.SetNum(NumArrays);
+		FRandomStream Random(NumArrays);
+		int64 NumElements = 0;
+		for (int32 i = 0; i < NumArrays; i++)
+		{
+			TArray<uint8>& ArrayElements = Elements[i];
+			ArrayElements.SetNumUninitialized(Arrays[i].Num * GetBenchmarkElementSize(Arrays[i].Op));
+			for (uint8& Byte : ArrayElements)
+			{
+				Byte = static_cast<uint8>(Random.RandHelper(Arrays[i].Op == ESchemaPropertyOp::Bool ? 2 : 256));
+			}
+			NumElements += static_cast<int64>(SyntheticActorCount) * Arrays[i].Num;
+		}
+
+		double ElementWriteSeconds, ElementReadSeconds, ListWriteSeconds, ListReadSeconds;
+		TimeArrayWritesAndReads(Arrays, NumArrays, Elements, &AddElementsOneByOne, &GetElementsOneByOne, ElementWriteSeconds, ElementReadSeconds);
+		TimeArrayWritesAndReads(Arrays, NumArrays, Elements, &AddElementsAsList, &GetElementsAsList, ListWriteSeconds, ListReadSeconds);
+
+		LogTimings(Ar, *FString::Printf(TEXT("%s write"), ProfileName), NumElements, ElementWriteSeconds, ListWriteSeconds);
+		LogTimings(Ar, *FString::Printf(TEXT("%s read"), ProfileName), NumElements, ElementReadSeconds, ListReadSeconds);
+	}
+
+	void RunPrimitiveArrayBenchmark(const TCHAR* Cmd, FOutputDevice& Ar)
+	{
+		Ar.Logf(TEXT("PrimitiveArray: %d synthetic actors, one schema call per element against schema lists, per element"), SyntheticActorCount);
+		TimeArrayProfile(Ar, TEXT("Inventory (256 int32 item IDs, 256 uint8 counts)"), InventoryArrays, ARRAY_COUNT(InventoryArrays));
+		TimeArrayProfile(Ar, TEXT("Stats (64 floats, 64 bools)"), StatArrays, ARRAY_COUNT(StatArrays));
+	}
+
+	// Object refs: interned paths against the deep copied path strings and outer chains FUnrealObjectRef had before.
+
+	// FUnrealObjectRef as it was before its paths were interned.
+	struct FDeepObjectRef
+	{
+		FDeepObjectRef() = default;
+
+		FDeepObjectRef(Worker_EntityId InEntity, uint32 InOffset)
+			: Entity(InEntity)
+			, Offset(InOffset)
+		{}
+
+		FDeepObjectRef(Worker_EntityId InEntity, uint32 InOffset, const FString& InPath, const FDeepObjectRef& InOuter)
+			: Entity(InEntity)
+			, Offset(InOffset)
+			, Path(InPath)
+			, Outer(InOuter)
+		{}
+
+		bool operator==(const FDeepObjectRef& Other) const
+		{
+			return Entity == Other.Entity &&
+				Offset == Other.Offset &&
+				((!Path && !Other.Path) || (Path && Other.Path && Path->Equals(*Other.Path))) &&
+				((!Outer && !Other.Outer) || (Outer && Other.Outer && *Outer == *Other.Outer));
+		}
+
+		void SetPathAndOuter(const FString* InPath, const FDeepObjectRef* InOuter)
+		{
+			Path = InPath != nullptr ? TSchemaOption<FString>(*InPath) : TSchemaOption<FString>();
+			Outer = InOuter != nullptr ? TSchemaOption<FDeepObjectRef>(*InOuter) : TSchemaOption<FDeepObjectRef>();
+		}
+
+		Worker_EntityId Entity = 0;
+		uint32 Offset = 0;
+		TSchemaOption<FString> Path;
+		TSchemaOption<FDeepObjectRef> Outer;
+		bool bNoLoadOnClient = false;
+	};
+
+	// Qualified, since this overload hides the global ones.
+	uint32 GetTypeHash(const FDeepObjectRef& ObjectRef)
+	{
+		uint32 Result = 1327u;
+		Result = (Result * 977u) + ::GetTypeHash(static_cast<int64>(ObjectRef.Entity));
+		Result = (Result * 977u) + ::GetTypeHash(ObjectRef.Offset);
+		Result = (Result * 977u) + ::GetTypeHash(ObjectRef.Path);
+		Result = (Result * 977u) + ::GetTypeHash(ObjectRef.Outer);
+		return Result;
+	}
+
+	SIZE_T GetObjectRefSize(const FDeepObjectRef& ObjectRef)
+	{
+		SIZE_T Size = sizeof(FDeepObjectRef);
+		if (ObjectRef.Path)
+		{
+			Size += sizeof(FString) + ObjectRef.Path->GetAllocatedSize();
+		}
+		if (ObjectRef.Outer)
+		{
+			Size += GetObjectRefSize(*ObjectRef.Outer);
+		}
+		return Size;
+	}
+
+	// The interned path is shared by all refs to the same object, so it isn't counted.
+	SIZE_T GetObjectRefSize(const FUnrealObjectRef&)
+	{
+		return sizeof(FUnrealObjectRef);
+	}
+
+	// Refs to startup actors: an actor in the persistent level of one of the maps.
+	const int32 ObjectRefMapCount = 100;
+	const int32 ObjectRefActorsPerMap = 100;
+
+	struct FObjectRefTimings
+	{
+		double ConstructSeconds;
+		double CopySeconds;
+		double LookupSeconds;
+		SIZE_T CopiesSize;
+	};
+
+	template <typename RefType>
+	FObjectRefTimings TimeObjectRefs(const TArray<FString>& MapPaths, const TArray<FString>& ActorNames, const TArray<int32>& ActorIndices)
+	{
+		const FString LevelName = TEXT("PersistentLevel");
+
+		TArray<RefType> LevelRefs;
+		for (const FString& MapPath : MapPaths)
+		{
+			RefType MapRef(0, 0);
+			MapRef.SetPathAndOuter(&MapPath, nullptr);
+			LevelRefs.Add(RefType(0, 0, LevelName, MapRef));
+		}
+
+		FObjectRefTimings Timings;
+		uint64 Checksum = 0;
+
+		// As refs are created when they're read from schema.
+		TArray<RefType> ActorRefs;
+		ActorRefs.Reserve(ActorIndices.Num());
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 ActorIndex : ActorIndices)
+		{
+			ActorRefs.Add(RefType(0, 0, ActorNames[ActorIndex], LevelRefs[ActorIndex / ObjectRefActorsPerMap]));
+		}
+		Timings.ConstructSeconds = SecondsSince(StartCycles);
+
+		// As refs are copied into and out of the net GUID cache and the receiver's maps.
+		TArray<RefType> Copies;
+		Copies.Reserve(ActorRefs.Num());
+		StartCycles = FPlatformTime::Cycles64();
+		for (const RefType& ActorRef : ActorRefs)
+		{
+			Copies.Add(ActorRef);
+		}
+		Timings.CopySeconds = SecondsSince(StartCycles);
+
+		// Deep copied refs take hundreds of bytes each, so don't keep both arrays around at 1M refs.
+		ActorRefs.Empty();
+
+		// As the net GUID cache looks up the net GUIDs of refs, with an entry for each distinct actor.
+		TMap<RefType, int32> RefToIndex;
+		for (int32 ActorIndex = 0; ActorIndex < ActorNames.Num(); ActorIndex++)
+		{
+			RefToIndex.Add(RefType(0, 0, ActorNames[ActorIndex], LevelRefs[ActorIndex / ObjectRefActorsPerMap]), ActorIndex);
+		}
+
+		StartCycles = FPlatformTime::Cycles64();
+		for (const RefType& Copy : Copies)
+		{
+			if (const int32* Index = RefToIndex.Find(Copy))
+			{
+				Checksum += *Index;
+			}
+		}
+		Timings.LookupSeconds = SecondsSince(StartCycles);
+
+		Timings.CopiesSize = 0;
+		for (const RefType& Copy : Copies)
+		{
+			Timings.CopiesSize += GetObjectRefSize(Copy);
+		}
+
+		AddToSink(Checksum);
+		return Timings;
+	}
+
+	void RunObjectRefBenchmark(const TCHAR* Cmd, FOutputDevice& Ar)
+	{
+		const int32 NumRefs = ParseCount(Cmd, 1000000);
+
+		TArray<FString> MapPaths;
+		for (int32 MapIndex = 0; MapIndex < ObjectRefMapCount; MapIndex++)
+		{
+			MapPaths.Add(FString::Printf(TEXT("/Game/Maps/SpatialBenchmark/BenchmarkMap_%d"), MapIndex));
+		}
+
+		TArray<FString> ActorNames;
+		for (int32 ActorIndex = 0; ActorIndex < ObjectRefMapCount * ObjectRefActorsPerMap; ActorIndex++)
+		{
+			ActorNames.Add(FString::Printf(TEXT("BenchmarkStartupActor_%d"), ActorIndex));
+		}
+
+		FRandomStream Random(NumRefs);
+		TArray<int32> ActorIndices;
+		ActorIndices.SetNumUninitialized(NumRefs);
+		for (int32& ActorIndex : ActorIndices)
+		{
+			ActorIndex = Random.RandHelper(ActorNames.Num());
+		}
+
+		const FObjectRefTimings Deep = TimeObjectRefs<FDeepObjectRef>(MapPaths, ActorNames, ActorIndices);
+		const FObjectRefTimings Interned = TimeObjectRefs<FUnrealObjectRef>(MapPaths, ActorNames, ActorIndices);
+
+		Ar.Logf(TEXT("ObjectRef: %d refs to %d distinct startup actors, deep copied paths against interned paths"), NumRefs, ActorNames.Num());
+		LogTimings(Ar, TEXT("Construct from path and outer"), NumRefs, Deep.ConstructSeconds, Interned.ConstructSeconds);
+		LogTimings(Ar, TEXT("Copy"), NumRefs, Deep.CopySeconds, Interned.CopySeconds);
+		LogTimings(Ar, TEXT("Map lookup"), NumRefs, Deep.LookupSeconds, Interned.LookupSeconds);
+		Ar.Logf(TEXT("  Memory: baseline %.1f MB, current %.1f MB, plus one path table entry for each of the %d distinct paths"),
+			Deep.CopiesSize / (1024.0 * 1024.0), Interned.CopiesSize / (1024.0 * 1024.0), ObjectRefMapCount * (ObjectRefActorsPerMap + 2));
+	}
+
+	struct FBenchmark
+	{
+		const TCHAR* Name;
+		const TCHAR* Usage;
+		void (*Run)(const TCHAR* Cmd, FOutputDevice& Ar);
+	};
+
+	const FBenchmark Benchmarks[] =
+	{
+		{ TEXT("OutgoingQueue"), TEXT("[NumMessages=1000000]"), &RunOutgoingQueueBenchmark },
+		{ TEXT("EntityStore"), TEXT("[EntityCount...=10000 100000 500000]"), &RunEntityStoreBenchmark },
+		{ TEXT("PropertyWrite"), TEXT("[ClassName=CharacterMovementComponent]"), &RunPropertyWriteBenchmark },
+		{ TEXT("PrimitiveArray"), TEXT(""), &RunPrimitiveArrayBenchmark },
+		{ TEXT("ObjectRef"), TEXT("[NumRefs=1000000]"), &RunObjectRefBenchmark },
+	};
+}
+
+namespace SpatialGDK
+{
+namespace SpatialBenchmarks
+{
+
+void Run(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	const FString Name = FParse::Token(Cmd, false);
+	const bool bRunAll = Name == TEXT("All");
+
+	bool bRanAny = false;
+	for (const FBenchmark& Benchmark : Benchmarks)
+	{
+		if (bRunAll || Name == Benchmark.Name)
+		{
+			// Arguments only make sense for a single benchmark, so All runs each one with its defaults.
+			Benchmark.Run(bRunAll ? TEXT("") : Cmd, Ar);
+			bRanAny = true;
+		}
+	}
+
+	if (!bRanAny)
+	{
+		Ar.Logf(TEXT("Usage: SpatialBenchmark <Name|All> [Args]. Available benchmarks:"));
+		for (const FBenchmark& Benchmark : Benchmarks)
+		{
+			Ar.Logf(TEXT("  %s %s"), Benchmark.Name, Benchmark.Usage);
+		}
+	}
+}
+
+} // namespace SpatialBenchmarks
+} // namespace SpatialGDK
+
+#endif // !UE_BUILD_SHIPPING
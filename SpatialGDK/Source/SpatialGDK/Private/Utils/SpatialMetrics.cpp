@@ -10,11 +10,34 @@
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
 #include "Interop/Connection/SpatialWorkerConnection.h"
+#include "Interop/SpatialReceiver.h"
+#include "Interop/SpatialSender.h"
 #include "SpatialGDKSettings.h"
 #include "Utils/SchemaUtils.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialMetrics);
 
+namespace
+{
+	SpatialGDK::HistogramMetric MakeHistogramMetric(const FString& Key, const SpatialGDK::FLatencyHistogramSnapshot& Snapshot)
+	{
+		SpatialGDK::HistogramMetric Metric;
+		Metric.Key = TCHAR_TO_UTF8(*Key);
+		Metric.Sum = Snapshot.Sum;
+
+		// Bucket sample counts are cumulative, so each bucket counts every sample up to its upper bound.
+		uint32 Samples = 0;
+		Metric.Buckets.Reserve(SpatialGDK::FLatencyHistogramSnapshot::NumBuckets);
+		for (int32 i = 0; i < SpatialGDK::FLatencyHistogramSnapshot::NumBuckets; i++)
+		{
+			Samples += Snapshot.Buckets[i];
+			Metric.Buckets.Add({ Snapshot.GetBucketUpperBound(i), Samples });
+		}
+
+		return Metric;
+	}
+}
+
 void USpatialMetrics::Init(USpatialNetDriver* InNetDriver)
 {
 	NetDriver = InNetDriver;
@@ -45,13 +68,86 @@ void USpatialMetrics::TickMetrics()
 	DynamicFPSGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_DYNAMIC_FPS);
 	DynamicFPSGauge.Value = AverageFPS;
 
+	SpatialGDK::GaugeMetric OutgoingQueueDepthGauge;
+	OutgoingQueueDepthGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_OUTGOING_QUEUE_DEPTH);
+	OutgoingQueueDepthGauge.Value = NetDriver->Connection->GetOutgoingMessageQueueDepth();
+
+	SpatialGDK::GaugeMetric OutgoingQueueHighWaterMarkGauge;
+	OutgoingQueueHighWaterMarkGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_OUTGOING_QUEUE_HIGH_WATER_MARK);
+	OutgoingQueueHighWaterMarkGauge.Value = NetDriver->Connection->GetOutgoingMessageQueueHighWaterMark();
+
+	const SpatialGDK::FLatencyHistogramSnapshot SendLatency = NetDriver->Connection->TakeSendLatencySnapshot();
+
+	SpatialGDK::GaugeMetric SendLatencyP50Gauge;
+	SendLatencyP50Gauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_SEND_LATENCY_P50);
+	SendLatencyP50Gauge.Value = SendLatency.GetPercentile(0.5);
+
+	SpatialGDK::GaugeMetric SendLatencyP99Gauge;
+	SendLatencyP99Gauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_SEND_LATENCY_P99);
+	SendLatencyP99Gauge.Value = SendLatency.GetPercentile(0.99);
+
+	SpatialGDK::GaugeMetric CoalescedComponentUpdatesGauge;
+	CoalescedComponentUpdatesGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_COALESCED_COMPONENT_UPDATES);
+	CoalescedComponentUpdatesGauge.Value = NetDriver->Connection->TakeNumCoalescedComponentUpdates();
+
+	SpatialGDK::GaugeMetric DeferredOutgoingMessagesGauge;
+	DeferredOutgoingMessagesGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_DEFERRED_OUTGOING_MESSAGES);
+	DeferredOutgoingMessagesGauge.Value = NetDriver->Connection->GetNumDeferredOutgoingMessages();
+
+	SpatialGDK::GaugeMetric QueuedIncomingRPCsGauge;
+	QueuedIncomingRPCsGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_QUEUED_INCOMING_RPCS);
+	QueuedIncomingRPCsGauge.Value = NetDriver->Receiver->GetNumQueuedIncomingRPCs();
+
+	SpatialGDK::GaugeMetric OldestQueuedIncomingRPCAgeGauge;
+	OldestQueuedIncomingRPCAgeGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_OLDEST_QUEUED_INCOMING_RPC_AGE);
+	OldestQueuedIncomingRPCAgeGauge.Value = NetDriver->Receiver->GetOldestQueuedIncomingRPCAgeSeconds();
+
+	SpatialGDK::GaugeMetric DroppedIncomingRPCsGauge;
+	DroppedIncomingRPCsGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_DROPPED_INCOMING_RPCS);
+	DroppedIncomingRPCsGauge.Value = NetDriver->Receiver->TakeNumDroppedIncomingRPCs();
+
+	SpatialGDK::GaugeMetric DroppedOutgoingRPCsGauge;
+	DroppedOutgoingRPCsGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_DROPPED_OUTGOING_RPCS);
+	DroppedOutgoingRPCsGauge.Value = NetDriver->Sender->TakeNumDroppedOutgoingRPCs();
+
+	uint32 MaxActorsSpawnedPerFrame = 0;
+	double LongestActorSpawnFrameSeconds = 0.0;
+	NetDriver->Receiver->TakeActorSpawnStats(MaxActorsSpawnedPerFrame, LongestActorSpawnFrameSeconds);
+
+	SpatialGDK::GaugeMetric MaxActorsSpawnedPerFrameGauge;
+	MaxActorsSpawnedPerFrameGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_MAX_ACTORS_SPAWNED_PER_FRAME);
+	MaxActorsSpawnedPerFrameGauge.Value = MaxActorsSpawnedPerFrame;
+
+	SpatialGDK::GaugeMetric LongestActorSpawnFrameGauge;
+	LongestActorSpawnFrameGauge.Key = TCHAR_TO_UTF8(*SpatialConstants::SPATIALOS_METRICS_LONGEST_ACTOR_SPAWN_FRAME);
+	LongestActorSpawnFrameGauge.Value = LongestActorSpawnFrameSeconds;
+
 	SpatialGDK::SpatialMetrics DynamicFPSMetrics;
 	DynamicFPSMetrics.GaugeMetrics.Add(DynamicFPSGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(OutgoingQueueDepthGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(OutgoingQueueHighWaterMarkGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(SendLatencyP50Gauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(SendLatencyP99Gauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(CoalescedComponentUpdatesGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(DeferredOutgoingMessagesGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(QueuedIncomingRPCsGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(OldestQueuedIncomingRPCAgeGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(DroppedIncomingRPCsGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(DroppedOutgoingRPCsGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(MaxActorsSpawnedPerFrameGauge);
+	DynamicFPSMetrics.GaugeMetrics.Add(LongestActorSpawnFrameGauge);
+	DynamicFPSMetrics.HistogramMetrics.Add(MakeHistogramMetric(SpatialConstants::SPATIALOS_METRICS_TICK_DISPATCH_TIME, TickDispatchTimeHistogram.TakeSnapshot()));
+	DynamicFPSMetrics.HistogramMetrics.Add(MakeHistogramMetric(SpatialConstants::SPATIALOS_METRICS_SERVER_REPLICATE_ACTORS_TIME, ServerReplicateActorsTimeHistogram.TakeSnapshot()));
+	DynamicFPSMetrics.HistogramMetrics.Add(MakeHistogramMetric(SpatialConstants::SPATIALOS_METRICS_FLUSH_PACKED_RPCS_TIME, FlushPackedRPCsTimeHistogram.TakeSnapshot()));
+	DynamicFPSMetrics.HistogramMetrics.Add(MakeHistogramMetric(SpatialConstants::SPATIALOS_METRICS_PROCESS_POSITION_UPDATES_TIME, ProcessPositionUpdatesTimeHistogram.TakeSnapshot()));
+	DynamicFPSMetrics.HistogramMetrics.Add(MakeHistogramMetric(SpatialConstants::SPATIALOS_METRICS_OP_LIST_SIZE, OpListSizeHistogram.TakeSnapshot()));
+	DynamicFPSMetrics.HistogramMetrics.Add(MakeHistogramMetric(SpatialConstants::SPATIALOS_METRICS_OP_BACKLOG_DRAIN_FRAMES, OpBacklogDrainFramesHistogram.TakeSnapshot()));
 	DynamicFPSMetrics.Load = WorkerLoad;
 
 	TimeOfLastReport = NetDriver->Time;
 	FramesSinceLastReport = 0;
 
+	NetDriver->Connection->ResetOutgoingMessageQueueHighWaterMark();
 	NetDriver->Connection->SendMetrics(DynamicFPSMetrics);
 }
 
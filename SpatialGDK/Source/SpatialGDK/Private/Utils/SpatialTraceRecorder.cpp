@@ -0,0 +1,330 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/SpatialTraceRecorder.h"
+
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadManager.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialTraceRecorder);
+
+namespace
+{
+	// How often the writer thread writes the buffered events to the file.
+	const uint32 WriteIntervalMs = 100;
+
+	// Stops a busy thread from using unbounded memory if the writer thread falls behind. Each event takes roughly 64 bytes.
+	const int32 MaxBufferedEventsPerThread = 256 * 1024;
+
+	void AppendJsonString(FString& Out, const TCHAR* String)
+	{
+		Out += TEXT('"');
+		for (const TCHAR* Char = String; *Char != TEXT('\0'); ++Char)
+		{
+			switch (*Char)
+			{
+			case TEXT('"'):
+				Out += TEXT("\\\"");
+				break;
+			case TEXT('\\'):
+				Out += TEXT("\\\\");
+				break;
+			case TEXT('\n'):
+				Out += TEXT("\\n");
+				break;
+			case TEXT('\r'):
+				Out += TEXT("\\r");
+				break;
+			case TEXT('\t'):
+				Out += TEXT("\\t");
+				break;
+			default:
+				if (*Char < 0x20)
+				{
+					Out += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(*Char));
+				}
+				else
+				{
+					Out += *Char;
+				}
+				break;
+			}
+		}
+		Out += TEXT('"');
+	}
+}
+
+namespace SpatialGDK
+{
+
+FSpatialTraceRecorder& FSpatialTraceRecorder::Get()
+{
+	static FSpatialTraceRecorder Recorder;
+	return Recorder;
+}
+
+FSpatialTraceRecorder::FSpatialTraceRecorder()
+	: bRecording(false)
+	, NumDroppedEvents(0)
+	, ThreadBufferTlsSlot(FPlatformTLS::AllocTlsSlot())
+	, RecordingStartCycles(0)
+	, RecordingEndTime(0.0)
+	, WriterThread(nullptr)
+	, WriterWakeEvent(FPlatformProcess::GetSynchEventFromPool())
+	, bWriterFinished(false)
+	, bFirstWrittenEvent(true)
+	, NumWrittenEvents(0)
+{
+}
+
+FSpatialTraceRecorder::~FSpatialTraceRecorder()
+{
+	Stop();
+
+	if (WriterThread != nullptr)
+	{
+		WriterThread->WaitForCompletion();
+		delete WriterThread;
+		WriterThread = nullptr;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WriterWakeEvent);
+	FPlatformTLS::FreeTlsSlot(ThreadBufferTlsSlot);
+}
+
+bool FSpatialTraceRecorder::Start(double DurationSeconds, const FString& InFilePath)
+{
+	if (IsRecording())
+	{
+		UE_LOG(LogSpatialTraceRecorder, Warning, TEXT("A trace is already being recorded."));
+		return false;
+	}
+
+	ReleaseFinishedWriterThread();
+	if (WriterThread != nullptr)
+	{
+		UE_LOG(LogSpatialTraceRecorder, Warning, TEXT("The previous trace is still being written to %s."), *FilePath);
+		return false;
+	}
+
+	File.Reset(IFileManager::Get().CreateFileWriter(*InFilePath));
+	if (!File.IsValid())
+	{
+		UE_LOG(LogSpatialTraceRecorder, Error, TEXT("Failed to open %s to write a trace."), *InFilePath);
+		return false;
+	}
+
+	{
+		FScopeLock Lock(&ThreadBuffersLock);
+		for (TUniquePtr<FThreadBuffer>& Buffer : ThreadBuffers)
+		{
+			FScopeLock BufferLock(&Buffer->Lock);
+			Buffer->Events.Reset();
+			Buffer->bThreadNameWritten = false;
+		}
+	}
+
+	NumDroppedEvents.store(0);
+	bFirstWrittenEvent = true;
+	NumWrittenEvents = 0;
+
+	FilePath = InFilePath;
+	RecordingStartCycles = FPlatformTime::Cycles64();
+	RecordingEndTime = FPlatformTime::Seconds() + DurationSeconds;
+	bRecording.store(true);
+
+	bWriterFinished.store(false);
+	WriterThread = FRunnableThread::Create(this, TEXT("SpatialTraceWriterThread"), 0);
+
+	UE_LOG(LogSpatialTraceRecorder, Log, TEXT("Recording a trace for %.1f seconds to %s"), DurationSeconds, *FilePath);
+	return true;
+}
+
+void FSpatialTraceRecorder::Tick()
+{
+	if (IsRecording() && FPlatformTime::Seconds() >= RecordingEndTime)
+	{
+		Stop();
+	}
+
+	ReleaseFinishedWriterThread();
+}
+
+void FSpatialTraceRecorder::AddEvent(const TCHAR* Name, const TCHAR* Category, uint64 StartCycles, uint64 EndCycles, FString&& Detail)
+{
+	FThreadBuffer& Buffer = GetThreadBuffer();
+
+	FScopeLock Lock(&Buffer.Lock);
+
+	// The recording may have stopped since the event started.
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	if (Buffer.Events.Num() >= MaxBufferedEventsPerThread)
+	{
+		NumDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Buffer.Events.Add(FTraceEvent{ Name, Category, FMath::Max(StartCycles, RecordingStartCycles), EndCycles, MoveTemp(Detail) });
+}
+
+bool FSpatialTraceRecorder::Stop()
+{
+	if (!IsRecording())
+	{
+		return false;
+	}
+
+	bRecording.store(false);
+	WriterWakeEvent->Trigger();
+	return true;
+}
+
+uint32 FSpatialTraceRecorder::Run()
+{
+	WriteJson(TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+
+	while (IsRecording())
+	{
+		WriterWakeEvent->Wait(WriteIntervalMs);
+		WriteBufferedEvents();
+	}
+
+	// Events that were added while the recording stopped.
+	WriteBufferedEvents();
+
+	WriteJson(TEXT("\n]}\n"));
+
+	const int32 RecordedNumDroppedEvents = NumDroppedEvents.load();
+	if (RecordedNumDroppedEvents > 0)
+	{
+		UE_LOG(LogSpatialTraceRecorder, Warning, TEXT("Dropped %d trace events over the limit of %d buffered events per thread."), RecordedNumDroppedEvents, MaxBufferedEventsPerThread);
+	}
+
+	if (!File->Close())
+	{
+		UE_LOG(LogSpatialTraceRecorder, Error, TEXT("Failed to write trace to %s"), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogSpatialTraceRecorder, Log, TEXT("Wrote %d trace events to %s"), NumWrittenEvents, *FilePath);
+	}
+	File.Reset();
+
+	bWriterFinished.store(true);
+	return 0;
+}
+
+FSpatialTraceRecorder::FThreadBuffer& FSpatialTraceRecorder::GetThreadBuffer()
+{
+	if (FThreadBuffer* Buffer = static_cast<FThreadBuffer*>(FPlatformTLS::GetTlsValue(ThreadBufferTlsSlot)))
+	{
+		return *Buffer;
+	}
+
+	FThreadBuffer* Buffer = new FThreadBuffer();
+	Buffer->ThreadId = FPlatformTLS::GetCurrentThreadId();
+	Buffer->ThreadName = IsInGameThread() ? FString(TEXT("GameThread")) : FThreadManager::GetThreadName(Buffer->ThreadId);
+	Buffer->bThreadNameWritten = false;
+	FPlatformTLS::SetTlsValue(ThreadBufferTlsSlot, Buffer);
+
+	FScopeLock Lock(&ThreadBuffersLock);
+	ThreadBuffers.Emplace(Buffer);
+	return *Buffer;
+}
+
+void FSpatialTraceRecorder::WriteBufferedEvents()
+{
+	TArray<FThreadBuffer*, TInlineAllocator<32>> Buffers;
+	{
+		FScopeLock Lock(&ThreadBuffersLock);
+		for (TUniquePtr<FThreadBuffer>& Buffer : ThreadBuffers)
+		{
+			Buffers.Add(Buffer.Get());
+		}
+	}
+
+	const uint32 ProcessId = FPlatformProcess::GetCurrentProcessId();
+
+	FString Json;
+	for (FThreadBuffer* Buffer : Buffers)
+	{
+		{
+			FScopeLock Lock(&Buffer->Lock);
+			Swap(Buffer->Events, Buffer->WritingEvents);
+		}
+
+		if (Buffer->WritingEvents.Num() == 0)
+		{
+			continue;
+		}
+
+		if (!Buffer->bThreadNameWritten)
+		{
+			Buffer->bThreadNameWritten = true;
+
+			Json += bFirstWrittenEvent ? TEXT("\n") : TEXT(",\n");
+			bFirstWrittenEvent = false;
+
+			Json += FString::Printf(TEXT("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":"), ProcessId, Buffer->ThreadId);
+			AppendJsonString(Json, Buffer->ThreadName.IsEmpty() ? *FString::Printf(TEXT("Thread %u"), Buffer->ThreadId) : *Buffer->ThreadName);
+			Json += TEXT("}}");
+		}
+
+		for (const FTraceEvent& Event : Buffer->WritingEvents)
+		{
+			Json += bFirstWrittenEvent ? TEXT("\n") : TEXT(",\n");
+			bFirstWrittenEvent = false;
+
+			const double StartMicroseconds = FPlatformTime::ToMilliseconds64(Event.StartCycles - RecordingStartCycles) * 1000.0;
+			const double DurationMicroseconds = FPlatformTime::ToMilliseconds64(Event.EndCycles - Event.StartCycles) * 1000.0;
+
+			Json += TEXT("{\"name\":");
+			AppendJsonString(Json, Event.Name);
+			Json += TEXT(",\"cat\":");
+			AppendJsonString(Json, Event.Category);
+			Json += FString::Printf(TEXT(",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f"), ProcessId, Buffer->ThreadId, StartMicroseconds, DurationMicroseconds);
+			if (!Event.Detail.IsEmpty())
+			{
+				Json += TEXT(",\"args\":{\"detail\":");
+				AppendJsonString(Json, *Event.Detail);
+				Json += TEXT('}');
+			}
+			Json += TEXT('}');
+		}
+
+		NumWrittenEvents += Buffer->WritingEvents.Num();
+		Buffer->WritingEvents.Reset();
+	}
+
+	WriteJson(Json);
+}
+
+void FSpatialTraceRecorder::WriteJson(const FString& Json)
+{
+	if (Json.IsEmpty())
+	{
+		return;
+	}
+
+	FTCHARToUTF8 JsonUTF8(*Json);
+	File->Serialize(const_cast<ANSICHAR*>(JsonUTF8.Get()), JsonUTF8.Length());
+}
+
+void FSpatialTraceRecorder::ReleaseFinishedWriterThread()
+{
+	if (WriterThread != nullptr && bWriterFinished.load())
+	{
+		WriterThread->WaitForCompletion();
+		delete WriterThread;
+		WriterThread = nullptr;
+	}
+}
+
+} // namespace SpatialGDK
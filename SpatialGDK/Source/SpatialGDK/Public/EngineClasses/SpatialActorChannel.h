@@ -183,6 +183,10 @@ public:
 	// If this actor channel is responsible for creating a new entity, this will be set to true during initial replication.
 	bool bCreatingNewEntity;
 
+	// Set on clients before cleaning up the channel of an actor that is going into the actor pool, so the actor is
+	// detached from the channel instead of being destroyed with it.
+	bool bKeepActorOnCleanUp;
+
 	TSet<TWeakObjectPtr<UObject>> PendingDynamicSubobjects;
 
 private:
@@ -36,6 +36,7 @@ class USpatialMetrics;
 class ASpatialMetricsDisplay;
 
 class UEntityPool;
+class USpatialActorPool;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialOSNetDriver, Log, All);
 
@@ -77,6 +78,7 @@ public:
 
 #if !UE_BUILD_SHIPPING
 	bool HandleNetDumpCrossServerRPCCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleSpatialTraceCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 #endif
 
 	// Returns the "100% reliable" connection to SpatialOS.
@@ -129,6 +131,8 @@ public:
 	UPROPERTY()
 	UEntityPool* EntityPool;
 	UPROPERTY()
+	USpatialActorPool* ActorPool;
+	UPROPERTY()
 	USpatialMetrics* SpatialMetrics;
 	UPROPERTY()
 	ASpatialMetricsDisplay* SpatialMetricsDisplay;
@@ -176,6 +180,12 @@ private:
 	TMap<Worker_EntityId_Key, USpatialActorChannel*> EntityToActorChannel;
 	TArray<Worker_OpList*> QueuedStartupOpLists;
 
+	// Op lists received but not yet fully processed because op processing went over the per frame budget.
+	// Processing resumes from NextPendingOpIndex in the first op list.
+	TArray<Worker_OpList*> PendingOpLists;
+	uint32 NextPendingOpIndex;
+	int32 NumOpBacklogFrames;
+
 	FTimerManager TimerManager;
 
 	bool bAuthoritativeDestruction;
@@ -197,6 +207,8 @@ private:
 
 	void HandleOngoingServerTravel();
 
+	void ProcessPendingOpLists();
+	void DestroyPendingOpLists();
 	void HandleStartupOpQueueing(const TArray<Worker_OpList*>& InOpLists);
 	bool FindAndDispatchStartupOps(const TArray<Worker_OpList*>& InOpLists);
 
@@ -92,6 +92,7 @@ public:
 
 private:
 	FNetworkGUID GetNetGUIDFromUnrealObjectRefInternal(const FUnrealObjectRef& ObjectRef);
+	void NetworkRemapObjectRefPathChain(FUnrealObjectRef& ObjectRef, bool bReading) const;
 
 	FNetworkGUID GetOrAssignNetGUID_SpatialGDK(UObject* Object);
 	void RegisterObjectRef(FNetworkGUID NetGUID, const FUnrealObjectRef& ObjectRef);
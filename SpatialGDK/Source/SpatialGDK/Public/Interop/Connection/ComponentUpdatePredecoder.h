@@ -0,0 +1,113 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+#include <WorkerSDK/improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+// The schema types that primitive Unreal properties are written as, see ComponentFactory.
+enum class EPredecodedFieldType : uint8
+{
+	None,
+	Bool,
+	Float,
+	Double,
+	Int32,
+	Int64,
+	Uint32,
+	Uint64
+};
+
+struct FFieldDecodeInfo
+{
+	EPredecodedFieldType Type = EPredecodedFieldType::None;
+	bool bIsList = false;
+};
+
+// Field types of a generated component, indexed by field ID. Fields with type None are not predecoded.
+using FComponentDecodePlan = TArray<FFieldDecodeInfo>;
+
+union FPredecodedValue
+{
+	int64 Int;
+	uint64 UInt;
+	double Double;
+};
+
+struct FPredecodedField
+{
+	Schema_FieldId FieldId;
+	EPredecodedFieldType Type;
+	uint32 FirstValue;
+	uint32 NumValues;
+};
+
+// A component update decoded on the ops processing thread.
+struct FPredecodedComponentUpdate
+{
+	// Updated fields followed by cleared fields, as ComponentReader would otherwise collect them on the game thread.
+	TArray<Schema_FieldId> FieldIds;
+
+	// Decoded values of the primitive fields in the decode plan, sorted by field ID.
+	TArray<FPredecodedField> Fields;
+	TArray<FPredecodedValue> Values;
+
+	const FPredecodedField* FindField(Schema_FieldId FieldId) const;
+};
+
+// The predecoded updates of an op list, looked up by op index.
+struct FPredecodedOpList
+{
+	// Index into Updates for each op, or INDEX_NONE.
+	TArray<int32> UpdateIndices;
+	TArray<FPredecodedComponentUpdate> Updates;
+
+	// Returns nullptr if the op wasn't predecoded, in which case it should be decoded as normal.
+	const FPredecodedComponentUpdate* Find(uint32 OpIndex) const
+	{
+		const int32 UpdateIndex = UpdateIndices[OpIndex];
+		return UpdateIndex != INDEX_NONE ? &Updates[UpdateIndex] : nullptr;
+	}
+};
+
+// Decodes updates to generated components on the ops processing thread, so that the game thread only has to write
+// property values. Components are predecoded once the game thread has registered a decode plan for them, which
+// happens the first time their data is applied.
+class SPATIALGDK_API FComponentUpdatePredecoder
+{
+public:
+	// Game thread only.
+	bool HasDecodePlan(Worker_ComponentId ComponentId) const { return ComponentsWithDecodePlans.Contains(ComponentId); }
+	void SetDecodePlan(Worker_ComponentId ComponentId, FComponentDecodePlan&& Plan);
+
+	// Called on the ops processing thread before the op list is handed to the game thread.
+	void PredecodeOpList(const Worker_OpList& OpList);
+
+	// Game thread only. Returns nullptr if none of the op list's ops were predecoded. The result can be used without
+	// locking until the op list is released, since all of its ops are predecoded before it is handed to the game thread.
+	FPredecodedOpList* FindOpList(const Worker_OpList* OpList) const;
+
+	// Game thread only. Called when the op's update has been changed since it was predecoded, so it is decoded as normal.
+	void Invalidate(const Worker_OpList* OpList, uint32 OpIndex);
+
+	// Must be called before the op list is destroyed.
+	void ReleaseOpList(const Worker_OpList* OpList);
+
+private:
+	static void PredecodeUpdate(const Worker_ComponentUpdate& Update, const FComponentDecodePlan& Plan, FPredecodedComponentUpdate& OutPredecoded);
+
+	FRWLock DecodePlansLock;
+	TMap<Worker_ComponentId, FComponentDecodePlan> DecodePlans;
+	TSet<Worker_ComponentId> ComponentsWithDecodePlans;
+
+	mutable FCriticalSection OpListsLock;
+	TMap<const Worker_OpList*, TUniquePtr<FPredecodedOpList>> OpLists;
+};
+
+} // namespace SpatialGDK
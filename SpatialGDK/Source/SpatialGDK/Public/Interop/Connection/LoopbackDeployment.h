@@ -0,0 +1,54 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Interop/Connection/OpListRecording.h"
+#include "Interop/Connection/OutgoingMessages.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+#include <WorkerSDK/improbable/c_worker.h>
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialLoopback, Log, All);
+
+namespace SpatialGDK
+{
+
+class FLoopbackDeployment;
+
+// A worker connected to an in-process stand-in for a SpatialOS deployment, shared by every loopback worker in the process.
+// The deployment keeps entities and components in memory, answers requests, routes commands to the authoritative
+// worker and sends component changes to every worker that can read the entity. Authority follows the EntityAcl
+// component, and every worker sees every entity it has read access to.
+// This is meant for running servers and clients in one process without the SpatialOS runtime, not for gameplay:
+// there is no interest, load balancing or persistence, and log messages and metrics are discarded.
+class SPATIALGDK_API FLoopbackWorkerConnection
+{
+public:
+	// Creates the deployment if no other loopback worker is connected, loading the snapshot given by
+	// -SpatialLoopbackSnapshot=<file> if there is one. The worker ID is made unique if it is empty or already in use.
+	static TUniquePtr<FLoopbackWorkerConnection> Connect(const FString& WorkerType, const FString& WorkerId);
+
+	~FLoopbackWorkerConnection();
+
+	const FString& GetWorkerId() const { return WorkerId; }
+	const TArray<FString>& GetWorkerAttributes() const { return WorkerAttributes; }
+
+	// Takes ownership of the schema objects in the message, as the Worker SDK does.
+	void SendMessage(FOutgoingMessage& Message);
+	void SendComponentUpdate(Worker_EntityId EntityId, const Worker_ComponentUpdate& Update);
+
+	// Returns the ops received since the last call, or nullptr if there are none.
+	TUniquePtr<FOwnedOpList> GetOpList();
+
+private:
+	FLoopbackWorkerConnection(const TSharedRef<FLoopbackDeployment, ESPMode::ThreadSafe>& InDeployment, uint32 InWorkerHandle, const FString& InWorkerId, const TArray<FString>& InWorkerAttributes);
+
+	TSharedRef<FLoopbackDeployment, ESPMode::ThreadSafe> Deployment;
+	uint32 WorkerHandle;
+	FString WorkerId;
+	TArray<FString> WorkerAttributes;
+};
+
+} // namespace SpatialGDK
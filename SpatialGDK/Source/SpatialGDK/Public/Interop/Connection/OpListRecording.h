@@ -0,0 +1,89 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+#include <WorkerSDK/improbable/c_worker.h>
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialOpListRecording, Log, All);
+
+namespace SpatialGDK
+{
+
+// An op list that owns all of its memory, rather than one created by the Worker SDK.
+// Must be destroyed with delete instead of Worker_OpList_Destroy.
+struct SPATIALGDK_API FOwnedOpList : public Worker_OpList
+{
+	FOwnedOpList();
+	~FOwnedOpList();
+
+	FOwnedOpList(const FOwnedOpList&) = delete;
+	FOwnedOpList& operator=(const FOwnedOpList&) = delete;
+
+	// Storage for everything the ops point to. Only the outer arrays grow while the op list is built,
+	// so pointers into the inner arrays stay valid.
+	TArray<Worker_Op> Ops;
+	TArray<TArray<ANSICHAR>> Strings;
+	TArray<TArray<const char*>> StringLists;
+	TArray<TArray<Worker_ComponentData>> ComponentDataLists;
+	TArray<TArray<Worker_Entity>> EntityLists;
+};
+
+// Serializes an op list, including schema payloads, to a compact binary format.
+SPATIALGDK_API void SerializeOpList(const Worker_OpList& OpList, TArray<uint8>& OutData);
+
+// Returns nullptr if the data is not a valid serialized op list.
+SPATIALGDK_API TUniquePtr<FOwnedOpList> DeserializeOpList(const uint8* Data, int32 Size);
+
+// Writes every op list received by a worker connection to a file, along with the time it was received.
+class SPATIALGDK_API FOpListRecorder
+{
+public:
+	~FOpListRecorder();
+
+	static TUniquePtr<FOpListRecorder> Create(const FString& FilePath, const FString& WorkerId, const TArray<FString>& WorkerAttributes);
+
+	void Record(const Worker_OpList& OpList);
+
+private:
+	FOpListRecorder(FArchive* InFileWriter);
+
+	FArchive* FileWriter;
+	double StartTime;
+	int32 NumRecordedOpLists;
+	TArray<uint8> Buffer;
+};
+
+// Plays back op lists written by FOpListRecorder, either at the speed they were recorded or as fast as they are consumed.
+class SPATIALGDK_API FOpListPlayer
+{
+public:
+	static TUniquePtr<FOpListPlayer> Create(const FString& FilePath, bool bInMaxSpeed);
+
+	// Returns the next op list if it is due, or nullptr otherwise.
+	TUniquePtr<FOwnedOpList> GetNextOpList();
+
+	bool IsFinished() const { return Offset >= Data.Num(); }
+	bool IsMaxSpeed() const { return bMaxSpeed; }
+
+	const FString& GetWorkerId() const { return WorkerId; }
+	const TArray<FString>& GetWorkerAttributes() const { return WorkerAttributes; }
+
+private:
+	FOpListPlayer(bool bInMaxSpeed);
+
+	TArray<uint8> Data;
+	int32 Offset;
+	bool bMaxSpeed;
+	double StartTime;
+
+	FString WorkerId;
+	TArray<FString> WorkerAttributes;
+
+	int32 NumPlayedOpLists;
+	int64 NumPlayedOps;
+};
+
+} // namespace SpatialGDK
@@ -0,0 +1,122 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Templates/UnrealTemplate.h"
+
+#include "Interop/Connection/OutgoingMessages.h"
+
+#include <atomic>
+
+namespace SpatialGDK
+{
+
+// Computes the size and alignment of the largest of the given types.
+template <typename... Types>
+struct TLargestOutgoingMessage;
+
+template <typename T>
+struct TLargestOutgoingMessage<T>
+{
+	static constexpr SIZE_T Size = sizeof(T);
+	static constexpr SIZE_T Alignment = alignof(T);
+};
+
+template <typename T, typename... Rest>
+struct TLargestOutgoingMessage<T, Rest...>
+{
+	static constexpr SIZE_T Size = sizeof(T) > TLargestOutgoingMessage<Rest...>::Size ? sizeof(T) : TLargestOutgoingMessage<Rest...>::Size;
+	static constexpr SIZE_T Alignment = alignof(T) > TLargestOutgoingMessage<Rest...>::Alignment ? alignof(T) : TLargestOutgoingMessage<Rest...>::Alignment;
+};
+
+using FLargestOutgoingMessage = TLargestOutgoingMessage<
+	FReserveEntityIdsRequest,
+	FCreateEntityRequest,
+	FDeleteEntityRequest,
+	FAddComponent,
+	FRemoveComponent,
+	FComponentUpdate,
+	FCommandRequest,
+	FCommandResponse,
+	FCommandFailure,
+	FLogMessage,
+	FComponentInterest,
+	FEntityQueryRequest,
+	FMetrics>;
+
+// Single-producer single-consumer queue for outgoing messages.
+//
+// Messages are constructed in place in fixed-size slots, large enough for any EOutgoingMessageType, which live in
+// a ring of blocks. Once the ring has grown to the working size of the queue, enqueueing and dequeueing do not allocate.
+// If the producer catches up with the consumer, a new block is linked into the ring rather than overwriting or blocking.
+//
+// The game thread is the only producer and the ops processing thread is the only consumer.
+class SPATIALGDK_API FOutgoingMessageQueue
+{
+public:
+	FOutgoingMessageQueue();
+	~FOutgoingMessageQueue();
+
+	FOutgoingMessageQueue(const FOutgoingMessageQueue&) = delete;
+	FOutgoingMessageQueue& operator=(const FOutgoingMessageQueue&) = delete;
+
+	// Producer interface.
+	template <typename T, typename... ArgsType>
+	void Enqueue(ArgsType&&... Args)
+	{
+		static_assert(sizeof(T) <= SlotSize && alignof(T) <= SlotAlignment, "Outgoing message type is missing from FLargestOutgoingMessage.");
+
+		new (AllocateSlot()) T(Forward<ArgsType>(Args)...);
+		PublishSlot();
+	}
+
+	// Consumer interface. Peek returns the oldest message, or nullptr if the queue is empty.
+	// Pop destroys the message returned by the last Peek and releases its slot.
+	FOutgoingMessage* Peek();
+	void Pop();
+
+	// Stats. These can be read from any thread but are only approximate while the other thread is running.
+	int32 Num() const { return NumQueued.load(std::memory_order_relaxed); }
+	int32 GetCapacity() const { return NumBlocks.load(std::memory_order_relaxed) * (BlockSize - 1); }
+
+private:
+	static constexpr SIZE_T SlotSize = FLargestOutgoingMessage::Size;
+	static constexpr SIZE_T SlotAlignment = FLargestOutgoingMessage::Alignment;
+
+	// Must be a power of two. One slot per block is always left empty to tell a full block from an empty one.
+	static constexpr uint32 BlockSize = 256;
+	static constexpr uint32 BlockMask = BlockSize - 1;
+
+	struct FBlock
+	{
+		FBlock() : Front(0), Tail(0), Next(nullptr) {}
+
+		void* GetSlot(uint32 Index) { return &Slots[Index]; }
+
+		// Owned by the consumer. Padded so the producer and consumer indices don't share a cache line.
+		std::atomic<uint32> Front;
+		uint8 FrontPadding[PLATFORM_CACHE_LINE_SIZE - sizeof(std::atomic<uint32>)];
+		// Owned by the producer.
+		std::atomic<uint32> Tail;
+		std::atomic<FBlock*> Next;
+
+		TAlignedBytes<SlotSize, SlotAlignment> Slots[BlockSize];
+	};
+
+	void* AllocateSlot();
+	void PublishSlot();
+
+	std::atomic<FBlock*> FrontBlock;
+	uint8 FrontBlockPadding[PLATFORM_CACHE_LINE_SIZE - sizeof(std::atomic<FBlock*>)];
+	std::atomic<FBlock*> TailBlock;
+
+	// Producer-only state for the slot between AllocateSlot and PublishSlot.
+	FBlock* PendingBlock;
+	uint32 PendingIndex;
+
+	std::atomic<int32> NumQueued;
+	std::atomic<int32> NumBlocks;
+};
+
+} // namespace SpatialGDK
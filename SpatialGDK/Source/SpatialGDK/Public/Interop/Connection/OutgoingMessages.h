@@ -4,6 +4,7 @@
 #include "Containers/Array.h"
 #include "Containers/UnrealString.h"
 #include "HAL/Platform.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/Optional.h"
 #include "Templates/UnrealTemplate.h"
 #include "Templates/UniquePtr.h"
@@ -33,43 +34,78 @@ enum class EOutgoingMessageType : int32
 	Metrics
 };
 
+constexpr int32 NumOutgoingMessageTypes = static_cast<int32>(EOutgoingMessageType::Metrics) + 1;
+
+// Messages in a higher priority class are sent first. Messages that change entity or component state all share
+// the Critical class, so the order they were queued in is preserved.
+enum class EOutgoingMessagePriority : int32
+{
+	Critical,
+	Normal,
+	Low
+};
+
+constexpr int32 NumOutgoingMessagePriorities = static_cast<int32>(EOutgoingMessagePriority::Low) + 1;
+
+SPATIALGDK_API FName GetOutgoingMessageTypeName(EOutgoingMessageType Type);
+
+// The priority class messages of the given type are queued in, the same as TOutgoingMessagePriority.
+SPATIALGDK_API EOutgoingMessagePriority GetOutgoingMessagePriority(EOutgoingMessageType Type);
+
+struct FOutgoingMessage;
+
+// Approximate number of bytes the message takes up on the wire.
+SPATIALGDK_API uint32 GetOutgoingMessageSize(const FOutgoingMessage& Message);
+
+// Frees the schema objects owned by a message that will not be sent.
+SPATIALGDK_API void DestroyOutgoingMessageSchemaObjects(FOutgoingMessage& Message);
+
 struct FOutgoingMessage
 {
-	FOutgoingMessage(const EOutgoingMessageType& InType) : Type(InType) {}
+	FOutgoingMessage(const EOutgoingMessageType& InType) : Type(InType), EnqueueCycles(FPlatformTime::Cycles64()) {}
 	virtual ~FOutgoingMessage() {}
 
 	EOutgoingMessageType Type;
+
+	// Used to measure the time between queueing the message on the game thread and sending it on the ops thread.
+	uint64 EnqueueCycles;
 };
 
 struct FReserveEntityIdsRequest : FOutgoingMessage
 {
-	FReserveEntityIdsRequest(uint32_t InNumOfEntities)
+	FReserveEntityIdsRequest(Worker_RequestId InRequestId, uint32_t InNumOfEntities)
 		: FOutgoingMessage(EOutgoingMessageType::ReserveEntityIdsRequest)
+		, RequestId(InRequestId)
 		, NumOfEntities(InNumOfEntities)
 	{}
 
+	Worker_RequestId RequestId;
 	uint32_t NumOfEntities;
 };
 
 struct FCreateEntityRequest : FOutgoingMessage
 {
-	FCreateEntityRequest(TArray<Worker_ComponentData>&& InComponents, const Worker_EntityId* InEntityId)
+	FCreateEntityRequest(Worker_RequestId InRequestId, TArray<Worker_ComponentData>&& InComponents, const Worker_EntityId* InEntityId)
 		: FOutgoingMessage(EOutgoingMessageType::CreateEntityRequest)
+		, RequestId(InRequestId)
 		, Components(MoveTemp(InComponents))
 		, EntityId(InEntityId != nullptr ? *InEntityId : TOptional<Worker_EntityId>())
 	{}
 
+	Worker_RequestId RequestId;
 	TArray<Worker_ComponentData> Components;
 	TOptional<Worker_EntityId> EntityId;
 };
 
 struct FDeleteEntityRequest : FOutgoingMessage
 {
-	FDeleteEntityRequest(Worker_EntityId InEntityId)
+	FDeleteEntityRequest(Worker_RequestId InRequestId, Worker_EntityId InEntityId)
 		: FOutgoingMessage(EOutgoingMessageType::DeleteEntityRequest)
+		, RequestId(InRequestId)
 		, EntityId(InEntityId)
 	{}
 
+	Worker_RequestId RequestId;
 	Worker_EntityId EntityId;
 };
 
@@ -111,13 +147,15 @@ struct FComponentUpdate : FOutgoingMessage
 
 struct FCommandRequest : FOutgoingMessage
 {
-	FCommandRequest(Worker_EntityId InEntityId, const Worker_CommandRequest& InRequest, uint32_t InCommandId)
+	FCommandRequest(Worker_RequestId InRequestId, Worker_EntityId InEntityId, const Worker_CommandRequest& InRequest, uint32_t InCommandId)
 		: FOutgoingMessage(EOutgoingMessageType::CommandRequest)
+		, RequestId(InRequestId)
 		, EntityId(InEntityId)
 		, Request(InRequest)
 		, CommandId(InCommandId)
 	{}
 
+	Worker_RequestId RequestId;
 	Worker_EntityId EntityId;
 	Worker_CommandRequest Request;
 	uint32_t CommandId;
@@ -156,6 +194,13 @@ struct FLogMessage : FOutgoingMessage
 		, Message(InMessage)
 	{}
 
+	FLogMessage(uint8_t InLevel, const FName& InLoggerName, FString&& InMessage)
+		: FOutgoingMessage(EOutgoingMessageType::LogMessage)
+		, Level(InLevel)
+		, LoggerName(InLoggerName)
+		, Message(MoveTemp(InMessage))
+	{}
+
 	uint8_t Level;
 	FName LoggerName;
 	FString Message;
@@ -175,14 +220,16 @@ struct FComponentInterest : FOutgoingMessage
 
 struct FEntityQueryRequest : FOutgoingMessage
 {
-	FEntityQueryRequest(const Worker_EntityQuery& InEntityQuery)
+	FEntityQueryRequest(Worker_RequestId InRequestId, const Worker_EntityQuery& InEntityQuery)
 		: FOutgoingMessage(EOutgoingMessageType::EntityQueryRequest)
+		, RequestId(InRequestId)
 		, EntityQuery(InEntityQuery)
 	{
 		if (EntityQuery.snapshot_result_type_component_ids != nullptr)
 		{
 			ComponentIdStorage.SetNum(EntityQuery.snapshot_result_type_component_id_count);
-			FMemory::Memcpy(static_cast<void*>(ComponentIdStorage.GetData()), static_cast<const void*>(EntityQuery.snapshot_result_type_component_ids), ComponentIdStorage.Num());
+			FMemory::Memcpy(static_cast<void*>(ComponentIdStorage.GetData()), static_cast<const void*>(EntityQuery.snapshot_result_type_component_ids), ComponentIdStorage.Num() * sizeof(Worker_ComponentId));
+			EntityQuery.snapshot_result_type_component_ids = ComponentIdStorage.GetData();
 		}
 
 		TraverseConstraint(&EntityQuery.constraint);
@@ -190,6 +237,7 @@ struct FEntityQueryRequest : FOutgoingMessage
 
 	void TraverseConstraint(Worker_Constraint* Constraint);
 
+	Worker_RequestId RequestId;
 	Worker_EntityQuery EntityQuery;
 	TArray<TUniquePtr<Worker_Constraint[]>> ConstraintStorage;
 	TArray<Worker_ComponentId> ComponentIdStorage;
@@ -245,4 +293,37 @@ struct FMetrics : FOutgoingMessage
 	SpatialMetrics Metrics;
 };
 
+// Keep in sync with GetOutgoingMessagePriority.
+template <typename T>
+struct TOutgoingMessagePriority
+{
+	static constexpr EOutgoingMessagePriority Value = EOutgoingMessagePriority::Critical;
+};
+
+// Responses to these are matched by request ID, so they can be sent out of order. The Worker SDK assigns request IDs
+// in the order requests are sent, so the connection maps them back to the IDs returned when the requests were queued.
+template <>
+struct TOutgoingMessagePriority<FReserveEntityIdsRequest>
+{
+	static constexpr EOutgoingMessagePriority Value = EOutgoingMessagePriority::Normal;
+};
+
+template <>
+struct TOutgoingMessagePriority<FEntityQueryRequest>
+{
+	static constexpr EOutgoingMessagePriority Value = EOutgoingMessagePriority::Normal;
+};
+
+template <>
+struct TOutgoingMessagePriority<FLogMessage>
+{
+	static constexpr EOutgoingMessagePriority Value = EOutgoingMessagePriority::Low;
+};
+
+template <>
+struct TOutgoingMessagePriority<FMetrics>
+{
+	static constexpr EOutgoingMessagePriority Value = EOutgoingMessagePriority::Low;
+};
+
 }
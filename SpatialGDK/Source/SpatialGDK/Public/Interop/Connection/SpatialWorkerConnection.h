@@ -5,10 +5,16 @@
 #include "HAL/Runnable.h"
 #include "HAL/ThreadSafeBool.h"
 
+#include "Interop/Connection/ComponentUpdatePredecoder.h"
 #include "Interop/Connection/ConnectionConfig.h"
+#include "Interop/Connection/LoopbackDeployment.h"
+#include "Interop/Connection/OpListRecording.h"
+#include "Interop/Connection/OutgoingMessageQueue.h"
 #include "Interop/Connection/OutgoingMessages.h"
+#include "SpatialCommonTypes.h"
 #include "SpatialGDKSettings.h"
 #include "UObject/WeakObjectPtr.h"
+#include "Utils/LatencyHistogram.h"
 
 #include <WorkerSDK/improbable/c_schema.h>
 #include <WorkerSDK/improbable/c_worker.h>
@@ -17,6 +23,7 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialWorkerConnection, Log, All);
 
+class FEvent;
 class USpatialGameInstance;
 class UWorld;
 
@@ -44,6 +51,8 @@ public:
 
 	// Worker Connection Interface
 	TArray<Worker_OpList*> GetOpList();
+	// Op lists returned by GetOpList must be destroyed with this rather than Worker_OpList_Destroy, since they may not come from the Worker SDK.
+	void DestroyOpList(Worker_OpList* OpList);
 	Worker_RequestId SendReserveEntityIdsRequest(uint32_t NumOfEntities);
 	Worker_RequestId SendCreateEntityRequest(TArray<Worker_ComponentData>&& Components, const Worker_EntityId* EntityId);
 	Worker_RequestId SendDeleteEntityRequest(Worker_EntityId EntityId);
@@ -54,6 +63,7 @@ public:
 	void SendCommandResponse(Worker_RequestId RequestId, const Worker_CommandResponse* Response);
 	void SendCommandFailure(Worker_RequestId RequestId, const FString& Message);
 	void SendLogMessage(uint8_t Level, const FName& LoggerName, const TCHAR* Message);
+	void SendLogMessage(uint8_t Level, const FName& LoggerName, FString&& Message);
 	void SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride>&& ComponentInterest);
 	Worker_RequestId SendEntityQueryRequest(const Worker_EntityQuery* EntityQuery);
 	void SendMetrics(const SpatialGDK::SpatialMetrics& Metrics);
@@ -61,12 +71,36 @@ public:
 	FString GetWorkerId() const;
 	const TArray<FString>& GetWorkerAttributes() const;
 
+	// Outgoing message queue stats. The high-water mark is the deepest the queues have been since the last reset,
+	// summed over all priority classes.
+	int32 GetOutgoingMessageQueueDepth() const;
+	int32 GetOutgoingMessageQueueHighWaterMark() const;
+	void ResetOutgoingMessageQueueHighWaterMark();
+
+	// Returns the number of messages held back by OutgoingMessageBudgets in the last network update.
+	// Producers can use this to throttle themselves rather than letting the queues grow.
+	int32 GetNumDeferredOutgoingMessages() const { return NumDeferredOutgoingMessages.load(std::memory_order_relaxed); }
+
+	// Returns the time, in milliseconds, between queueing and sending outgoing messages since the last call.
+	SpatialGDK::FLatencyHistogramSnapshot TakeSendLatencySnapshot() { return SendLatencyHistogram.TakeSnapshot(); }
+
+	// Returns the number of component updates merged into an earlier update for the same entity and component since the last call.
+	int32 TakeNumCoalescedComponentUpdates() { return NumCoalescedComponentUpdates.exchange(0, std::memory_order_relaxed); }
+
+	// Called at the end of each game tick so that event-driven network updates send everything queued during the tick.
+	void WakeOpsProcessingThread();
+
+	// Returns nullptr unless bPredecodeComponentUpdates is set.
+	SpatialGDK::FComponentUpdatePredecoder* GetComponentUpdatePredecoder() { return bPredecodeComponentUpdates ? &ComponentUpdatePredecoder : nullptr; }
+
 	FReceptionistConfig ReceptionistConfig;
 	FLocatorConfig LocatorConfig;
 
 private:
 	void ConnectToReceptionist(bool bConnectAsClient);
 	void ConnectToLocator();
+	void ConnectToOpListPlayback(const FString& FilePath);
+	void ConnectToLoopback(bool bConnectAsClient);
 	void FinishConnecting(Worker_ConnectionFuture* ConnectionFuture);
 
 	void OnConnectionSuccess();
@@ -86,9 +120,22 @@ private:
 	// End FRunnable Interface
 
 	void InitializeOpsProcessingThread();
-	void QueueLatestOpList();
+	void QueueLatestOpList(uint32 TimeoutMillis);
+	void QueuePlaybackOpLists();
+	void EnqueueOpList(Worker_OpList* OpList);
+	void TrackSentRequestId(Worker_RequestId RequestId, Worker_RequestId SentRequestId);
+	void RemapResponseRequestIds(Worker_OpList& OpList);
 	void ProcessOutgoingMessages();
 
+	// Returns the next message to send, starting from the given priority class and skipping classes that are empty or over budget.
+	SpatialGDK::FOutgoingMessage* PeekOutgoingMessage(int32& Priority, int32& NumDeferred);
+	bool ConsumeOutgoingMessageBudget(const SpatialGDK::FOutgoingMessage& Message);
+	void ResetOutgoingMessageBudgets();
+
+	// Returns false if the update couldn't be merged and should be sent on its own.
+	bool CoalesceComponentUpdate(SpatialGDK::FComponentUpdate& Message);
+	void SendPendingComponentUpdate();
+
 	void StartDevelopmentAuth(FString DevAuthToken);
 	static void OnPlayerIdentityToken(void* UserData, const Worker_Alpha_PlayerIdentityTokenResponse* PIToken);
 	static void OnLoginTokens(void* UserData, const Worker_Alpha_LoginTokensResponse* LoginTokens);
@@ -110,9 +157,55 @@ private:
 	FThreadSafeBool KeepRunning = true;
 	float OpsUpdateInterval;
 
+	// Event-driven network updates. These are set on the game thread before the ops processing thread starts.
+	FEvent* OpsProcessingThreadWakeEvent = nullptr;
+	bool bEventDrivenOpsUpdate = false;
+	uint32 EventDrivenMaxIdleTimeMs = 0;
+	uint32 EventDrivenOpListTimeoutMs = 0;
+
+	// Bucket bounds start at 10 microseconds.
+	SpatialGDK::FLatencyHistogram SendLatencyHistogram{ 0.01 };
+
+	// Consecutive component updates for the same entity and component are merged on the ops processing thread before sending.
+	bool bCoalesceComponentUpdates = false;
+	// The last component update taken from the queue, held back in case the next message updates the same component.
+	TOptional<TPair<Worker_EntityId, Worker_ComponentUpdate>> PendingComponentUpdate;
+	std::atomic<int32> NumCoalescedComponentUpdates{ 0 };
+
+	// Logger names rarely change, so the UTF-8 conversion of the last one is kept on the ops processing thread.
+	FName CachedLoggerName;
+	TArray<ANSICHAR> CachedLoggerNameUTF8;
+
 	TQueue<Worker_OpList*> OpListQueue;
-	TQueue<TUniquePtr<SpatialGDK::FOutgoingMessage>> OutgoingMessagesQueue;
+
+	// Updates to generated components are decoded on the ops processing thread before being queued.
+	bool bPredecodeComponentUpdates = false;
+	SpatialGDK::FComponentUpdatePredecoder ComponentUpdatePredecoder;
+
+	// Op lists received are written to a file when started with -SpatialRecordOps=<file>. When started with
+	// -SpatialPlaybackOps=<file>, op lists are read from that file instead of connecting to SpatialOS, and nothing is sent.
+	TUniquePtr<SpatialGDK::FOpListRecorder> OpListRecorder;
+	TUniquePtr<SpatialGDK::FOpListPlayer> OpListPlayer;
+
+	// Set instead of WorkerConnection when started with -SpatialLoopback, to connect to an in-process stand-in for SpatialOS.
+	TUniquePtr<SpatialGDK::FLoopbackWorkerConnection> LoopbackConnection;
+	SpatialGDK::FOutgoingMessageQueue OutgoingMessagesQueues[SpatialGDK::NumOutgoingMessagePriorities];
+
+	// Peak of the combined depth of all the outgoing queues, sampled on the game thread whenever a message is queued.
+	// The peaks of the separate queues happen at different times, so adding them up would overstate it.
+	std::atomic<int32> OutgoingMessageQueueHighWaterMark{ 0 };
+
+	// Per message type budgets, only used by the ops processing thread.
+	bool bUseOutgoingMessageBudgets = false;
+	FOutgoingMessageBudget OutgoingMessageBudgets[SpatialGDK::NumOutgoingMessageTypes];
+	int32 MessagesSentThisUpdate[SpatialGDK::NumOutgoingMessageTypes];
+	int32 BytesSentThisUpdate[SpatialGDK::NumOutgoingMessageTypes];
+	std::atomic<int32> NumDeferredOutgoingMessages{ 0 };
 
 	// RequestIds per worker connection start at 0 and incrementally go up each command sent.
 	Worker_RequestId NextRequestId = 0;
+
+	// Maps request IDs assigned by the Worker SDK to the ones returned when the request was queued, where they differ.
+	// Only used by the ops processing thread.
+	TMap<Worker_RequestId, Worker_RequestId> SentRequestIdRemapping;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Utils/SchemaDatabase.h"
+#include "Utils/SchemaPropertyPlan.h"
 
 #include <WorkerSDK/improbable/c_worker.h>
 
@@ -41,6 +42,7 @@ struct FHandoverPropertyInfo
 	int32 Offset;
 	int32 ArrayIdx;
 	UProperty* Property;
+	SpatialGDK::FSchemaPropertyInfo SchemaInfo;
 };
 
 struct FInterestPropertyInfo
@@ -57,10 +59,17 @@ struct FClassInfo
 	TWeakObjectPtr<UClass> Class;
 
 	// Exists for all classes
+	// RPCs and RPCInfos are both indexed by FRPCInfo::Index, which is what RPC payloads refer to.
 	TArray<UFunction*> RPCs;
+	TArray<FRPCInfo> RPCInfos;
+	// Also contains the super functions of each RPC, since blueprints can explicitly call the parent function.
 	TMap<UFunction*, FRPCInfo> RPCInfoMap;
 	TArray<FHandoverPropertyInfo> HandoverProperties;
 	TArray<FInterestPropertyInfo> InterestProperties;
+	// How each command of the class's rep layout is written by ComponentFactory.
+	SpatialGDK::FRepLayoutWritePlan RepWritePlan;
+	// How each replicated field is applied by ComponentReader.
+	SpatialGDK::FRepLayoutReadPlan RepReadPlan;
 
 	// For Actors and default Subobjects belonging to Actors
 	Worker_ComponentId SchemaComponents[ESchemaComponentType::SCHEMA_Count] = {};
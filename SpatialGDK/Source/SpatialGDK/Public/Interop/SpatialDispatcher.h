@@ -31,6 +31,9 @@ public:
 
 	void Init(USpatialNetDriver* NetDriver);
 	void ProcessOps(Worker_OpList* OpList);
+	// Processes ops from StartIndex until the end of the op list or until the deadline has passed, and returns the index of the first op not processed.
+	// Processing only stops outside of critical sections, so a critical section is never split between calls.
+	uint32 ProcessOps(Worker_OpList* OpList, uint32 StartIndex, uint64 DeadlineCycles);
 	// The following 2 methods should *only* be used by the Startup OpList Queueing flow
 	// from the SpatialNetDriver, and should be temporary since an alternative solution will be available via the Worker SDK soon.
 	void MarkOpToSkip(const Worker_Op* Op);
@@ -45,27 +48,68 @@ public:
 	FCallbackId OnComponentUpdate(Worker_ComponentId ComponentId, const TFunction<void(const Worker_ComponentUpdateOp&)>& Callback);
 	FCallbackId OnCommandRequest(Worker_ComponentId ComponentId, const TFunction<void(const Worker_CommandRequestOp&)>& Callback);
 	FCallbackId OnCommandResponse(Worker_ComponentId ComponentId, const TFunction<void(const Worker_CommandResponseOp&)>& Callback);
+	// Called once per call to ProcessOps with every op for the component processed in that call, in the order they were received,
+	// instead of once per op. The ops are only valid for the duration of the callback.
+	FCallbackId OnComponentOps(Worker_ComponentId ComponentId, const TFunction<void(const TArray<const Worker_Op*>&)>& Callback);
 	bool RemoveOpCallback(FCallbackId Id);
 
 private:
+	// Callbacks removed while callbacks are running are only marked as removed, as one of them may be the one running.
 	struct UserOpCallbackData
 	{
 		FCallbackId Id;
 		TFunction<void(const Worker_Op*)> Callback;
+		bool bRemoved = false;
 	};
 
+	struct UserBatchCallbackData
+	{
+		FCallbackId Id;
+		TFunction<void(const TArray<const Worker_Op*>&)> Callback;
+		bool bRemoved = false;
+	};
+
+	// The component op types that callbacks can be registered for, used to index FExternalComponentCallbacks::OpCallbacks.
+	static constexpr int32 NumCallbackOpTypes = 6;
+	static constexpr int32 BatchCallbackOpTypeIndex = NumCallbackOpTypes;
+
 	struct CallbackIdData
 	{
 		Worker_ComponentId ComponentId;
-		Worker_OpType OpType;
+		// Index into FExternalComponentCallbacks::OpCallbacks, or BatchCallbackOpTypeIndex for batch callbacks.
+		int32 OpTypeIndex;
 	};
 
-	using OpTypeToCallbacksMap = TMap<Worker_OpType, TArray<UserOpCallbackData>>;
+	struct FExternalComponentCallbacks
+	{
+		TArray<UserOpCallbackData> OpCallbacks[NumCallbackOpTypes];
+		TArray<UserBatchCallbackData> BatchCallbacks;
+		// Ops waiting to be passed to the batch callbacks at the end of ProcessOps.
+		TArray<const Worker_Op*> BatchedOps;
+	};
+
+	// A callback registered while callbacks are running, added once they have finished. Only the callback for OpTypeIndex is set.
+	struct FPendingCallback
+	{
+		Worker_ComponentId ComponentId;
+		int32 OpTypeIndex;
+		UserOpCallbackData OpCallback;
+		UserBatchCallbackData BatchCallback;
+	};
+
+	static int32 GetCallbackOpTypeIndex(uint8 OpType);
 
 	bool IsExternalSchemaOp(Worker_Op* Op) const;
+	// Merges each update into the next update to the same component of the entity where that keeps the order of the ops for the entity.
+	void FoldComponentUpdates(Worker_OpList* OpList);
 	void ProcessExternalSchemaOp(Worker_Op* Op);
+	FExternalComponentCallbacks& GetOrCreateExternalComponentCallbacks(Worker_ComponentId ComponentId);
 	FCallbackId AddGenericOpCallback(Worker_ComponentId ComponentId, Worker_OpType OpType, const TFunction<void(const Worker_Op*)>& Callback);
+	void AddCallback(FPendingCallback&& Callback);
+	bool MarkCallbackRemoved(FCallbackId CallbackId, const CallbackIdData& CallbackData);
 	void RunCallbacks(Worker_ComponentId ComponentId, const Worker_Op* Op);
+	void RunBatchCallbacks();
+	void FinishRunningCallbacks();
 
 	UPROPERTY()
 	USpatialNetDriver* NetDriver;
@@ -81,7 +125,21 @@ private:
 	// RunCallbacks is called by the SpatialDispatcher and executes all user registered 
 	// callbacks for the matching component ID and network operation type.
 	FCallbackId NextCallbackId;
-	TMap<Worker_ComponentId, OpTypeToCallbacksMap> ComponentOpTypeToCallbacksMap;
+	// Indexed by component ID minus MIN_EXTERNAL_SCHEMA_ID. Empty until the first callback is registered.
+	TArray<FExternalComponentCallbacks> ExternalComponentCallbacks;
+	TArray<Worker_ComponentId> ComponentsWithBatchedOps;
 	TMap<FCallbackId, CallbackIdData> CallbackIdToDataMap;
-	TArray<const Worker_Op*> OpsToSkip;
+
+	// Callbacks are run by reference, so the callback arrays aren't changed until no callbacks are running.
+	int32 CallbackDispatchDepth = 0;
+	TArray<FPendingCallback> PendingCallbacks;
+	TArray<Worker_ComponentId> ComponentsWithRemovedCallbacks;
+	TSet<const Worker_Op*> OpsToSkip;
+
+	// Ops whose updates were merged into a later op by FoldComponentUpdates, indexed like the ops of FoldedOpList.
+	const Worker_OpList* FoldedOpList;
+	TBitArray<> FoldedOps;
+
+	// Whether the last critical section op processed started a critical section, which may span several calls to ProcessOps.
+	bool bInCriticalSection;
 };
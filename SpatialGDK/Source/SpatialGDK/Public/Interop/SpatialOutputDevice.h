@@ -4,30 +4,66 @@
 
 #include "CoreMinimal.h"
 #include "Misc/OutputDevice.h"
+#include "UObject/WeakObjectPtr.h"
 
 #include <WorkerSDK/improbable/c_worker.h>
 
 class USpatialWorkerConnection;
 
+// Forwards log lines to SpatialOS. Lines are filtered by verbosity and category, rate limited per category,
+// collapsed when the same line is repeated, and sent in batches when the device is flushed.
 class SPATIALGDK_API FSpatialOutputDevice : public FOutputDevice
 {
 public:
 	FSpatialOutputDevice(USpatialWorkerConnection* InConnection, FName LoggerName, int32 InPIEIndex);
 	~FSpatialOutputDevice();
 
+	// If any categories are added, only those categories are forwarded to SpatialOS.
 	void AddRedirectCategory(const FName& Category);
 	void RemoveRedirectCategory(const FName& Category);
 	void SetVerbosityFilterLevel(ELogVerbosity::Type Verbosity);
 	void Serialize(const TCHAR* InData, ELogVerbosity::Type Verbosity, const FName& Category) override;
 
+	// Sends all batched lines. Called at the end of each net driver tick, as well as when the log is flushed.
+	void Flush() override;
+
 	static Worker_LogLevel ConvertLogLevelToSpatial(ELogVerbosity::Type Verbosity);
 
 protected:
+	// Token bucket used to limit the number of lines forwarded per category.
+	struct FCategoryRateLimit
+	{
+		double Tokens;
+		double LastRefillTime;
+		int32 NumDropped;
+	};
+
+	bool ConsumeRateLimitToken(const FName& Category);
+	void BatchRepeatedLine();
+	void BatchLine(Worker_LogLevel Level, const FName& Category, const FString& Line, int32 Count);
+	void SendBatch();
+
 	ELogVerbosity::Type FilterLevel;
 	TSet<FName> CategoriesToRedirect;
-	USpatialWorkerConnection* Connection;
+	// Weak, since the device can outlive the connection while the net driver is being destroyed.
+	TWeakObjectPtr<USpatialWorkerConnection> Connection;
 	FName WorkerName;
 
 	int32 PIEIndex;
 	bool bLogToSpatial;
+
+	float MaxLinesPerSecondPerCategory;
+	float MaxBurstLinesPerCategory;
+	TMap<FName, FCategoryRateLimit> CategoryRateLimits;
+	double LastDroppedLinesReportTime;
+
+	// The last line received is held back so that identical lines following it can be collapsed into it.
+	FString RepeatedLine;
+	FName RepeatedLineCategory;
+	Worker_LogLevel RepeatedLineLevel;
+	int32 RepeatCount;
+
+	// Consecutive lines with the same level are sent as a single log message.
+	FString Batch;
+	Worker_LogLevel BatchLevel;
 };
@@ -7,6 +7,7 @@
 #include "EngineClasses/SpatialActorChannel.h"
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
+#include "Interop/Connection/ComponentUpdatePredecoder.h"
 #include "Interop/SpatialClassInfoManager.h"
 #include "Schema/DynamicComponent.h"
 #include "Schema/RPCPayload.h"
@@ -125,7 +126,8 @@ public:
 	void RemoveComponentOpsForEntity(Worker_EntityId EntityId);
 	void OnAuthorityChange(const Worker_AuthorityChangeOp& Op);
 
-	void OnComponentUpdate(const Worker_ComponentUpdateOp& Op);
+	// Predecoded is the update decoded on the ops processing thread, if it was.
+	void OnComponentUpdate(const Worker_ComponentUpdateOp& Op, const SpatialGDK::FPredecodedComponentUpdate* Predecoded = nullptr);
 	void HandleRPC(const Worker_ComponentUpdateOp& Op);
 
 	void ProcessRPCEventField(Worker_EntityId EntityId, const Worker_ComponentUpdateOp &Op, const Worker_ComponentId RPCEndpointComponentId, bool bPacked);
@@ -150,6 +152,19 @@ public:
 	void ResolvePendingOperations(UObject* Object, const FUnrealObjectRef& ObjectRef);
 	void FlushRetryRPCs();
 
+	// Applies queued RPCs that have waited long enough to be applied with unresolved references.
+	void ProcessTimedOutIncomingRPCs();
+
+	int32 GetNumQueuedIncomingRPCs() const { return IncomingRPCs.GetNumQueuedRPCs(); }
+	double GetOldestQueuedIncomingRPCAgeSeconds() const { return IncomingRPCs.GetOldestQueuedRPCAgeSeconds(); }
+	uint32 TakeNumDroppedIncomingRPCs() { return IncomingRPCs.TakeNumDroppedRPCs(); }
+
+	// Calls BeginPlay on batch spawned actors that didn't fit in the budget of the frame they were spawned in.
+	void ProcessPendingBeginPlayActors();
+
+	// The most actors spawned in a frame and the longest time spent spawning them in a frame since the last call.
+	void TakeActorSpawnStats(uint32& OutMaxActorsSpawnedPerFrame, double& OutLongestSpawnFrameSeconds);
+
 	void OnDisconnect(Worker_DisconnectOp& Op);
 
 private:
@@ -157,8 +172,13 @@ private:
 	void LeaveCriticalSection();
 
 	void ReceiveActor(Worker_EntityId EntityId);
+	void SortPendingAddEntitiesByClass();
+	void DispatchActorBeginPlay(AActor* EntityActor);
+	void RemovePendingBeginPlayActor(AActor* Actor);
+	void RecordActorSpawnTime(uint64 StartCycles, uint32 NumActorsSpawnedSinceStart);
 	void RemoveActor(Worker_EntityId EntityId);
 	void DestroyActor(AActor* Actor, Worker_EntityId EntityId);
+	void ReturnActorToPool(AActor* Actor, Worker_EntityId EntityId);
 
 	AActor* TryGetOrCreateActor(SpatialGDK::UnrealMetadata* UnrealMetadata, SpatialGDK::SpawnData* SpawnData);
 	AActor* CreateActor(SpatialGDK::UnrealMetadata* UnrealMetadata, SpatialGDK::SpawnData* SpawnData);
@@ -178,10 +198,10 @@ private:
 	void HandleIndividualAddComponent(const Worker_AddComponentOp& Op);
 	void AttachDynamicSubobject(Worker_EntityId EntityId, const FClassInfo& Info);
 
-	void ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* TargetObject, USpatialActorChannel* Channel, bool bIsHandover);
+	void ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* TargetObject, USpatialActorChannel* Channel, bool bIsHandover, const SpatialGDK::FPredecodedComponentUpdate* Predecoded = nullptr);
 
-	bool ApplyRPC(const FPendingRPCParams& Params);
-	bool ApplyRPC(UObject* TargetObject, UFunction* Function, const SpatialGDK::RPCPayload& Payload, const FString& SenderWorkerId, bool bApplyWithUnresolvedRefs = false);	
+	bool ApplyRPC(const FPendingRPCParams& Params, TSet<FUnrealObjectRef>& OutUnresolvedRefs);
+	bool ApplyRPC(UObject* TargetObject, UFunction* Function, const SpatialGDK::RPCPayload& Payload, const FString& SenderWorkerId, bool bApplyWithUnresolvedRefs = false, TSet<FUnrealObjectRef>* OutUnresolvedRefs = nullptr);
 
 	void ReceiveCommandResponse(const Worker_CommandResponseOp& Op);
 
@@ -189,12 +209,12 @@ private:
 
 	void QueueIncomingRepUpdates(FChannelObjectPair ChannelObjectPair, const FObjectReferencesMap& ObjectReferencesMap, const TSet<FUnrealObjectRef>& UnresolvedRefs);
 
-	void QueueIncomingRPC(FPendingRPCParamsPtr Params);
+	void QueueIncomingRPC(FPendingRPCParams&& Params);
 
 	void ResolvePendingOperations_Internal(UObject* Object, const FUnrealObjectRef& ObjectRef);
 	void ResolveIncomingOperations(UObject* Object, const FUnrealObjectRef& ObjectRef);
 
-	void ResolveIncomingRPCs();
+	void ResolveIncomingRPCs(const FUnrealObjectRef& ObjectRef);
 
 	void ResolveObjectReferences(FRepLayout& RepLayout, UObject* ReplicatedObject, FObjectReferencesMap& ObjectReferencesMap, uint8* RESTRICT StoredData, uint8* RESTRICT Data, int32 MaxAbsOffset, TArray<UProperty*>& RepNotifies, bool& bOutSomeObjectsWereMapped, bool& bOutStillHasUnresolved);
 
@@ -244,8 +264,21 @@ private:
 	TArray<Worker_EntityId> PendingAddEntities;
 	TArray<Worker_AuthorityChangeOp> PendingAuthorityChanges;
 	TArray<PendingAddComponentWrapper> PendingAddComponents;
+	// Indices into PendingAddComponents for each entity, so spawning an actor doesn't scan the components of every entity.
+	TMap<Worker_EntityId_Key, TArray<int32>> PendingAddComponentIndices;
 	TArray<Worker_RemoveComponentOp> QueuedRemoveComponentOps;
 
+	// Batch spawned actors waiting for BeginPlay, in the order they were spawned.
+	TArray<TWeakObjectPtr<AActor>> PendingBeginPlayActors;
+	int32 NextPendingBeginPlayActor;
+
+	uint32 NumActorsSpawned;
+	uint64 SpawnStatsFrameNumber;
+	uint64 SpawnCyclesThisFrame;
+	uint32 ActorsSpawnedThisFrame;
+	uint64 LongestSpawnFrameCycles;
+	uint32 MaxActorsSpawnedPerFrame;
+
 	TMap<Worker_RequestId, TWeakObjectPtr<USpatialActorChannel>> PendingActorRequests;
 	FReliableRPCMap PendingReliableRPCs;
 
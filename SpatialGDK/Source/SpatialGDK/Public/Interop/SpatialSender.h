@@ -103,12 +103,13 @@ public:
 
 	void ResolveOutgoingOperations(UObject* Object, bool bIsHandover);
 	void SendOutgoingRPCs();
+	uint32 TakeNumDroppedOutgoingRPCs() { return OutgoingRPCs.TakeNumDroppedRPCs(); }
 
 	bool UpdateEntityACLs(Worker_EntityId EntityId, const FString& OwnerWorkerAttribute);
 	void UpdateInterestComponent(AActor* Actor);
 
-	void ProcessRPC(FPendingRPCParamsPtr Params);
-	void QueueOutgoingRPC(FPendingRPCParamsPtr Params);
+	void ProcessRPC(FPendingRPCParams&& Params);
+	void QueueOutgoingRPC(FPendingRPCParams&& Params);
 	void ProcessUpdatesQueuedUntilAuthority(Worker_EntityId EntityId);
 
 	void FlushPackedRPCs();
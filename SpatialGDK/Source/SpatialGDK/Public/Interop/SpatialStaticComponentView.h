@@ -26,11 +26,14 @@ public:
 	template <typename T>
 	T* GetComponentData(Worker_EntityId EntityId)
 	{
-		if (TMap<Worker_ComponentId, TUniquePtr<SpatialGDK::ComponentStorageBase>>* ComponentStorageMap = EntityComponentMap.Find(EntityId))
+		static_assert(GetWellKnownComponentIndex(T::ComponentId) != INDEX_NONE && GetWellKnownComponentIndex(T::ComponentId) < NumWellKnownComponentsWithData,
+			"Component data is only stored for well-known components.");
+
+		if (FEntityRecord* Record = FindEntityRecord(EntityId))
 		{
-			if (TUniquePtr<SpatialGDK::ComponentStorageBase>* Component = ComponentStorageMap->Find(T::ComponentId))
+			if (SpatialGDK::ComponentStorageBase* Component = Record->Data[GetWellKnownComponentIndex(T::ComponentId)].Get())
 			{
-				return &(static_cast<SpatialGDK::ComponentStorage<T>*>(Component->Get())->Get());
+				return &(static_cast<SpatialGDK::ComponentStorage<T>*>(Component)->Get());
 			}
 		}
 
@@ -45,6 +48,92 @@ public:
 	void OnAuthorityChange(const Worker_AuthorityChangeOp& Op);
 
 private:
-	TMap<Worker_EntityId_Key, TMap<Worker_ComponentId, Worker_Authority>> EntityComponentAuthorityMap;
-	TMap<Worker_EntityId_Key, TMap<Worker_ComponentId, TUniquePtr<SpatialGDK::ComponentStorageBase>>> EntityComponentMap;
+	// Components with a fixed index in an entity record, so that their presence and authority can be kept in bitsets.
+	// The ones whose data is stored in the view come first.
+	enum EWellKnownComponent : int32
+	{
+		WellKnown_EntityAcl,
+		WellKnown_Metadata,
+		WellKnown_Position,
+		WellKnown_Persistence,
+		WellKnown_SpawnData,
+		WellKnown_Singleton,
+		WellKnown_UnrealMetadata,
+		WellKnown_Interest,
+		WellKnown_Heartbeat,
+		WellKnown_RPCsOnEntityCreation,
+		WellKnown_ClientRPCEndpoint,
+		WellKnown_ServerRPCEndpoint,
+		NumWellKnownComponentsWithData,
+
+		WellKnown_PlayerSpawner = NumWellKnownComponentsWithData,
+		WellKnown_SingletonManager,
+		WellKnown_DeploymentMap,
+		WellKnown_StartupActorManager,
+		WellKnown_GSMShutdown,
+		WellKnown_NetMulticastRPCs,
+		WellKnown_NotStreamed,
+		WellKnown_DebugMetrics,
+		WellKnown_AlwaysRelevant,
+		NumWellKnownComponents
+	};
+
+	static_assert(NumWellKnownComponents <= 32, "Well-known component bitsets are stored in a uint32.");
+
+	static constexpr int32 GetWellKnownComponentIndex(Worker_ComponentId ComponentId)
+	{
+		switch (ComponentId)
+		{
+		case SpatialConstants::ENTITY_ACL_COMPONENT_ID:				return WellKnown_EntityAcl;
+		case SpatialConstants::METADATA_COMPONENT_ID:				return WellKnown_Metadata;
+		case SpatialConstants::POSITION_COMPONENT_ID:				return WellKnown_Position;
+		case SpatialConstants::PERSISTENCE_COMPONENT_ID:			return WellKnown_Persistence;
+		case SpatialConstants::SPAWN_DATA_COMPONENT_ID:				return WellKnown_SpawnData;
+		case SpatialConstants::SINGLETON_COMPONENT_ID:				return WellKnown_Singleton;
+		case SpatialConstants::UNREAL_METADATA_COMPONENT_ID:		return WellKnown_UnrealMetadata;
+		case SpatialConstants::INTEREST_COMPONENT_ID:				return WellKnown_Interest;
+		case SpatialConstants::HEARTBEAT_COMPONENT_ID:				return WellKnown_Heartbeat;
+		case SpatialConstants::RPCS_ON_ENTITY_CREATION_ID:			return WellKnown_RPCsOnEntityCreation;
+		case SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID:	return WellKnown_ClientRPCEndpoint;
+		case SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID:	return WellKnown_ServerRPCEndpoint;
+		case SpatialConstants::PLAYER_SPAWNER_COMPONENT_ID:			return WellKnown_PlayerSpawner;
+		case SpatialConstants::SINGLETON_MANAGER_COMPONENT_ID:		return WellKnown_SingletonManager;
+		case SpatialConstants::DEPLOYMENT_MAP_COMPONENT_ID:			return WellKnown_DeploymentMap;
+		case SpatialConstants::STARTUP_ACTOR_MANAGER_COMPONENT_ID:	return WellKnown_StartupActorManager;
+		case SpatialConstants::GSM_SHUTDOWN_COMPONENT_ID:			return WellKnown_GSMShutdown;
+		case SpatialConstants::NETMULTICAST_RPCS_COMPONENT_ID:		return WellKnown_NetMulticastRPCs;
+		case SpatialConstants::NOT_STREAMED_COMPONENT_ID:			return WellKnown_NotStreamed;
+		case SpatialConstants::DEBUG_METRICS_COMPONENT_ID:			return WellKnown_DebugMetrics;
+		case SpatialConstants::ALWAYS_RELEVANT_COMPONENT_ID:		return WellKnown_AlwaysRelevant;
+		default:													return INDEX_NONE;
+		}
+	}
+
+	struct FEntityRecord
+	{
+		uint32 ComponentBits = 0;
+		uint32 AuthorityBits = 0;
+		uint32 AuthorityLossImminentBits = 0;
+
+		// Indexed by EWellKnownComponent. Data is heap allocated so that pointers returned by GetComponentData stay
+		// valid while other entities are added.
+		TUniquePtr<SpatialGDK::ComponentStorageBase> Data[NumWellKnownComponentsWithData];
+
+		// Generated and external components. There are few per entity, so these are searched linearly.
+		TArray<Worker_ComponentId> OtherComponents;
+		TArray<TPair<Worker_ComponentId, Worker_Authority>> OtherAuthority;
+	};
+
+	FEntityRecord* FindEntityRecord(Worker_EntityId EntityId)
+	{
+		const int32* RecordIndex = EntityRecordIndices.Find(EntityId);
+		return RecordIndex != nullptr ? &EntityRecords[*RecordIndex] : nullptr;
+	}
+
+	FEntityRecord& FindOrAddEntityRecord(Worker_EntityId EntityId);
+
+	// Records are reused once their entity is removed, so that they stay densely packed.
+	TMap<Worker_EntityId_Key, int32> EntityRecordIndices;
+	TArray<FEntityRecord> EntityRecords;
+	TArray<int32> FreeEntityRecords;
 };
@@ -2,5 +2,202 @@
 
 #include "Schema/UnrealObjectRef.h"
 
+#include "Containers/Map.h"
+#include "Misc/Optional.h"
+#include "Misc/ScopeRWLock.h"
+
+#include <atomic>
+
 const FUnrealObjectRef FUnrealObjectRef::NULL_OBJECT_REF = FUnrealObjectRef(0, 0);
 const FUnrealObjectRef FUnrealObjectRef::UNRESOLVED_OBJECT_REF = FUnrealObjectRef(0, 1);
+
+struct FObjectRefPath
+{
+	TOptional<FString> Path;
+	TOptional<FUnrealObjectRef> Outer;
+
+	// Outers are compared with their bNoLoadOnClient, so GetOuter returns the flags each ref was created with.
+	bool operator==(const FObjectRefPath& Other) const
+	{
+		return ((!Path.IsSet() && !Other.Path.IsSet()) || (Path.IsSet() && Other.Path.IsSet() && Path->Equals(*Other.Path))) &&
+			((!Outer.IsSet() && !Other.Outer.IsSet()) || (Outer.IsSet() && Other.Outer.IsSet() && Outer->IsIdenticalTo(*Other.Outer)));
+	}
+};
+
+namespace
+{
+	uint32 GetTypeHash(const FObjectRefPath& ObjectRefPath)
+	{
+		uint32 Result = 1327u;
+		Result = (Result * 977u) + (ObjectRefPath.Path.IsSet() ? GetTypeHash(*ObjectRefPath.Path) : 0u);
+		Result = (Result * 977u) + (ObjectRefPath.Outer.IsSet() ? GetTypeHash(*ObjectRefPath.Outer) : 0u);
+		Result = (Result * 977u) + (ObjectRefPath.Outer.IsSet() && ObjectRefPath.Outer->bNoLoadOnClient ? 1u : 0u);
+		return Result;
+	}
+
+	// Looks up the paths stored in the table by value, so the map doesn't need its own copy of each path.
+	struct FObjectRefPathKeyFuncs : TDefaultMapKeyFuncs<const FObjectRefPath*, uint32, false>
+	{
+		static FORCEINLINE bool Matches(KeyInitType A, KeyInitType B)
+		{
+			return *A == *B;
+		}
+
+		static FORCEINLINE uint32 GetKeyHash(KeyInitType Key)
+		{
+			return GetTypeHash(*Key);
+		}
+	};
+
+	// Paths are only ever added, so IDs and the paths they refer to stay valid for the lifetime of the process.
+	// Paths are stored in fixed size chunks that never move, so they can be read without taking the lock.
+	class FObjectRefPathTable
+	{
+	public:
+		~FObjectRefPathTable()
+		{
+			for (std::atomic<FObjectRefPath*>& Chunk : Chunks)
+			{
+				delete[] Chunk.load(std::memory_order_relaxed);
+			}
+		}
+
+		uint32 Intern(FObjectRefPath&& ObjectRefPath)
+		{
+			{
+				FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+				if (const uint32* Id = Ids.Find(&ObjectRefPath))
+				{
+					return *Id;
+				}
+			}
+
+			FRWScopeLock WriteLock(Lock, SLT_Write);
+
+			// Another thread may have added the path while the lock was released.
+			if (const uint32* Id = Ids.Find(&ObjectRefPath))
+			{
+				return *Id;
+			}
+
+			const uint32 Index = NumPaths;
+			checkf(Index < ChunkSize * MaxChunks, TEXT("Too many object ref paths have been interned."));
+
+			FObjectRefPath* Chunk = Chunks[Index / ChunkSize].load(std::memory_order_relaxed);
+			if (Chunk == nullptr)
+			{
+				Chunk = new FObjectRefPath[ChunkSize];
+				Chunks[Index / ChunkSize].store(Chunk, std::memory_order_release);
+			}
+
+			FObjectRefPath& StoredPath = Chunk[Index % ChunkSize];
+			StoredPath = MoveTemp(ObjectRefPath);
+			NumPaths++;
+
+			// IDs start at 1, since 0 means no path.
+			const uint32 Id = Index + 1;
+			Ids.Add(&StoredPath, Id);
+			return Id;
+		}
+
+		// A ref's ID can only be seen after its path has been added, and paths are never changed afterwards.
+		const FObjectRefPath& Get(uint32 Id) const
+		{
+			const uint32 Index = Id - 1;
+			const FObjectRefPath* Chunk = Chunks[Index / ChunkSize].load(std::memory_order_acquire);
+			checkSlow(Id > 0 && Chunk != nullptr);
+			return Chunk[Index % ChunkSize];
+		}
+
+	private:
+		static constexpr uint32 ChunkSize = 4096;
+		static constexpr uint32 MaxChunks = 4096;
+
+		std::atomic<FObjectRefPath*> Chunks[MaxChunks] = {};
+
+		// Guards Ids and NumPaths.
+		FRWLock Lock;
+		uint32 NumPaths = 0;
+		TMap<const FObjectRefPath*, uint32, FDefaultSetAllocator, FObjectRefPathKeyFuncs> Ids;
+	};
+
+	FObjectRefPathTable& GetObjectRefPathTable()
+	{
+		static FObjectRefPathTable PathTable;
+		return PathTable;
+	}
+}
+
+const FObjectRefPath* FUnrealObjectRef::ResolvePath() const
+{
+	return PathId != 0 ? &GetObjectRefPathTable().Get(PathId) : nullptr;
+}
+
+bool FUnrealObjectRef::HasPath() const
+{
+	const FObjectRefPath* ObjectRefPath = ResolvePath();
+	return ObjectRefPath != nullptr && ObjectRefPath->Path.IsSet();
+}
+
+const FString& FUnrealObjectRef::GetPath() const
+{
+	const FObjectRefPath* ObjectRefPath = ResolvePath();
+	checkf(ObjectRefPath != nullptr && ObjectRefPath->Path.IsSet(), TEXT("It is an error to call GetPath() on an object ref without a path. Please check HasPath()."));
+	return ObjectRefPath->Path.GetValue();
+}
+
+bool FUnrealObjectRef::HasOuter() const
+{
+	const FObjectRefPath* ObjectRefPath = ResolvePath();
+	return ObjectRefPath != nullptr && ObjectRefPath->Outer.IsSet();
+}
+
+FUnrealObjectRef FUnrealObjectRef::GetOuter() const
+{
+	const FObjectRefPath* ObjectRefPath = ResolvePath();
+	checkf(ObjectRefPath != nullptr && ObjectRefPath->Outer.IsSet(), TEXT("It is an error to call GetOuter() on an object ref without an outer. Please check HasOuter()."));
+	return ObjectRefPath->Outer.GetValue();
+}
+
+void FUnrealObjectRef::SetPathAndOuter(const FString* Path, const FUnrealObjectRef* Outer)
+{
+	InternPath(Path, Outer);
+}
+
+void FUnrealObjectRef::InternPath(const FString* Path, const FUnrealObjectRef* Outer)
+{
+	if (Path == nullptr && Outer == nullptr)
+	{
+		PathId = 0;
+		PathKeyId = 0;
+		return;
+	}
+
+	FObjectRefPath ObjectRefPath;
+	if (Path != nullptr)
+	{
+		ObjectRefPath.Path = *Path;
+	}
+	if (Outer != nullptr)
+	{
+		ObjectRefPath.Outer = *Outer;
+	}
+
+	FObjectRefPathTable& PathTable = GetObjectRefPathTable();
+	PathId = PathTable.Intern(MoveTemp(ObjectRefPath));
+	PathKeyId = PathId;
+
+	if (Outer != nullptr && (Outer->bNoLoadOnClient || Outer->PathId != Outer->PathKeyId))
+	{
+		FObjectRefPath KeyPath;
+		if (Path != nullptr)
+		{
+			KeyPath.Path = *Path;
+		}
+		KeyPath.Outer = *Outer;
+		KeyPath.Outer->bNoLoadOnClient = false;
+		KeyPath.Outer->PathId = Outer->PathKeyId;
+
+		PathKeyId = PathTable.Intern(MoveTemp(KeyPath));
+	}
+}
@@ -9,6 +9,10 @@
 
 using Worker_EntityId = std::int64_t;
 
+struct FObjectRefPath;
+
+// Refs are small values that can be copied, compared and hashed without touching their paths. The path and outer chain
+// of stably named objects is interned in a global table, which is never shrunk, and referred to by index.
 struct FUnrealObjectRef
 {
 	FUnrealObjectRef() = default;
@@ -18,30 +22,12 @@ struct FUnrealObjectRef
 		, Offset(Offset)
 	{}
 
-	FUnrealObjectRef(Worker_EntityId Entity, uint32 Offset, FString Path, FUnrealObjectRef Outer, bool bNoLoadOnClient = false)
+	FUnrealObjectRef(Worker_EntityId Entity, uint32 Offset, const FString& Path, const FUnrealObjectRef& Outer, bool bNoLoadOnClient = false)
 		: Entity(Entity)
 		, Offset(Offset)
-		, Path(Path)
-		, Outer(Outer)
 		, bNoLoadOnClient(bNoLoadOnClient)
-	{}
-
-	FUnrealObjectRef(const FUnrealObjectRef& In)
-		: Entity(In.Entity)
-		, Offset(In.Offset)
-		, Path(In.Path)
-		, Outer(In.Outer)
-		, bNoLoadOnClient(In.bNoLoadOnClient)
-	{}
-
-	FORCEINLINE FUnrealObjectRef& operator=(const FUnrealObjectRef& In)
 	{
-		Entity = In.Entity;
-		Offset = In.Offset;
-		Path = In.Path;
-		Outer = In.Outer;
-		bNoLoadOnClient = In.bNoLoadOnClient;
-		return *this;
+		InternPath(&Path, &Outer);
 	}
 
 	FORCEINLINE FString ToString() const
@@ -51,14 +37,14 @@ struct FUnrealObjectRef
 
 	FORCEINLINE FUnrealObjectRef GetLevelReference() const
 	{
-		if (Path->Equals(TEXT("PersistentLevel")))
+		if (GetPath().Equals(TEXT("PersistentLevel")))
 		{
 			return *this;
 		}
 
-		if (Outer.IsSet())
+		if (HasOuter())
 		{
-			return Outer->GetLevelReference();
+			return GetOuter().GetLevelReference();
 		}
 		else
 		{
@@ -68,10 +54,10 @@ struct FUnrealObjectRef
 
 	FORCEINLINE bool operator==(const FUnrealObjectRef& Other) const
 	{
+		// Refs with equal paths and outer chains share a path key ID.
 		return Entity == Other.Entity &&
 			Offset == Other.Offset &&
-			((!Path && !Other.Path) || (Path && Other.Path && Path->Equals(*Other.Path))) &&
-			((!Outer && !Other.Outer) || (Outer && Other.Outer && *Outer == *Other.Outer));
+			PathKeyId == Other.PathKeyId;
 		// Intentionally don't compare bNoLoadOnClient since it does not affect equality.
 	}
 
@@ -80,19 +66,47 @@ struct FUnrealObjectRef
 		return !operator==(Other);
 	}
 
+	// As operator==, but also compares the bNoLoadOnClient of the refs and of their outers.
+	FORCEINLINE bool IsIdenticalTo(const FUnrealObjectRef& Other) const
+	{
+		return *this == Other &&
+			bNoLoadOnClient == Other.bNoLoadOnClient &&
+			PathId == Other.PathId;
+	}
+
 	FORCEINLINE bool IsValid() const
 	{
 		return (*this != NULL_OBJECT_REF && *this != UNRESOLVED_OBJECT_REF);
 	}
 
+	bool HasPath() const;
+	const FString& GetPath() const;
+	bool HasOuter() const;
+	FUnrealObjectRef GetOuter() const;
+
+	// Either may be null to leave it unset.
+	void SetPathAndOuter(const FString* Path, const FUnrealObjectRef* Outer);
+
 	static const FUnrealObjectRef NULL_OBJECT_REF;
 	static const FUnrealObjectRef UNRESOLVED_OBJECT_REF;
 
 	Worker_EntityId Entity;
 	uint32 Offset;
-	SpatialGDK::TSchemaOption<FString> Path;
-	SpatialGDK::TSchemaOption<FUnrealObjectRef> Outer;
 	bool bNoLoadOnClient = false;
+
+private:
+	void InternPath(const FString* Path, const FUnrealObjectRef* Outer);
+
+	// The interned path and outer, or nullptr if the ref has neither.
+	const FObjectRefPath* ResolvePath() const;
+
+	// Index into the path table, or 0 if the ref has neither a path nor an outer.
+	uint32 PathId = 0;
+
+	// As PathId, but for the path with the bNoLoadOnClient of every outer cleared. Refs that only differ in those flags are equal.
+	uint32 PathKeyId = 0;
+
+	friend uint32 GetTypeHash(const FUnrealObjectRef& ObjectRef);
 };
 
 inline uint32 GetTypeHash(const FUnrealObjectRef& ObjectRef)
@@ -100,8 +114,7 @@ inline uint32 GetTypeHash(const FUnrealObjectRef& ObjectRef)
 	uint32 Result = 1327u;
 	Result = (Result * 977u) + GetTypeHash(static_cast<int64>(ObjectRef.Entity));
 	Result = (Result * 977u) + GetTypeHash(ObjectRef.Offset);
-	Result = (Result * 977u) + GetTypeHash(ObjectRef.Path);
-	Result = (Result * 977u) + GetTypeHash(ObjectRef.Outer);
+	Result = (Result * 977u) + GetTypeHash(ObjectRef.PathKeyId);
 	// Intentionally don't hash bNoLoadOnClient.
 	return Result;
 }
@@ -197,6 +197,24 @@ namespace SpatialConstants
 	const Worker_ComponentId MAX_EXTERNAL_SCHEMA_ID = 2000;
 
 	const FString SPATIALOS_METRICS_DYNAMIC_FPS = TEXT("Dynamic.FPS");
+	const FString SPATIALOS_METRICS_OUTGOING_QUEUE_DEPTH = TEXT("Connection.OutgoingQueueDepth");
+	const FString SPATIALOS_METRICS_OUTGOING_QUEUE_HIGH_WATER_MARK = TEXT("Connection.OutgoingQueueHighWaterMark");
+	const FString SPATIALOS_METRICS_SEND_LATENCY_P50 = TEXT("Connection.SendLatencyP50Ms");
+	const FString SPATIALOS_METRICS_SEND_LATENCY_P99 = TEXT("Connection.SendLatencyP99Ms");
+	const FString SPATIALOS_METRICS_COALESCED_COMPONENT_UPDATES = TEXT("Connection.CoalescedComponentUpdates");
+	const FString SPATIALOS_METRICS_DEFERRED_OUTGOING_MESSAGES = TEXT("Connection.DeferredOutgoingMessages");
+	const FString SPATIALOS_METRICS_TICK_DISPATCH_TIME = TEXT("Tick.DispatchMs");
+	const FString SPATIALOS_METRICS_SERVER_REPLICATE_ACTORS_TIME = TEXT("Tick.ServerReplicateActorsMs");
+	const FString SPATIALOS_METRICS_FLUSH_PACKED_RPCS_TIME = TEXT("Tick.FlushPackedRPCsMs");
+	const FString SPATIALOS_METRICS_PROCESS_POSITION_UPDATES_TIME = TEXT("Tick.ProcessPositionUpdatesMs");
+	const FString SPATIALOS_METRICS_OP_LIST_SIZE = TEXT("Connection.OpListSize");
+	const FString SPATIALOS_METRICS_OP_BACKLOG_DRAIN_FRAMES = TEXT("Connection.OpBacklogDrainFrames");
+	const FString SPATIALOS_METRICS_QUEUED_INCOMING_RPCS = TEXT("Receiver.QueuedIncomingRPCs");
+	const FString SPATIALOS_METRICS_OLDEST_QUEUED_INCOMING_RPC_AGE = TEXT("Receiver.OldestQueuedIncomingRPCAgeSeconds");
+	const FString SPATIALOS_METRICS_DROPPED_INCOMING_RPCS = TEXT("Receiver.DroppedIncomingRPCs");
+	const FString SPATIALOS_METRICS_DROPPED_OUTGOING_RPCS = TEXT("Sender.DroppedOutgoingRPCs");
+	const FString SPATIALOS_METRICS_MAX_ACTORS_SPAWNED_PER_FRAME = TEXT("Receiver.MaxActorsSpawnedPerFrame");
+	const FString SPATIALOS_METRICS_LONGEST_ACTOR_SPAWN_FRAME = TEXT("Receiver.LongestActorSpawnFrameSeconds");
 
 	const FString LOCATOR_HOST = TEXT("locator.improbable.io");
 	const uint16 LOCATOR_PORT = 444;
@@ -9,6 +9,55 @@
 
 #include "SpatialGDKSettings.generated.h"
 
+USTRUCT()
+struct FOutgoingMessageBudget
+{
+	GENERATED_BODY()
+
+	/** Maximum number of messages of this type sent per network update. 0 means no limit. */
+	UPROPERTY(EditAnywhere, Config, Category = "SpatialGDK")
+	int32 MaxMessagesPerUpdate;
+
+	/** Approximate maximum number of bytes of messages of this type sent per network update. 0 means no limit. */
+	UPROPERTY(EditAnywhere, Config, Category = "SpatialGDK")
+	int32 MaxBytesPerUpdate;
+
+	FOutgoingMessageBudget() : MaxMessagesPerUpdate(0), MaxBytesPerUpdate(0)
+	{
+	}
+};
+
+UENUM()
+enum class ERPCQueueOverflowPolicy : uint8
+{
+	/** Drop the RPC that has been queued the longest to make room for the new one. */
+	DropOldest,
+	/** Drop the new RPC. */
+	DropNewest
+};
+
+USTRUCT()
+struct FRPCQueuePolicy
+{
+	GENERATED_BODY()
+
+	/** Maximum number of RPCs of this type queued per entity. 0 means no limit. */
+	UPROPERTY(EditAnywhere, Config, Category = "SpatialGDK")
+	int32 MaxQueueLength;
+
+	/** Seconds after which a queued RPC of this type is dropped instead of being sent or applied. 0 means no limit. */
+	UPROPERTY(EditAnywhere, Config, Category = "SpatialGDK")
+	float MaxAgeSeconds;
+
+	/** Which RPC is dropped when a queue is full. */
+	UPROPERTY(EditAnywhere, Config, Category = "SpatialGDK")
+	ERPCQueueOverflowPolicy OverflowPolicy;
+
+	FRPCQueuePolicy() : MaxQueueLength(0), MaxAgeSeconds(0.0f), OverflowPolicy(ERPCQueueOverflowPolicy::DropOldest)
+	{
+	}
+};
+
 UCLASS(config = SpatialGDKSettings, defaultconfig)
 class SPATIALGDK_API USpatialGDKSettings : public UObject
 {
@@ -79,6 +128,77 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "SpatialOS Network Update Rate"))
 	float OpsUpdateRate;
 
+	/**
+	* Wake the network update thread when messages are queued or a game tick ends, instead of waking it at a fixed rate.
+	* The thread then waits for incoming ops with a blocking timeout rather than sleeping, which lowers send latency and idle CPU usage.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Event-driven Network Update"))
+	bool bEventDrivenOpsUpdate;
+
+	/**
+	* When using event-driven network updates, the maximum time, in seconds, the network update thread waits without being woken before it checks for incoming ops.
+	* Default: 0.05 seconds
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bEventDrivenOpsUpdate", DisplayName = "Event-driven Network Update Max Idle Time (seconds)"))
+	float EventDrivenOpsUpdateMaxIdleTime;
+
+	/**
+	* When using event-driven network updates, the time, in milliseconds, the network update thread blocks waiting for incoming ops after each wakeup.
+	* Default: 1 millisecond
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bEventDrivenOpsUpdate", DisplayName = "Event-driven Network Update Op List Timeout (milliseconds)"))
+	uint32 EventDrivenOpListTimeoutMs;
+
+	/**
+	* Maximum time, in milliseconds, spent processing received ops each frame. Ops left over are processed in the following frames,
+	* which spreads the cost of a large burst of ops, for example after a big interest change, over several frames.
+	* A critical section is never split across frames, so a frame can go over budget by the time taken to process one critical section.
+	* Default: `0` (no limit)
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Op Processing Budget per Frame (milliseconds)"))
+	float OpsProcessingBudgetMs;
+
+	/**
+	* Decode updates to replicated properties on the network update thread, so the game thread only has to write the new values.
+	* Updates are decoded once the component's data has been received. Bool, numeric and enum properties and arrays of them are fully decoded,
+	* while other properties are still read on the game thread.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Decode Component Updates on Network Update Thread"))
+	bool bPredecodeComponentUpdates;
+
+	/**
+	* Merge updates to the same component of an entity received in one op list, so each component is read and its RepNotifies are called
+	* once per op list. Updates are only merged when the only ops for the entity between them are updates to its other components, and updates
+	* with events are never merged.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Fold Received Component Updates"))
+	bool bFoldReceivedComponentUpdates;
+
+	/**
+	* Per network update budgets for outgoing messages. Only ReserveEntityIdsRequest, EntityQueryRequest, LogMessage and Metrics can be
+	* budgeted; budgets for any other message type are ignored with a warning. Messages over budget are held back until a later network update.
+	* Entity and component changes are always sent before entity queries and entity ID reservations, which are sent before log messages and metrics.
+	* Entity creation and deletion, component changes and commands are sent in the order they were queued, as they depend on each other, so
+	* these budgets can't throttle a burst of CreateEntityRequests to make room for component updates and RPCs.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false))
+	TMap<FName, FOutgoingMessageBudget> OutgoingMessageBudgets;
+
+	/**
+	* Maximum number of log lines per second, per log category, forwarded to SpatialOS. Lines over the limit are dropped and the number dropped is logged instead.
+	* Repeated identical lines are collapsed into one line and only count once. 0 means no limit.
+	* Default: 0 (no limit)
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Logging", meta = (ConfigRestartRequired = false, DisplayName = "Log Forwarding Rate Limit (lines per second per category)"))
+	float LogForwardingMaxLinesPerSecondPerCategory;
+
+	/**
+	* Maximum number of log lines, per log category, that can be forwarded to SpatialOS in a burst before the rate limit applies.
+	* Default: 100 lines
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Logging", meta = (ConfigRestartRequired = false, DisplayName = "Log Forwarding Burst Limit (lines per category)"))
+	float LogForwardingMaxBurstLinesPerCategory;
+
 	/** Replicate handover properties between servers, required for zoned worker deployments.*/
 	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false))
 	bool bEnableHandover;
@@ -91,6 +211,38 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Wait Time Before Processing Received RPC With Unresolved Refs"))
 	float QueuedIncomingRPCWaitTime;
 
+	/**
+	* Limits for RPCs queued until they can be sent or applied, keyed by RPC type (ClientReliable, ClientUnreliable, ServerReliable,
+	* ServerUnreliable, NetMulticast or CrossServer). Dropping reliable RPCs breaks their delivery guarantee, so limits are usually
+	* only set for unreliable types. Dropped RPCs are reported as the Receiver.DroppedIncomingRPCs and Sender.DroppedOutgoingRPCs metrics.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false))
+	TMap<FName, FRPCQueuePolicy> RPCQueuePolicies;
+
+	/**
+	* Spawn the actors checked out together grouped by class, and only call BeginPlay on them once all of them have received
+	* their initial data and authority. Reduces hitches when many entities are checked out at once, e.g. after teleporting.
+	* Their actor channels are open before BeginPlay, so RepNotifies and RPCs can be called on them before BeginPlay, either
+	* by RPCs that were waiting for them to resolve or, when BeginPlay is deferred by ActorBeginPlayBudgetMs, by later updates.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Batch Actor Spawning"))
+	bool bBatchActorSpawning;
+
+	/**
+	* Time per frame in milliseconds for calling BeginPlay on batch spawned actors. The remaining actors are started on
+	* the following frames. Set to 0 to start all of them in the frame they are spawned.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bBatchActorSpawning", DisplayName = "Batch Spawned Actor BeginPlay Budget per Frame (milliseconds)"))
+	float ActorBeginPlayBudgetMs;
+
+	/**
+	* Classes of actors that clients keep in a pool when their entities leave view instead of destroying them, with the maximum
+	* number of actors to keep for each class. Pooled actors are reused for new entities of exactly the same class. Implement
+	* SpatialPooledActor on these classes to reset state that shouldn't carry over between entities.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Client Actor Pool Sizes"))
+	TMap<TSoftClassPtr<AActor>, int32> ClientActorPoolSizes;
+
 	/** Query Based Interest is required for level streaming and the AlwaysInterested UPROPERTY specifier to be supported when using spatial networking, however comes at a performance cost for larger-scale projects.*/
 	UPROPERTY(config, meta = (ConfigRestartRequired = false))
 	bool bUsingQBI;
@@ -144,6 +296,14 @@ public:
 	UPROPERTY(config, meta = (ConfigRestartRequired = false))
 	bool bPackRPCs;
 
+	/**
+	* Merge consecutive component updates for the same entity and component that are sent in the same network update into a single update.
+	* Updates are only merged into the one queued right before them, so the order of messages and events is unchanged.
+	* Later field values replace earlier ones, events are appended and cleared fields are combined.
+	*/
+	UPROPERTY(config, meta = (ConfigRestartRequired = false))
+	bool bCoalesceOutgoingComponentUpdates;
+
 	/** The receptionist host to use if no 'receptionistHost' argument is passed to the command line. */
 	UPROPERTY(EditAnywhere, config, Category = "Local Connection", meta = (ConfigRestartRequired = false))
 	FString DefaultReceptionistHost;
@@ -5,6 +5,7 @@
 #include "Interop/SpatialClassInfoManager.h"
 #include "Schema/Interest.h"
 #include "Utils/RepDataUtils.h"
+#include "Utils/SchemaPropertyPlan.h"
 
 #include <WorkerSDK/improbable/c_schema.h>
 #include <WorkerSDK/improbable/c_worker.h>
@@ -38,10 +39,10 @@ public:
 	static Worker_ComponentData CreateEmptyComponentData(Worker_ComponentId ComponentId);
 
 private:
-	Worker_ComponentData CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup);
-	Worker_ComponentUpdate CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool& bWroteSomething);
+	Worker_ComponentData CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FClassInfo& Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup);
+	Worker_ComponentUpdate CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FClassInfo& Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool& bWroteSomething);
 
-	bool FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds = nullptr);
+	bool FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FClassInfo& Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds = nullptr);
 
 	Worker_ComponentUpdate CreateHandoverComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FClassInfo& Info, const FHandoverChangeState& Changes, bool& bWroteSomething);
 
@@ -52,7 +53,8 @@ private:
 	Interest CreateInterestComponent(UObject* Object, const FClassInfo& Info);
 	void AddObjectToComponentInterest(UObject* Object, UObjectPropertyBase* Property, uint8* Data, ComponentInterest& ComponentInterest);
 
-	void AddProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data, FUnresolvedObjectsSet& UnresolvedObjects, TArray<Schema_FieldId>* ClearedIds);
+	void AddProperty(Schema_Object* Object, Schema_FieldId FieldId, const FSchemaPropertyInfo& SchemaInfo, const uint8* Data, FUnresolvedObjectsSet& UnresolvedObjects, TArray<Schema_FieldId>* ClearedIds);
+	void AddValue(Schema_Object* Object, Schema_FieldId FieldId, ESchemaPropertyOp Op, UProperty* Property, const uint8* Data, FUnresolvedObjectsSet& UnresolvedObjects);
 
 	USpatialNetDriver* NetDriver;
 	USpatialPackageMapClient* PackageMap;
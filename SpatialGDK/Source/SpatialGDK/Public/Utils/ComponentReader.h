@@ -4,6 +4,7 @@
 
 #include "EngineClasses/SpatialNetBitReader.h"
 #include "Interop/SpatialReceiver.h"
+#include "Utils/SchemaPropertyPlan.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialComponentReader, All, All);
 
@@ -16,16 +17,17 @@ public:
 	ComponentReader(class USpatialNetDriver* InNetDriver, FObjectReferencesMap& InObjectReferencesMap, TSet<FUnrealObjectRef>& InUnresolvedRefs);
 
 	void ApplyComponentData(const Worker_ComponentData& ComponentData, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover);
-	void ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover);
+	// If the update was predecoded on the ops processing thread, the field IDs and primitive values are taken from Predecoded instead.
+	void ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover, const FPredecodedComponentUpdate* Predecoded = nullptr);
 
 private:
-	void ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds);
-	void ApplyHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds);
+	void ApplySchemaObject(Schema_Object* ComponentObject, Worker_ComponentId ComponentId, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArrayView<const Schema_FieldId> UpdatedIds, const FPredecodedComponentUpdate* Predecoded);
+	void ApplyHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArrayView<const Schema_FieldId> UpdatedIds);
 
-	void ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, UProperty* Property, uint8* Data, int32 Offset, int32 CmdIndex, int32 ParentIndex);
-	void ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 CmdIndex, int32 ParentIndex);
+	void ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, ESchemaPropertyOp Op, UProperty* Property, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex);
+	void ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, const FSchemaPropertyInfo& SchemaInfo, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex);
 
-	uint32 GetPropertyCount(const Schema_Object* Object, Schema_FieldId Id, UProperty* Property);
+	uint32 GetPropertyCount(const Schema_Object* Object, Schema_FieldId Id, ESchemaPropertyOp Op);
 
 private:
 	class USpatialPackageMapClient* PackageMap;
@@ -0,0 +1,82 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+#include <atomic>
+
+namespace SpatialGDK
+{
+
+// Samples taken from an FLatencyHistogram. Bucket i counts values in (BaseUpperBound * 2^(i-1), BaseUpperBound * 2^i],
+// except for the first bucket, which also counts everything below, and the last bucket, which has no upper bound.
+struct SPATIALGDK_API FLatencyHistogramSnapshot
+{
+	static constexpr int32 NumBuckets = 24;
+
+	FLatencyHistogramSnapshot();
+
+	double GetBucketUpperBound(int32 BucketIndex) const;
+
+	// Returns the upper bound of the bucket containing the given percentile (0-1), or 0 if there are no samples.
+	double GetPercentile(double Percentile) const;
+
+	double GetMean() const { return Count > 0 ? Sum / Count : 0.0; }
+
+	double BaseUpperBound;
+	uint32 Buckets[NumBuckets];
+	uint32 Count;
+	double Sum;
+};
+
+// Histogram with fixed log-scale buckets. Recording is lock-free, so one thread can record samples
+// while another periodically takes snapshots.
+class SPATIALGDK_API FLatencyHistogram
+{
+public:
+	static constexpr int32 NumBuckets = FLatencyHistogramSnapshot::NumBuckets;
+
+	explicit FLatencyHistogram(double InBaseUpperBound);
+
+	FLatencyHistogram(const FLatencyHistogram&) = delete;
+	FLatencyHistogram& operator=(const FLatencyHistogram&) = delete;
+
+	void Record(double Value);
+
+	// Returns the samples recorded since the last snapshot and clears them.
+	FLatencyHistogramSnapshot TakeSnapshot();
+
+private:
+	int32 GetBucketIndex(double Value) const;
+
+	const double BaseUpperBound;
+
+	std::atomic<uint32> Buckets[NumBuckets];
+	std::atomic<double> Sum;
+};
+
+// Records the time in milliseconds between construction and destruction into a histogram, if one is given.
+class FScopedLatencyRecorder
+{
+public:
+	explicit FScopedLatencyRecorder(FLatencyHistogram* InHistogram)
+		: Histogram(InHistogram)
+		, StartCycles(InHistogram != nullptr ? FPlatformTime::Cycles64() : 0)
+	{}
+
+	~FScopedLatencyRecorder()
+	{
+		if (Histogram != nullptr)
+		{
+			Histogram->Record(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+		}
+	}
+
+private:
+	FLatencyHistogram* Histogram;
+	uint64 StartCycles;
+};
+
+} // namespace SpatialGDK
@@ -5,12 +5,14 @@
 #include "Schema/RPCPayload.h"
 #include "Schema/UnrealObjectRef.h"
 #include "SpatialConstants.h"
+#include "SpatialGDKSettings.h"
 
 #include "CoreMinimal.h"
 
 struct FPendingRPCParams;
-using FPendingRPCParamsPtr = TUniquePtr<FPendingRPCParams>;
 DECLARE_DELEGATE_RetVal_OneParam(bool, FProcessRPCDelegate, const FPendingRPCParams&)
+// As FProcessRPCDelegate, but also reports the objects that stopped an RPC from being applied.
+DECLARE_DELEGATE_RetVal_TwoParams(bool, FProcessRPCWithDependenciesDelegate, const FPendingRPCParams&, TSet<FUnrealObjectRef>& /* OutUnresolvedRefs */)
 
 struct FPendingRPCParams
 {
@@ -21,23 +23,77 @@ struct FPendingRPCParams
 	FUnrealObjectRef ObjectRef;
 	SpatialGDK::RPCPayload Payload;
 
-	FDateTime QueuedTimestamp;
+	// From FPlatformTime::Cycles64, which unlike FDateTime::Now is monotonic and doesn't convert to local time.
+	uint64 QueuedCycles;
 };
 
 class FRPCContainer
 {
 public:
-	void QueueRPC(FPendingRPCParamsPtr Params, ESchemaComponentType Type);
+	// Reads the queue policies from USpatialGDKSettings.
+	void Init();
+
+	void QueueRPC(FPendingRPCParams&& Params, ESchemaComponentType Type);
 	void ProcessRPCs(const FProcessRPCDelegate& FunctionToApply);
+	void ProcessRPCs(const FProcessRPCWithDependenciesDelegate& FunctionToApply);
+
+	// Only retries the queues that were waiting for an object on this entity, or whose dependencies aren't known.
+	void ProcessRPCsWaitingForEntity(Worker_EntityId EntityId, const FProcessRPCWithDependenciesDelegate& FunctionToApply);
+
+	// Retries the queues whose first RPC was queued before CutoffCycles, regardless of what they are waiting for.
+	void ProcessRPCsQueuedBefore(uint64 CutoffCycles, const FProcessRPCWithDependenciesDelegate& FunctionToApply);
+
 	bool ObjectHasRPCsQueuedOfType(const Worker_EntityId& EntityId, ESchemaComponentType Type) const;
 
+	int32 GetNumQueuedRPCs() const { return NumQueuedRPCs; }
+	double GetOldestQueuedRPCAgeSeconds() const;
+
+	// Number of RPCs dropped by the queue policies since the last call.
+	uint32 TakeNumDroppedRPCs();
+
 private:
-	using FArrayOfParams = TArray<FPendingRPCParamsPtr>;
-	using FRPCMap = TMap<Worker_EntityId_Key, FArrayOfParams>;
-	using RPCContainerType = TMap<ESchemaComponentType, FRPCMap>;
+	// Processed RPCs are removed from the front by advancing Head, and the array is only compacted once most of it has
+	// been processed, so flushing a queue doesn't shift the remaining RPCs every time.
+	struct FRPCQueue
+	{
+		TArray<FPendingRPCParams> RPCs;
+		int32 Head = 0;
+
+		int32 Num() const { return RPCs.Num() - Head; }
+		FPendingRPCParams& First() { return RPCs[Head]; }
+		const FPendingRPCParams& First() const { return RPCs[Head]; }
+		void PushFront(FPendingRPCParams&& Params);
+		void PopFront(int32 Count);
+	};
+
+	using FRPCMap = TMap<Worker_EntityId_Key, FRPCQueue>;
+	using FQueueKey = TPair<ESchemaComponentType, Worker_EntityId_Key>;
+
+	void ProcessQueues(const TArray<FQueueKey>& Queues, const FProcessRPCWithDependenciesDelegate& FunctionToApply);
+	void ProcessRPCs(const FQueueKey& Queue, const FProcessRPCWithDependenciesDelegate& FunctionToApply);
+	void DropExpiredRPCs(const FQueueKey& Queue, FRPCQueue& RPCQueue);
+
+	void AddDependencies(const FQueueKey& Queue, const TSet<FUnrealObjectRef>& UnresolvedRefs);
+	void RemoveDependencies(const FQueueKey& Queue);
+
+	// Indexed by RPC type, starting from SCHEMA_ClientReliableRPC.
+	static const int32 NumRPCTypes = SCHEMA_CrossServerRPC - SCHEMA_ClientReliableRPC + 1;
+
+	FRPCMap QueuedRPCs[NumRPCTypes];
+	int32 NumQueuedRPCs = 0;
+
+	FRPCQueuePolicy Policies[NumRPCTypes];
+	uint64 MaxAgeCycles[NumRPCTypes] = {};
+	uint32 NumDroppedRPCs = 0;
+
+	// No RPC was queued before this, but it isn't updated as RPCs are processed so it may be older than the oldest RPC.
+	uint64 OldestQueuedCycles = 0;
 
-	void ProcessRPCs(const FProcessRPCDelegate& FunctionToApply, FArrayOfParams& RPCList);
-	static bool ApplyFunction(const FProcessRPCDelegate& FunctionToApply, const FPendingRPCParams& Params);
+	// Blocked queues indexed by the entities of the objects their first RPC is waiting for.
+	TMap<Worker_EntityId_Key, TSet<FQueueKey>> QueuesWaitingForEntity;
+	TMap<FQueueKey, TArray<Worker_EntityId>> QueueDependencies;
 
-	RPCContainerType QueuedRPCs;
+	// Queues that haven't been processed yet, or that are waiting for something other than an entity's objects.
+	// These are retried whenever any entity resolves.
+	TSet<FQueueKey> QueuesWithUnknownDependencies;
 };
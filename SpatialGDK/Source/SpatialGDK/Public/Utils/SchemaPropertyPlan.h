@@ -0,0 +1,94 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/RepLayout.h"
+
+class UProperty;
+class UScriptStruct;
+
+namespace SpatialGDK
+{
+
+// How a property is written to and read from schema by ComponentFactory and ComponentReader. Resolved once per property
+// so that serialization doesn't have to identify the property type with a chain of casts.
+enum class ESchemaPropertyOp : uint8
+{
+	Unsupported,
+	Ignored,
+	NetSerializeStruct,
+	RepLayoutStruct,
+	Bool,
+	Float,
+	Double,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	Byte,
+	UInt16,
+	UInt32,
+	UInt64,
+	SmallEnum,
+	Object,
+	Name,
+	Str,
+	Text,
+	Array
+};
+
+struct FSchemaPropertyInfo
+{
+	ESchemaPropertyOp Op = ESchemaPropertyOp::Unsupported;
+	// The property the value is read through. For enums that aren't written as a small enum, this is the underlying property.
+	UProperty* Property = nullptr;
+
+	// Only for arrays.
+	ESchemaPropertyOp InnerOp = ESchemaPropertyOp::Unsupported;
+	UProperty* InnerProperty = nullptr;
+};
+
+// Schema infos for the commands of a class's rep layout, indexed by command index.
+using FRepLayoutWritePlan = TArray<FSchemaPropertyInfo>;
+
+// Everything ComponentReader needs from the rep layout to apply a replicated field.
+struct FRepFieldReadInfo
+{
+	FSchemaPropertyInfo SchemaInfo;
+	// The property of the command, which for enums differs from SchemaInfo.Property.
+	UProperty* Property = nullptr;
+
+	int32 ParentIndex = INDEX_NONE;
+	ELifetimeCondition Condition = COND_None;
+
+	// Non-authoritative servers and clients write Role and RemoteRole to each other's offsets.
+	int32 Offset = 0;
+	int32 SwappedOffset = 0;
+	// Where the value is compared against the rep state's static buffer to decide whether to call RepNotifies.
+	int32 StaticBufferOffset = 0;
+	int32 SwappedStaticBufferOffset = 0;
+	// Shadow offset stored with unresolved object references.
+	int32 ShadowOffset = 0;
+
+	// Only for FFastArraySerializer arrays, which are delta serialized through their parent property.
+	UScriptStruct* NetDeltaStruct = nullptr;
+	UProperty* ParentProperty = nullptr;
+	int32 ParentArrayIndex = 0;
+
+	// Only set if the parent property has a RepNotify.
+	UProperty* RepNotifyProperty = nullptr;
+	ERepNotifyCondition RepNotifyCondition = REPNOTIFY_OnChanged;
+
+	bool bIsRemoteRole = false;
+};
+
+// Read infos for the fields of a class's replicated components, indexed by field ID. Field IDs are rep handles, which
+// start at 1, so the first entry is unused.
+using FRepLayoutReadPlan = TArray<FRepFieldReadInfo>;
+
+SPATIALGDK_API FSchemaPropertyInfo CreateSchemaPropertyInfo(UProperty* Property);
+SPATIALGDK_API FRepLayoutWritePlan CreateRepLayoutWritePlan(const FRepLayout& RepLayout);
+SPATIALGDK_API FRepLayoutReadPlan CreateRepLayoutReadPlan(const FRepLayout& RepLayout);
+
+} // namespace SpatialGDK
@@ -18,19 +18,81 @@ namespace SpatialGDK
 
 inline void AddStringToSchema(Schema_Object* Object, Schema_FieldId Id, const FString& Value)
 {
-	FTCHARToUTF8 CStrConversion(*Value);
-	uint32 StringLength = CStrConversion.Length();
+	// Convert straight into the schema buffer instead of through a temporary conversion buffer.
+	int32 StringLength = FTCHARToUTF8_Convert::ConvertedLength(*Value, Value.Len());
 	uint8* StringBuffer = Schema_AllocateBuffer(Object, sizeof(char) * StringLength);
-	FMemory::Memcpy(StringBuffer, CStrConversion.Get(), sizeof(char) * StringLength);
+	ANSICHAR* ConvertedString = reinterpret_cast<ANSICHAR*>(StringBuffer);
+	FTCHARToUTF8_Convert::Convert(ConvertedString, StringLength, *Value, Value.Len());
 	Schema_AddBytes(Object, Id, StringBuffer, sizeof(char) * StringLength);
 }
 
 inline FString IndexStringFromSchema(const Schema_Object* Object, Schema_FieldId Id, uint32 Index)
 {
 	int32 StringLength = (int32)Schema_IndexBytesLength(Object, Id, Index);
-	const uint8_t* Bytes = Schema_IndexBytes(Object, Id, Index);
-	FUTF8ToTCHAR FStringConversion(reinterpret_cast<const ANSICHAR*>(Bytes), StringLength);
-	return FString(FStringConversion.Length(), FStringConversion.Get());
+	const ANSICHAR* Bytes = reinterpret_cast<const ANSICHAR*>(Schema_IndexBytes(Object, Id, Index));
+
+	// Convert straight into the string's own storage instead of through a temporary conversion buffer.
+	FString String;
+	int32 ConvertedLength = FUTF8ToTCHAR_Convert::ConvertedLength(Bytes, StringLength);
+	if (ConvertedLength > 0)
+	{
+		TArray<TCHAR>& Chars = String.GetCharArray();
+		Chars.SetNumUninitialized(ConvertedLength + 1);
+		TCHAR* ConvertedString = Chars.GetData();
+		FUTF8ToTCHAR_Convert::Convert(ConvertedString, ConvertedLength, Bytes, StringLength);
+		Chars[ConvertedLength] = TEXT('\0');
+	}
+	return String;
+}
+
+// Names are written as strings, in the same format as FName::ToString.
+inline void AddNameToSchema(Schema_Object* Object, Schema_FieldId Id, const FName& Value)
+{
+	const FNameEntry* NameEntry = Value.GetDisplayNameEntry();
+	if (NameEntry->IsWide())
+	{
+		AddStringToSchema(Object, Id, Value.ToString());
+		return;
+	}
+
+	// Non-wide name entries are pure ASCII, which is valid UTF-8, so they can be copied into the schema buffer as they are.
+	const ANSICHAR* PlainName = NameEntry->GetAnsiName();
+	int32 PlainNameLength = FCStringAnsi::Strlen(PlainName);
+
+	ANSICHAR NumberSuffix[16];
+	int32 NumberSuffixLength = 0;
+	if (Value.GetNumber() != NAME_NO_NUMBER_INTERNAL)
+	{
+		NumberSuffixLength = FCStringAnsi::Sprintf(NumberSuffix, "_%d", NAME_INTERNAL_TO_EXTERNAL(Value.GetNumber()));
+	}
+
+	uint8* StringBuffer = Schema_AllocateBuffer(Object, sizeof(char) * (PlainNameLength + NumberSuffixLength));
+	FMemory::Memcpy(StringBuffer, PlainName, sizeof(char) * PlainNameLength);
+	FMemory::Memcpy(StringBuffer + PlainNameLength, NumberSuffix, sizeof(char) * NumberSuffixLength);
+	Schema_AddBytes(Object, Id, StringBuffer, sizeof(char) * (PlainNameLength + NumberSuffixLength));
+}
+
+inline FName IndexNameFromSchema(const Schema_Object* Object, Schema_FieldId Id, uint32 Index)
+{
+	int32 StringLength = (int32)Schema_IndexBytesLength(Object, Id, Index);
+	const uint8* Bytes = Schema_IndexBytes(Object, Id, Index);
+
+	// Most names are ASCII, which FName can be created from without converting to TCHAR first.
+	bool bIsAnsi = StringLength < NAME_SIZE;
+	for (int32 i = 0; bIsAnsi && i < StringLength; i++)
+	{
+		bIsAnsi = Bytes[i] < 0x80;
+	}
+
+	if (bIsAnsi)
+	{
+		ANSICHAR Name[NAME_SIZE];
+		FMemory::Memcpy(Name, Bytes, sizeof(char) * StringLength);
+		Name[StringLength] = '\0';
+		return FName(Name);
+	}
+
+	return FName(*IndexStringFromSchema(Object, Id, Index));
 }
 
 inline FString GetStringFromSchema(const Schema_Object* Object, Schema_FieldId Id)
@@ -113,14 +175,14 @@ inline void AddObjectRefToSchema(Schema_Object* Object, Schema_FieldId Id, const
 
 	Schema_AddEntityId(ObjectRefObject, 1, ObjectRef.Entity);
 	Schema_AddUint32(ObjectRefObject, 2, ObjectRef.Offset);
-	if (ObjectRef.Path)
+	if (ObjectRef.HasPath())
 	{
-		AddStringToSchema(ObjectRefObject, 3, *ObjectRef.Path);
+		AddStringToSchema(ObjectRefObject, 3, ObjectRef.GetPath());
 		Schema_AddBool(ObjectRefObject, 4, ObjectRef.bNoLoadOnClient);
 	}
-	if (ObjectRef.Outer)
+	if (ObjectRef.HasOuter())
 	{
-		AddObjectRefToSchema(ObjectRefObject, 5, *ObjectRef.Outer);
+		AddObjectRefToSchema(ObjectRefObject, 5, ObjectRef.GetOuter());
 	}
 }
 
@@ -134,18 +196,21 @@ inline FUnrealObjectRef IndexObjectRefFromSchema(Schema_Object* Object, Schema_F
 
 	ObjectRef.Entity = Schema_GetEntityId(ObjectRefObject, 1);
 	ObjectRef.Offset = Schema_GetUint32(ObjectRefObject, 2);
+	TOptional<FString> Path;
 	if (Schema_GetObjectCount(ObjectRefObject, 3) > 0)
 	{
-		ObjectRef.Path = GetStringFromSchema(ObjectRefObject, 3);
+		Path = GetStringFromSchema(ObjectRefObject, 3);
 	}
 	if (Schema_GetBoolCount(ObjectRefObject, 4) > 0)
 	{
 		ObjectRef.bNoLoadOnClient = GetBoolFromSchema(ObjectRefObject, 4);
 	}
+	TOptional<FUnrealObjectRef> Outer;
 	if (Schema_GetObjectCount(ObjectRefObject, 5) > 0)
 	{
-		ObjectRef.Outer = GetObjectRefFromSchema(ObjectRefObject, 5);
+		Outer = GetObjectRefFromSchema(ObjectRefObject, 5);
 	}
+	ObjectRef.SetPathAndOuter(Path.GetPtrOrNull(), Outer.GetPtrOrNull());
 
 	return ObjectRef;
 }
@@ -0,0 +1,71 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+
+#include "SpatialActorPool.generated.h"
+
+class AActor;
+class USpatialNetDriver;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialActorPool, Log, All)
+
+UINTERFACE(BlueprintType)
+class SPATIALGDK_API USpatialPooledActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// Implemented by actors of pooled classes to reset any state that shouldn't carry over to the next entity using the actor,
+// such as timers, particles, audio and components added by game code. Subobjects and components created by replication are
+// destroyed by the pool before OnReturnedToPool is called. Pooled actors keep their BeginPlay state.
+class SPATIALGDK_API ISpatialPooledActor
+{
+	GENERATED_BODY()
+
+public:
+	// Called after the actor has been removed from the client's view and hidden.
+	UFUNCTION(BlueprintNativeEvent, Category = "SpatialOS")
+	void OnReturnedToPool();
+
+	// Called when the actor is reused for a new entity, before its initial component data is applied.
+	UFUNCTION(BlueprintNativeEvent, Category = "SpatialOS")
+	void OnTakenFromPool();
+};
+
+// Keeps actors of the classes in USpatialGDKSettings::ClientActorPoolSizes when their entities leave a client's view,
+// so they can be reused for the next entity of the same class instead of spawning and destroying an actor each time.
+UCLASS()
+class SPATIALGDK_API USpatialActorPool : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Init(USpatialNetDriver* InNetDriver);
+
+	// Returns nullptr if there is no pooled actor of exactly this class.
+	AActor* TakeActor(UClass* ActorClass, const FTransform& Transform);
+
+	// Returns false if the actor should be destroyed as normal.
+	bool CanReturnActor(AActor* Actor);
+
+	// ReplicatedSubobjects are the subobjects and components that replication created on the actor for the entity that left view.
+	void ReturnActor(AActor* Actor, const TArray<UObject*>& ReplicatedSubobjects);
+
+private:
+	int32 GetMaxPoolSize(UClass* ActorClass);
+
+	// Strips what the previous entity added to the actor through replication, as UActorChannel::CleanUp does when it destroys an actor.
+	void ResetForPool(AActor* Actor, const TArray<UObject*>& ReplicatedSubobjects);
+
+	UPROPERTY()
+	USpatialNetDriver* NetDriver;
+
+	// Pooled actors stay in the world, which keeps them from being garbage collected.
+	TMap<UClass*, TArray<TWeakObjectPtr<AActor>>> PooledActors;
+
+	// Resolved from the soft class pointers in the settings the first time an actor of each class is checked.
+	TMap<UClass*, int32> MaxPoolSizes;
+};
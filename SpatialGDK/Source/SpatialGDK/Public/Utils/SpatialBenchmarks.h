@@ -0,0 +1,23 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace SpatialGDK
+{
+
+// Microbenchmarks for the GDK's hot paths, run with the SpatialBenchmark console command. Each one times the current
+// implementation against a copy of the one it replaced, on synthetic data, and logs both timings to the output device.
+// They run synchronously on the calling thread, so expect the game to hitch while they run.
+namespace SpatialBenchmarks
+{
+	// Usage: SpatialBenchmark <Name|All> [Args]. Lists the benchmarks if the name is missing or unknown.
+	SPATIALGDK_API void Run(const TCHAR* Cmd, FOutputDevice& Ar);
+}
+
+} // namespace SpatialGDK
+
+#endif // !UE_BUILD_SHIPPING
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "SpatialConstants.h"
+#include "Utils/LatencyHistogram.h"
 
 #include <WorkerSDK/improbable/c_schema.h>
 #include <WorkerSDK/improbable/c_worker.h>
@@ -46,6 +47,17 @@ public:
 
 	void TrackSentRPC(UFunction* Function, ESchemaComponentType RPCType, int PayloadSize);
 
+	// Time spent in each phase of the net driver tick in milliseconds, and the number of ops in each op list processed.
+	// These are reported as histograms so that tail latency shows up, rather than just the average frame rate.
+	SpatialGDK::FLatencyHistogram TickDispatchTimeHistogram{ 0.01 };
+	SpatialGDK::FLatencyHistogram ServerReplicateActorsTimeHistogram{ 0.01 };
+	SpatialGDK::FLatencyHistogram FlushPackedRPCsTimeHistogram{ 0.01 };
+	SpatialGDK::FLatencyHistogram ProcessPositionUpdatesTimeHistogram{ 0.01 };
+	SpatialGDK::FLatencyHistogram OpListSizeHistogram{ 1.0 };
+
+	// Number of frames taken to process ops that went over the op processing budget.
+	SpatialGDK::FLatencyHistogram OpBacklogDrainFramesHistogram{ 1.0 };
+
 private:
 	UPROPERTY()
 	USpatialNetDriver* NetDriver;
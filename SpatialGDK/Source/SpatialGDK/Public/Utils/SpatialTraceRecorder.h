@@ -0,0 +1,144 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialTraceRecorder, Log, All);
+
+namespace SpatialGDK
+{
+
+// Records timed events from any thread for a fixed duration and writes them to a JSON file in the Chrome trace event
+// format, which can be opened in chrome://tracing or ui.perfetto.dev. Each thread gets its own track.
+// Recording is process-wide, so events from every net driver in the process end up in the same file.
+// Events are buffered per thread and written to the file incrementally by a writer thread while recording.
+class SPATIALGDK_API FSpatialTraceRecorder : public FRunnable
+{
+public:
+	static FSpatialTraceRecorder& Get();
+
+	virtual ~FSpatialTraceRecorder();
+
+	// Returns false if a recording is already in progress, the previous one is still being written or the file can't be opened.
+	bool Start(double DurationSeconds, const FString& InFilePath);
+
+	// Stops recording. The writer thread writes the remaining events and closes the file. Returns false if nothing was being recorded.
+	bool Stop();
+
+	// Stops the recording once its duration has elapsed. Called by the net driver every tick.
+	void Tick();
+
+	bool IsRecording() const { return bRecording.load(std::memory_order_relaxed); }
+
+	// Name and Category must outlive the recording, so they should be string literals.
+	void AddEvent(const TCHAR* Name, const TCHAR* Category, uint64 StartCycles, uint64 EndCycles, FString&& Detail);
+
+	// Begin FRunnable Interface
+	virtual uint32 Run() override;
+	// End FRunnable Interface
+
+private:
+	FSpatialTraceRecorder();
+
+	struct FTraceEvent
+	{
+		const TCHAR* Name;
+		const TCHAR* Category;
+		uint64 StartCycles;
+		uint64 EndCycles;
+		FString Detail;
+	};
+
+	// Buffers are never freed, since the thread that owns one keeps a pointer to it in thread local storage.
+	struct FThreadBuffer
+	{
+		uint32 ThreadId;
+		FString ThreadName;
+
+		// Only contended when the writer thread takes the buffered events.
+		FCriticalSection Lock;
+		TArray<FTraceEvent> Events;
+
+		// Only used by the writer thread.
+		TArray<FTraceEvent> WritingEvents;
+		bool bThreadNameWritten;
+	};
+
+	FThreadBuffer& GetThreadBuffer();
+	void WriteBufferedEvents();
+	void WriteJson(const FString& Json);
+	void ReleaseFinishedWriterThread();
+
+	std::atomic<bool> bRecording;
+	std::atomic<int32> NumDroppedEvents;
+
+	uint32 ThreadBufferTlsSlot;
+	// Only taken when a thread records its first event, and when the writer thread collects the buffers.
+	FCriticalSection ThreadBuffersLock;
+	TArray<TUniquePtr<FThreadBuffer>> ThreadBuffers;
+
+	uint64 RecordingStartCycles;
+	double RecordingEndTime;
+	FString FilePath;
+
+	// Owned by the writer thread while it runs.
+	FRunnableThread* WriterThread;
+	FEvent* WriterWakeEvent;
+	std::atomic<bool> bWriterFinished;
+	TUniquePtr<FArchive> File;
+	bool bFirstWrittenEvent;
+	int32 NumWrittenEvents;
+};
+
+// Records an event covering the lifetime of this object if a trace is being recorded when it is constructed.
+class FScopedTraceEvent
+{
+public:
+	FScopedTraceEvent(const TCHAR* InName, const TCHAR* InCategory)
+		: Name(InName)
+		, Category(InCategory)
+		, StartCycles(FSpatialTraceRecorder::Get().IsRecording() ? FPlatformTime::Cycles64() : 0)
+	{}
+
+	// DetailFunction returns an FString, and is only called while a trace is being recorded.
+	template <typename DetailFunctionType>
+	FScopedTraceEvent(const TCHAR* InName, const TCHAR* InCategory, DetailFunctionType&& DetailFunction)
+		: FScopedTraceEvent(InName, InCategory)
+	{
+		if (StartCycles != 0)
+		{
+			Detail = DetailFunction();
+		}
+	}
+
+	~FScopedTraceEvent()
+	{
+		if (StartCycles != 0)
+		{
+			FSpatialTraceRecorder::Get().AddEvent(Name, Category, StartCycles, FPlatformTime::Cycles64(), MoveTemp(Detail));
+		}
+	}
+
+private:
+	const TCHAR* Name;
+	const TCHAR* Category;
+	uint64 StartCycles;
+	FString Detail;
+};
+
+} // namespace SpatialGDK
+
+#define SPATIAL_TRACE_SCOPE(Name, Category) \
+	SpatialGDK::FScopedTraceEvent PREPROCESSOR_JOIN(SpatialTraceEvent_, __LINE__)(Name, Category)
+
+// The detail expression is only evaluated while a trace is being recorded.
+#define SPATIAL_TRACE_SCOPE_DETAIL(Name, Category, DetailExpression) \
+	SpatialGDK::FScopedTraceEvent PREPROCESSOR_JOIN(SpatialTraceEvent_, __LINE__)(Name, Category, [&]() -> FString { return DetailExpression; })